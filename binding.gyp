@@ -7,18 +7,32 @@
       ],
       "include_dirs": [
         "src",
+        "bindings/c",
       ],
       "sources": [
         "bindings/node/binding.cc",
         "src/parser.c",
       ],
       "variables": {
-        "has_scanner": "<!(node -p \"fs.existsSync('src/scanner.c')\")"
+        "has_scanner": "<!(node -p \"fs.existsSync('src/scanner.c')\")",
+        # The native parsing API compiles the runtime sources vendored by the
+        # `tree-sitter` package, when it is installed next to this one and
+        # can load this parser's language ABI.
+        "tree_sitter_lib": "<!(node bindings/node/native-runtime.js)"
       },
       "conditions": [
         ["has_scanner=='true'", {
           "sources+": ["src/scanner.c"],
         }],
+        ["tree_sitter_lib!=''", {
+          "sources+": ["<(tree_sitter_lib)/src/lib.c"],
+          "include_dirs+": ["<(tree_sitter_lib)/include"],
+          "defines": [
+            "TREE_SITTER_WXML_NATIVE",
+            "_POSIX_C_SOURCE=200112L",
+            "_DEFAULT_SOURCE",
+          ],
+        }],
         ["OS!='win'", {
           "cflags_c": [
             "-std=c11",
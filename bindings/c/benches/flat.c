@@ -0,0 +1,150 @@
+// Compares loading an encoded tree from disk against parsing the source
+// again. The load side opens and maps the file, decodes the header and
+// reads every node with a wxml_flat_cursor; the parse side only parses.
+//
+//   flat-bench [-n iterations] FILE...
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "tree_sitter/tree-sitter-wxml-flat.h"
+#include "tree_sitter/tree-sitter-wxml.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <tree_sitter/api.h>
+#include <unistd.h>
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static char *read_file(const char *path, uint32_t *length) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *data = malloc(size > 0 ? (size_t)size : 1);
+    if (data != NULL && fread(data, 1, (size_t)size, file) != (size_t)size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *length = (uint32_t)size;
+    return data;
+}
+
+// Maps an encoded tree and reads all of its nodes, returning a checksum so
+// the walk cannot be optimized away, or 0 if the file does not decode.
+static uint64_t load(const char *path) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        return 0;
+    }
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return 0;
+    }
+    uint64_t checksum = 0;
+    wxml_flat_tree tree;
+    if (wxml_tree_decode(data, (size_t)st.st_size, &tree)) {
+        wxml_flat_cursor cursor;
+        wxml_flat_node node;
+        wxml_flat_cursor_seek(&cursor, &tree, 0);
+        while (wxml_flat_cursor_next(&cursor, &node)) {
+            checksum += node.symbol + node.end_byte + node.parent;
+        }
+    }
+    munmap(data, (size_t)st.st_size);
+    return checksum;
+}
+
+int main(int argc, char **argv) {
+    long iterations = 100;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        if (opt != 'n' || (iterations = strtol(optarg, NULL, 10)) < 1) {
+            fputs("usage: flat-bench [-n iterations] FILE...\n", stderr);
+            return 2;
+        }
+    }
+
+    char encoded_path[] = "/tmp/flat-bench-XXXXXX";
+    int encoded_fd = mkstemp(encoded_path);
+    if (encoded_fd < 0) {
+        perror("mkstemp");
+        return 2;
+    }
+    close(encoded_fd);
+
+    TSParser *parser = ts_parser_new();
+    if (!ts_parser_set_language(parser, tree_sitter_wxml())) {
+        fputs("flat-bench: the tree-sitter runtime cannot load this parser's language\n", stderr);
+        ts_parser_delete(parser);
+        unlink(encoded_path);
+        return 2;
+    }
+    printf("%-32s %10s %8s %10s %12s %12s %8s\n", "file", "bytes", "nodes", "encoded", "parse us", "load us",
+           "speedup");
+    int status = 0;
+    for (int i = optind; i < argc; i++) {
+        uint32_t length;
+        char *source = read_file(argv[i], &length);
+        if (source == NULL) {
+            perror(argv[i]);
+            status = 2;
+            continue;
+        }
+
+        double start = now_seconds();
+        TSTree *tree = NULL;
+        for (long n = 0; n < iterations; n++) {
+            ts_tree_delete(tree);
+            tree = ts_parser_parse_string(parser, NULL, source, length);
+        }
+        double parse = (now_seconds() - start) / (double)iterations;
+
+        size_t size;
+        void *encoded = wxml_tree_encode(tree, &size);
+        FILE *out = fopen(encoded_path, "wb");
+        if (encoded == NULL || out == NULL || fwrite(encoded, 1, size, out) != size) {
+            fprintf(stderr, "%s: could not write the encoded tree\n", argv[i]);
+            status = 2;
+        }
+        if (out != NULL) {
+            fclose(out);
+        }
+
+        uint64_t checksum = 0;
+        start = now_seconds();
+        for (long n = 0; n < iterations; n++) {
+            checksum += load(encoded_path);
+        }
+        double loaded = (now_seconds() - start) / (double)iterations;
+        if (checksum == 0) {
+            fprintf(stderr, "%s: the encoded tree did not decode\n", argv[i]);
+            status = 1;
+        }
+
+        printf("%-32s %10u %8u %10zu %12.1f %12.1f %7.1fx\n", argv[i], length,
+               ts_node_descendant_count(ts_tree_root_node(tree)), size, parse * 1e6, loaded * 1e6,
+               loaded > 0 ? parse / loaded : 0.0);
+        free(encoded);
+        ts_tree_delete(tree);
+        free(source);
+    }
+    ts_parser_delete(parser);
+    unlink(encoded_path);
+    return status;
+}
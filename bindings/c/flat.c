@@ -0,0 +1,394 @@
+#include "tree_sitter/tree-sitter-wxml-flat.h"
+#include "tree_sitter/tree-sitter-wxml.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <tree_sitter/api.h>
+
+// Layout of an encoded tree:
+//
+//   header       16 little-endian u32 words, see the HEADER_* indices
+//   symbols      u16 per node
+//   flags        u8 per node
+//   streams      four varint streams, one value per node:
+//                  start byte, zigzag delta from the previous node's
+//                  length, end byte minus start byte
+//                  parent, index minus parent index (0 for the root)
+//                  next sibling, its index minus this one (0 for none)
+//   checkpoints  per block of WXML_FLAT_BLOCK nodes, five u32 words: the
+//                start byte before the block and the block's offset into
+//                each stream
+
+#define FLAT_MAGIC 0x46545857u // "WXTF"
+#define FLAT_VERSION 1u
+
+enum {
+    HEADER_MAGIC,
+    HEADER_VERSION,
+    HEADER_ABI_VERSION,
+    HEADER_SYMBOL_COUNT,
+    HEADER_NODE_COUNT,
+    HEADER_SOURCE_LENGTH,
+    HEADER_SYMBOLS,
+    HEADER_FLAGS,
+    HEADER_STREAMS,
+    HEADER_CHECKPOINTS = HEADER_STREAMS + 4,
+    HEADER_SIZE,
+    HEADER_WORDS = 16,
+};
+
+enum {
+    STREAM_START,
+    STREAM_LENGTH,
+    STREAM_PARENT,
+    STREAM_SIBLING,
+};
+
+#define CHECKPOINT_WORDS 5
+
+static inline void put_u32(uint8_t *out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+static inline uint32_t get_u32(const uint8_t *in) {
+    return (uint32_t)in[0] | (uint32_t)in[1] << 8 | (uint32_t)in[2] << 16 | (uint32_t)in[3] << 24;
+}
+
+static inline uint8_t *put_varint(uint8_t *out, uint32_t value) {
+    while (value >= 0x80) {
+        *out++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = (uint8_t)value;
+    return out;
+}
+
+static inline bool get_varint(const uint8_t **in, const uint8_t *end, uint32_t *value) {
+    const uint8_t *p = *in;
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        result |= (uint32_t)(byte & 0x7f) << shift;
+        if (byte < 0x80) {
+            *in = p;
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline uint32_t zigzag(int64_t value) {
+    return (uint32_t)(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static inline int64_t unzigzag(uint32_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+typedef struct {
+    uint32_t count;
+    uint32_t capacity;
+    uint16_t *symbols;
+    uint8_t *flags;
+    uint32_t *starts;
+    uint32_t *ends;
+    uint32_t *parents;
+    uint32_t *siblings;
+} Nodes;
+
+static bool nodes_reserve(Nodes *nodes, uint32_t capacity) {
+    if (capacity <= nodes->capacity) {
+        return true;
+    }
+    uint16_t *symbols = realloc(nodes->symbols, capacity * sizeof(uint16_t));
+    if (symbols != NULL) {
+        nodes->symbols = symbols;
+    }
+    uint8_t *flags = realloc(nodes->flags, capacity);
+    if (flags != NULL) {
+        nodes->flags = flags;
+    }
+    uint32_t **columns[] = {&nodes->starts, &nodes->ends, &nodes->parents, &nodes->siblings};
+    bool ok = symbols != NULL && flags != NULL;
+    for (size_t i = 0; i < sizeof(columns) / sizeof(*columns); i++) {
+        uint32_t *column = realloc(*columns[i], capacity * sizeof(uint32_t));
+        if (column == NULL) {
+            ok = false;
+        } else {
+            *columns[i] = column;
+        }
+    }
+    if (ok) {
+        nodes->capacity = capacity;
+    }
+    return ok;
+}
+
+static void nodes_delete(Nodes *nodes) {
+    free(nodes->symbols);
+    free(nodes->flags);
+    free(nodes->starts);
+    free(nodes->ends);
+    free(nodes->parents);
+    free(nodes->siblings);
+}
+
+// Flattens the tree in preorder, linking each node to its parent and its
+// previous sibling to it. `ancestors` and `last_children` are indexed by
+// depth.
+static bool collect(TSNode root, Nodes *nodes) {
+    uint32_t expected = ts_node_descendant_count(root);
+    if (!nodes_reserve(nodes, expected > 0 ? expected : 1)) {
+        return false;
+    }
+    uint32_t *ancestors = malloc(nodes->capacity * sizeof(uint32_t));
+    uint32_t *last_children = malloc(nodes->capacity * sizeof(uint32_t));
+    uint32_t depth_capacity = nodes->capacity;
+    bool ok = ancestors != NULL && last_children != NULL;
+
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    uint32_t depth = 0;
+    while (ok) {
+        uint32_t index = nodes->count;
+        if (index == nodes->capacity && !nodes_reserve(nodes, nodes->capacity * 2)) {
+            ok = false;
+            break;
+        }
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        nodes->symbols[index] = ts_node_symbol(node);
+        nodes->flags[index] = (ts_node_is_named(node) ? WXML_FLAT_NAMED : 0) |
+                              (ts_node_is_missing(node) ? WXML_FLAT_MISSING : 0) |
+                              (ts_node_is_extra(node) ? WXML_FLAT_EXTRA : 0) |
+                              (ts_node_has_error(node) ? WXML_FLAT_HAS_ERROR : 0);
+        nodes->starts[index] = ts_node_start_byte(node);
+        nodes->ends[index] = ts_node_end_byte(node);
+        nodes->siblings[index] = WXML_FLAT_NONE;
+        if (depth > 0) {
+            nodes->parents[index] = ancestors[depth - 1];
+            if (last_children[depth - 1] != WXML_FLAT_NONE) {
+                nodes->siblings[last_children[depth - 1]] = index;
+            }
+            last_children[depth - 1] = index;
+        } else {
+            nodes->parents[index] = WXML_FLAT_NONE;
+        }
+        nodes->count++;
+
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            if (depth == depth_capacity) {
+                depth_capacity *= 2;
+                uint32_t *grown_ancestors = realloc(ancestors, depth_capacity * sizeof(uint32_t));
+                if (grown_ancestors != NULL) {
+                    ancestors = grown_ancestors;
+                }
+                uint32_t *grown_last = realloc(last_children, depth_capacity * sizeof(uint32_t));
+                if (grown_last != NULL) {
+                    last_children = grown_last;
+                }
+                if (grown_ancestors == NULL || grown_last == NULL) {
+                    ok = false;
+                    break;
+                }
+            }
+            ancestors[depth] = index;
+            last_children[depth] = WXML_FLAT_NONE;
+            depth++;
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                goto done;
+            }
+            depth--;
+        }
+    }
+done:
+    ts_tree_cursor_delete(&cursor);
+    free(ancestors);
+    free(last_children);
+    return ok;
+}
+
+void *wxml_tree_encode(const TSTree *tree, size_t *size) {
+    Nodes nodes = {0};
+    TSNode root = ts_tree_root_node(tree);
+    if (!collect(root, &nodes)) {
+        nodes_delete(&nodes);
+        return NULL;
+    }
+
+    uint32_t count = nodes.count;
+    uint32_t blocks = (count + WXML_FLAT_BLOCK - 1) / WXML_FLAT_BLOCK;
+    size_t capacity = HEADER_WORDS * 4 + (size_t)count * 3 + (size_t)count * 4 * 5 +
+                      (size_t)blocks * CHECKPOINT_WORDS * 4;
+    uint8_t *buffer = malloc(capacity);
+    if (buffer == NULL) {
+        nodes_delete(&nodes);
+        return NULL;
+    }
+    // Streams are written to the tail of the buffer first, since their sizes
+    // are only known afterwards, and then moved into place.
+    uint8_t *scratch = buffer + HEADER_WORDS * 4 + (size_t)count * 3;
+    uint8_t *streams[4], *ends[4];
+    for (int s = 0; s < 4; s++) {
+        streams[s] = ends[s] = scratch + (size_t)s * count * 5;
+    }
+    uint8_t *checkpoints = malloc((size_t)blocks * CHECKPOINT_WORDS * 4 + 1);
+    if (checkpoints == NULL) {
+        free(buffer);
+        nodes_delete(&nodes);
+        return NULL;
+    }
+
+    uint8_t *symbols = buffer + HEADER_WORDS * 4;
+    uint8_t *flags = symbols + (size_t)count * 2;
+    uint32_t previous_start = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (i % WXML_FLAT_BLOCK == 0) {
+            uint8_t *checkpoint = checkpoints + (size_t)(i / WXML_FLAT_BLOCK) * CHECKPOINT_WORDS * 4;
+            put_u32(checkpoint, previous_start);
+            for (int s = 0; s < 4; s++) {
+                put_u32(checkpoint + 4 * (s + 1), (uint32_t)(ends[s] - streams[s]));
+            }
+        }
+        symbols[2 * i] = (uint8_t)nodes.symbols[i];
+        symbols[2 * i + 1] = (uint8_t)(nodes.symbols[i] >> 8);
+        flags[i] = nodes.flags[i];
+        ends[STREAM_START] = put_varint(ends[STREAM_START], zigzag((int64_t)nodes.starts[i] - previous_start));
+        ends[STREAM_LENGTH] = put_varint(ends[STREAM_LENGTH], nodes.ends[i] - nodes.starts[i]);
+        ends[STREAM_PARENT] =
+            put_varint(ends[STREAM_PARENT], nodes.parents[i] == WXML_FLAT_NONE ? 0 : i - nodes.parents[i]);
+        ends[STREAM_SIBLING] =
+            put_varint(ends[STREAM_SIBLING], nodes.siblings[i] == WXML_FLAT_NONE ? 0 : nodes.siblings[i] - i);
+        previous_start = nodes.starts[i];
+    }
+
+    uint32_t header[HEADER_WORDS] = {0};
+    header[HEADER_MAGIC] = FLAT_MAGIC;
+    header[HEADER_VERSION] = FLAT_VERSION;
+    header[HEADER_ABI_VERSION] = ts_language_abi_version(tree_sitter_wxml());
+    header[HEADER_SYMBOL_COUNT] = ts_language_symbol_count(tree_sitter_wxml());
+    header[HEADER_NODE_COUNT] = count;
+    header[HEADER_SOURCE_LENGTH] = count > 0 ? nodes.ends[0] : 0;
+    header[HEADER_SYMBOLS] = HEADER_WORDS * 4;
+    header[HEADER_FLAGS] = (uint32_t)(flags - buffer);
+    uint8_t *out = flags + count;
+    for (int s = 0; s < 4; s++) {
+        size_t length = (size_t)(ends[s] - streams[s]);
+        header[HEADER_STREAMS + s] = (uint32_t)(out - buffer);
+        memmove(out, streams[s], length);
+        out += length;
+    }
+    header[HEADER_CHECKPOINTS] = (uint32_t)(out - buffer);
+    memcpy(out, checkpoints, (size_t)blocks * CHECKPOINT_WORDS * 4);
+    out += (size_t)blocks * CHECKPOINT_WORDS * 4;
+    header[HEADER_SIZE] = (uint32_t)(out - buffer);
+    for (int w = 0; w < HEADER_WORDS; w++) {
+        put_u32(buffer + 4 * w, header[w]);
+    }
+
+    free(checkpoints);
+    nodes_delete(&nodes);
+    *size = (size_t)(out - buffer);
+    uint8_t *shrunk = realloc(buffer, *size);
+    return shrunk != NULL ? shrunk : buffer;
+}
+
+bool wxml_tree_decode(const void *data, size_t size, wxml_flat_tree *tree) {
+    const uint8_t *bytes = data;
+    if (size < HEADER_WORDS * 4) {
+        return false;
+    }
+    uint32_t header[HEADER_WORDS];
+    for (int w = 0; w < HEADER_WORDS; w++) {
+        header[w] = get_u32(bytes + 4 * w);
+    }
+    if (header[HEADER_MAGIC] != FLAT_MAGIC || header[HEADER_VERSION] != FLAT_VERSION ||
+        header[HEADER_ABI_VERSION] != ts_language_abi_version(tree_sitter_wxml()) ||
+        header[HEADER_SYMBOL_COUNT] != ts_language_symbol_count(tree_sitter_wxml()) ||
+        header[HEADER_SIZE] > size) {
+        return false;
+    }
+
+    // Sections must follow each other in order and fit in the buffer.
+    uint64_t count = header[HEADER_NODE_COUNT];
+    uint64_t blocks = (count + WXML_FLAT_BLOCK - 1) / WXML_FLAT_BLOCK;
+    if (header[HEADER_SYMBOLS] != HEADER_WORDS * 4 || header[HEADER_FLAGS] != header[HEADER_SYMBOLS] + count * 2 ||
+        header[HEADER_STREAMS] != header[HEADER_FLAGS] + count ||
+        header[HEADER_SIZE] != header[HEADER_CHECKPOINTS] + blocks * CHECKPOINT_WORDS * 4) {
+        return false;
+    }
+    for (int s = 0; s < 4; s++) {
+        if (header[HEADER_STREAMS + s + 1] < header[HEADER_STREAMS + s]) {
+            return false;
+        }
+    }
+
+    tree->node_count = (uint32_t)count;
+    tree->source_length = header[HEADER_SOURCE_LENGTH];
+    tree->symbols = bytes + header[HEADER_SYMBOLS];
+    tree->flags = bytes + header[HEADER_FLAGS];
+    for (int s = 0; s < 4; s++) {
+        tree->streams[s] = bytes + header[HEADER_STREAMS + s];
+        tree->stream_ends[s] = bytes + header[HEADER_STREAMS + s + 1];
+    }
+    tree->checkpoints = bytes + header[HEADER_CHECKPOINTS];
+    return true;
+}
+
+void wxml_flat_cursor_seek(wxml_flat_cursor *cursor, const wxml_flat_tree *tree, uint32_t index) {
+    cursor->tree = tree;
+    if (index >= tree->node_count) {
+        cursor->index = tree->node_count;
+        return;
+    }
+    uint32_t block = index / WXML_FLAT_BLOCK;
+    const uint8_t *checkpoint = tree->checkpoints + (size_t)block * CHECKPOINT_WORDS * 4;
+    cursor->index = block * WXML_FLAT_BLOCK;
+    cursor->start_byte = get_u32(checkpoint);
+    for (int s = 0; s < 4; s++) {
+        uint32_t offset = get_u32(checkpoint + 4 * (s + 1));
+        size_t length = (size_t)(tree->stream_ends[s] - tree->streams[s]);
+        cursor->streams[s] = tree->streams[s] + (offset <= length ? offset : length);
+    }
+    wxml_flat_node skipped;
+    while (cursor->index < index && wxml_flat_cursor_next(cursor, &skipped)) {
+    }
+}
+
+bool wxml_flat_cursor_next(wxml_flat_cursor *cursor, wxml_flat_node *node) {
+    const wxml_flat_tree *tree = cursor->tree;
+    uint32_t index = cursor->index;
+    if (index >= tree->node_count) {
+        return false;
+    }
+    uint32_t start_delta, length, parent_delta, sibling_delta;
+    if (!get_varint(&cursor->streams[STREAM_START], tree->stream_ends[STREAM_START], &start_delta) ||
+        !get_varint(&cursor->streams[STREAM_LENGTH], tree->stream_ends[STREAM_LENGTH], &length) ||
+        !get_varint(&cursor->streams[STREAM_PARENT], tree->stream_ends[STREAM_PARENT], &parent_delta) ||
+        !get_varint(&cursor->streams[STREAM_SIBLING], tree->stream_ends[STREAM_SIBLING], &sibling_delta) ||
+        parent_delta > index || sibling_delta > tree->node_count - index - 1) {
+        cursor->index = tree->node_count;
+        return false;
+    }
+    node->index = index;
+    node->start_byte = (uint32_t)((int64_t)cursor->start_byte + unzigzag(start_delta));
+    node->end_byte = node->start_byte + length;
+    node->parent = parent_delta == 0 ? WXML_FLAT_NONE : index - parent_delta;
+    node->next_sibling = sibling_delta == 0 ? WXML_FLAT_NONE : index + sibling_delta;
+    node->symbol = wxml_flat_tree_symbol(tree, index);
+    node->flags = wxml_flat_tree_flags(tree, index);
+    cursor->start_byte = node->start_byte;
+    cursor->index = index + 1;
+    return true;
+}
+
+bool wxml_flat_tree_node(const wxml_flat_tree *tree, uint32_t index, wxml_flat_node *node) {
+    wxml_flat_cursor cursor;
+    wxml_flat_cursor_seek(&cursor, tree, index);
+    return cursor.index == index && wxml_flat_cursor_next(&cursor, node);
+}
@@ -0,0 +1,152 @@
+#!/usr/bin/env node
+// Writes tree_sitter/tree-sitter-wxml-symbols.h from the symbol and field
+// tables in src/parser.c and from src/node-types.json. Runs after
+// `tree-sitter generate` so the ids never drift from the parser. With
+// --check, writes nothing and exits with 1 if the header is out of date.
+
+const fs = require("node:fs");
+const path = require("node:path");
+
+const root = path.join(__dirname, "..", "..");
+const parser = fs.readFileSync(path.join(root, "src", "parser.c"), "utf8");
+const nodeTypes = JSON.parse(fs.readFileSync(path.join(root, "src", "node-types.json"), "utf8"));
+const grammar = JSON.parse(fs.readFileSync(path.join(root, "src", "grammar.json"), "utf8"));
+const output = path.join(__dirname, "tree_sitter", "tree-sitter-wxml-symbols.h");
+
+// The lines of the top-level block opened by the line containing `header`.
+function section(header) {
+  const lines = parser.split("\n");
+  const start = lines.findIndex((line) => line.includes(header));
+  if (start < 0) return [];
+  const end = lines.indexOf("};", start);
+  return lines.slice(start + 1, end);
+}
+
+function entries(header, pattern) {
+  return section(header).map((line) => line.trim().match(pattern)).filter(Boolean);
+}
+
+const ids = new Map([["ts_builtin_sym_end", 0]]);
+for (const [, name, id] of entries("enum ts_symbol_identifiers {", /^(\w+) = (\d+),$/)) {
+  ids.set(name, Number(id));
+}
+const names = new Map(entries("ts_symbol_names[] = {", /^\[(\w+)\] = (".*"),$/)
+  .map(([, key, value]) => [key, JSON.parse(value)]));
+const publicIds = new Map(entries("ts_symbol_map[] = {", /^\[(\w+)\] = (\w+),$/)
+  .map(([, key, value]) => [key, value]));
+
+const metadata = new Map();
+let current = null;
+for (const line of section("ts_symbol_metadata[] = {")) {
+  const key = line.trim().match(/^\[(\w+)\] = \{$/);
+  const flag = line.trim().match(/^\.(visible|named) = (true|false),$/);
+  if (key) metadata.set((current = key[1]), {});
+  else if (flag && current) metadata.get(current)[flag[1]] = flag[2] === "true";
+}
+
+const fields = entries("enum ts_field_identifiers {", /^field_(\w+) = (\d+),$/)
+  .map(([, name, id]) => ({ name, id: Number(id) }));
+
+const named = [];
+const anonymous = [];
+const aliases = [];
+for (const [identifier, id] of ids) {
+  const meta = metadata.get(identifier) || {};
+  if (!meta.visible || publicIds.get(identifier) !== identifier) continue;
+  const name = names.get(identifier);
+  if (meta.named) {
+    named.push({ macro: name.toUpperCase(), name, id });
+    if (identifier.startsWith("alias_sym_")) aliases.push({ macro: name.toUpperCase(), name, id });
+  } else {
+    anonymous.push({ macro: identifier.replace(/^anon_sym_/, ""), name, id });
+  }
+}
+
+// The kinds that may occur anywhere below each named kind, as a bitmask of
+// kind ids. Extras and anonymous tokens may occur below any node that has
+// children, so they are included for every non-leaf kind.
+const idOf = new Map([...named, ...anonymous].map(({ name, id }) => [name, id]));
+const bit = (id) => 1n << BigInt(id);
+for (const { id } of [...named, ...anonymous]) {
+  if (id >= 64) throw new Error(`Symbol id ${id} does not fit in a 64-bit kind mask`);
+}
+const anywhere = grammar.extras
+  .filter((extra) => extra.type === "SYMBOL")
+  .reduce((mask, extra) => mask | bit(idOf.get(extra.name)), anonymous.reduce((mask, { id }) => mask | bit(id), 0n));
+const childMasks = new Map(nodeTypes.filter((type) => type.named).map((type) => {
+  const children = [type.children, ...Object.values(type.fields || {})].filter(Boolean);
+  const mask = children.flatMap((info) => info.types)
+    .reduce((mask, child) => mask | bit(idOf.get(child.type)), 0n);
+  return [type.type, mask === 0n ? 0n : mask | anywhere];
+}));
+const descendants = new Map(childMasks);
+for (let changed = true; changed;) {
+  changed = false;
+  for (const [name, mask] of descendants) {
+    let closure = mask;
+    for (const { name: child, id } of named) {
+      if (mask & bit(id)) closure |= descendants.get(child) || 0n;
+    }
+    if (closure !== mask) {
+      descendants.set(name, closure);
+      changed = true;
+    }
+  }
+}
+
+function defines(prefix, list) {
+  const width = Math.max(0, ...list.map(({ macro }) => prefix.length + macro.length));
+  return list.map(({ macro, name, id }) =>
+    `#define ${(prefix + macro).padEnd(width)} ${String(id).padEnd(5)} /* ${JSON.stringify(name)} */`);
+}
+
+function xmacro(macro, list, args = ({ name, id }) => `${name}, ${id}`) {
+  const lines = [`#define ${macro}(X)`, ...list.map((entry) => `    X(${args(entry)})`)];
+  const width = Math.max(...lines.map((line) => line.length)) + 1;
+  return lines.map((line, i) => (i < lines.length - 1 ? `${line.padEnd(width)}\\` : line));
+}
+
+const header = [
+  "/* Generated by bindings/c/generate-symbols.js from src/parser.c. Do not edit. */",
+  "",
+  "#ifndef TREE_SITTER_WXML_SYMBOLS_H_",
+  "#define TREE_SITTER_WXML_SYMBOLS_H_",
+  "",
+  "/* Named node kinds, as returned by ts_node_symbol. */",
+  ...defines("TS_WXML_SYM_", [...named, { macro: "ERROR", name: "ERROR", id: 65535 }]),
+  "",
+  "/* Anonymous node kinds. */",
+  ...defines("TS_WXML_SYM_", anonymous),
+  "",
+  "/* Node kinds introduced by aliases. */",
+  ...(aliases.length ? defines("TS_WXML_ALIAS_", aliases) : ["/* none */"]),
+  "",
+  "/* Field ids, as accepted by ts_node_child_by_field_id. */",
+  `#define TS_WXML_FIELD_COUNT ${fields.length}`,
+  ...defines("TS_WXML_FIELD_", fields.map(({ name, id }) => ({ macro: name.toUpperCase(), name, id }))),
+  "",
+  "/* X(name, id) for every named node kind. */",
+  ...xmacro("TREE_SITTER_WXML_NAMED_SYMBOLS", named),
+  "",
+  "/* X(name, id, mask) for every named node kind, where mask has the bit",
+  " * TS_WXML_KIND_BIT(id) set for each kind that may occur below it. */",
+  "#define TS_WXML_KIND_BIT(id) (1ULL << (id))",
+  ...xmacro("TREE_SITTER_WXML_DESCENDANTS", named,
+    ({ name, id }) => `${name}, ${id}, 0x${descendants.get(name).toString(16).padStart(16, "0")}ULL`),
+  "",
+  "/* X(name, id) for every field. */",
+  ...(fields.length ? xmacro("TREE_SITTER_WXML_FIELDS", fields) : ["#define TREE_SITTER_WXML_FIELDS(X)"]),
+  "",
+  "#endif // TREE_SITTER_WXML_SYMBOLS_H_",
+  "",
+].join("\n");
+
+if (process.argv.includes("--check")) {
+  const current = fs.existsSync(output) ? fs.readFileSync(output, "utf8") : "";
+  if (current !== header) {
+    console.error(`${path.relative(root, output)} is out of date with src/parser.c; run bindings/c/generate-symbols.js`);
+    process.exit(1);
+  }
+} else {
+  fs.writeFileSync(output, header);
+}
@@ -0,0 +1,136 @@
+#include "tree_sitter/tree-sitter-wxml-pool.h"
+#include "tree_sitter/tree-sitter-wxml.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <tree_sitter/api.h>
+
+// The idle parsers form a Treiber stack over slot indices. `head` packs the
+// top slot (plus one, so zero means empty) in its low half and a counter
+// in its high half that is bumped on every change, which rules out ABA.
+//
+// `by_address` lists the slots in the order of their parsers' addresses, so
+// that release finds a parser's slot with a binary search.
+struct wxml_parser_pool {
+    _Atomic uint64_t head;
+    uint32_t size;
+    _Atomic uint32_t *next;
+    TSParser **parsers;
+    uint32_t *by_address;
+};
+
+static TSParser *new_parser(void) {
+    TSParser *parser = ts_parser_new();
+    if (parser != NULL && !ts_parser_set_language(parser, tree_sitter_wxml())) {
+        ts_parser_delete(parser);
+        return NULL;
+    }
+    return parser;
+}
+
+// The first position in `by_address` whose parser is not below `parser`.
+static uint32_t lower_bound(const wxml_parser_pool *pool, uint32_t count, const TSParser *parser) {
+    uint32_t low = 0, high = count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if ((uintptr_t)pool->parsers[pool->by_address[middle]] < (uintptr_t)parser) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static inline uint64_t pack(uint64_t head, uint32_t top) {
+    return (((head >> 32) + 1) << 32) | top;
+}
+
+static void push(wxml_parser_pool *pool, uint32_t slot) {
+    uint64_t head = atomic_load_explicit(&pool->head, memory_order_relaxed);
+    do {
+        atomic_store_explicit(&pool->next[slot], (uint32_t)head, memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(&pool->head, &head, pack(head, slot + 1),
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+wxml_parser_pool *wxml_parser_pool_create(uint32_t size) {
+    wxml_parser_pool *pool = calloc(1, sizeof(wxml_parser_pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->next = calloc(size, sizeof(*pool->next));
+    pool->parsers = calloc(size, sizeof(TSParser *));
+    pool->by_address = calloc(size, sizeof(uint32_t));
+    if ((pool->next == NULL || pool->parsers == NULL || pool->by_address == NULL) && size > 0) {
+        wxml_parser_pool_delete(pool);
+        return NULL;
+    }
+    atomic_init(&pool->head, 0);
+    for (; pool->size < size; pool->size++) {
+        TSParser *parser = new_parser();
+        if (parser == NULL) {
+            wxml_parser_pool_delete(pool);
+            return NULL;
+        }
+        pool->parsers[pool->size] = parser;
+        uint32_t at = lower_bound(pool, pool->size, parser);
+        memmove(&pool->by_address[at + 1], &pool->by_address[at], (pool->size - at) * sizeof(uint32_t));
+        pool->by_address[at] = pool->size;
+        push(pool, pool->size);
+    }
+    return pool;
+}
+
+void wxml_parser_pool_delete(wxml_parser_pool *pool) {
+    for (uint32_t i = 0; i < pool->size; i++) {
+        ts_parser_delete(pool->parsers[i]);
+    }
+    free(pool->parsers);
+    free(pool->by_address);
+    free((void *)pool->next);
+    free(pool);
+}
+
+TSParser *wxml_parser_pool_acquire(wxml_parser_pool *pool) {
+    uint64_t head = atomic_load_explicit(&pool->head, memory_order_acquire);
+    for (;;) {
+        uint32_t top = (uint32_t)head;
+        if (top == 0) {
+            return NULL;
+        }
+        uint32_t next = atomic_load_explicit(&pool->next[top - 1], memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(&pool->head, &head, pack(head, next),
+                                                  memory_order_acquire, memory_order_acquire)) {
+            return pool->parsers[top - 1];
+        }
+    }
+}
+
+void wxml_parser_pool_release(wxml_parser_pool *pool, TSParser *parser) {
+    uint32_t at = lower_bound(pool, pool->size, parser);
+    if (at == pool->size || pool->parsers[pool->by_address[at]] != parser) {
+        ts_parser_delete(parser);
+        return;
+    }
+    ts_parser_reset(parser);
+    push(pool, pool->by_address[at]);
+}
+
+TSTree *wxml_parser_pool_parse(wxml_parser_pool *pool, const TSTree *old_tree,
+                               const char *source, uint32_t length) {
+    TSParser *parser = wxml_parser_pool_acquire(pool);
+    if (parser == NULL) {
+        TSParser *temporary = new_parser();
+        if (temporary == NULL) {
+            return NULL;
+        }
+        TSTree *tree = ts_parser_parse_string(temporary, old_tree, source, length);
+        ts_parser_delete(temporary);
+        return tree;
+    }
+    TSTree *tree = ts_parser_parse_string(parser, old_tree, source, length);
+    wxml_parser_pool_release(pool, parser);
+    return tree;
+}
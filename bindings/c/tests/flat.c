@@ -0,0 +1,199 @@
+// Encodes the trees of a few documents, checks that decoding them yields
+// every node of the original tree in preorder, and that truncated or
+// corrupted buffers are rejected or read without leaving the buffer.
+//
+//   flat-test
+
+#include "tree_sitter/tree-sitter-wxml-flat.h"
+#include "tree_sitter/tree-sitter-wxml.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <tree_sitter/api.h>
+
+static int failures = 0;
+
+static void fail(const char *name, const char *what, uint32_t at) {
+    fprintf(stderr, "FAIL %s: %s at %u\n", name, what, at);
+    failures++;
+}
+
+// A copy of `size` bytes in an allocation of exactly that size, so that a
+// read past the end is caught by the sanitizers.
+static uint8_t *copy(const void *data, size_t size) {
+    uint8_t *result = malloc(size > 0 ? size : 1);
+    if (result == NULL) {
+        abort();
+    }
+    memcpy(result, data, size);
+    return result;
+}
+
+static uint32_t index_of(TSNode node, const TSNode *nodes, uint32_t count) {
+    if (ts_node_is_null(node)) {
+        return WXML_FLAT_NONE;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (ts_node_eq(node, nodes[i])) {
+            return i;
+        }
+    }
+    return count;
+}
+
+static void check_round_trip(const char *name, const TSTree *tree, const void *encoded, size_t size) {
+    wxml_flat_tree flat;
+    if (!wxml_tree_decode(encoded, size, &flat)) {
+        fail(name, "decode", 0);
+        return;
+    }
+
+    TSNode root = ts_tree_root_node(tree);
+    uint32_t count = ts_node_descendant_count(root);
+    TSNode *nodes = malloc(count * sizeof(TSNode));
+    uint32_t n = 0;
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    for (;;) {
+        nodes[n++] = ts_tree_cursor_current_node(&cursor);
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                goto walked;
+            }
+        }
+    }
+walked:
+    ts_tree_cursor_delete(&cursor);
+    if (flat.node_count != n || flat.source_length != ts_node_end_byte(root)) {
+        fail(name, "node count or source length", flat.node_count);
+    }
+
+    wxml_flat_cursor flat_cursor;
+    wxml_flat_node node;
+    wxml_flat_cursor_seek(&flat_cursor, &flat, 0);
+    uint32_t i = 0;
+    for (; i < n && wxml_flat_cursor_next(&flat_cursor, &node); i++) {
+        TSNode expected = nodes[i];
+        uint8_t flags = (ts_node_is_named(expected) ? WXML_FLAT_NAMED : 0) |
+                        (ts_node_is_missing(expected) ? WXML_FLAT_MISSING : 0) |
+                        (ts_node_is_extra(expected) ? WXML_FLAT_EXTRA : 0) |
+                        (ts_node_has_error(expected) ? WXML_FLAT_HAS_ERROR : 0);
+        if (node.index != i || node.symbol != ts_node_symbol(expected) || node.flags != flags ||
+            node.start_byte != ts_node_start_byte(expected) || node.end_byte != ts_node_end_byte(expected) ||
+            node.parent != index_of(ts_node_parent(expected), nodes, n) ||
+            node.next_sibling != index_of(ts_node_next_sibling(expected), nodes, n)) {
+            fail(name, "node differs", i);
+            break;
+        }
+        wxml_flat_node random;
+        if (!wxml_flat_tree_node(&flat, i, &random) || memcmp(&random, &node, sizeof node) != 0) {
+            fail(name, "random access differs", i);
+            break;
+        }
+    }
+    if (i != n || wxml_flat_cursor_next(&flat_cursor, &node)) {
+        fail(name, "cursor length", i);
+    }
+    if (wxml_flat_tree_node(&flat, n, &node)) {
+        fail(name, "node past the end", n);
+    }
+    free(nodes);
+}
+
+// Every node a cursor yields from a decoded buffer, however corrupted,
+// must still link inside the tree.
+static void walk_corrupt(const char *name, const uint8_t *data, size_t size, uint32_t at) {
+    wxml_flat_tree flat;
+    if (!wxml_tree_decode(data, size, &flat)) {
+        return;
+    }
+    wxml_flat_cursor cursor;
+    wxml_flat_node node;
+    wxml_flat_cursor_seek(&cursor, &flat, 0);
+    while (wxml_flat_cursor_next(&cursor, &node)) {
+        if ((node.parent != WXML_FLAT_NONE && node.parent >= node.index) ||
+            (node.next_sibling != WXML_FLAT_NONE &&
+             (node.next_sibling <= node.index || node.next_sibling >= flat.node_count))) {
+            fail(name, "corrupt buffer links outside the tree", at);
+            return;
+        }
+    }
+    for (uint32_t i = 0; i < flat.node_count; i += WXML_FLAT_BLOCK / 2) {
+        wxml_flat_tree_node(&flat, i, &node);
+    }
+}
+
+static void check_damage(const char *name, const uint8_t *encoded, size_t size) {
+    for (size_t length = 0; length < size; length++) {
+        uint8_t *truncated = copy(encoded, length);
+        wxml_flat_tree flat;
+        if (wxml_tree_decode(truncated, length, &flat)) {
+            fail(name, "truncated buffer decodes", (uint32_t)length);
+        }
+        free(truncated);
+    }
+
+    uint8_t *corrupt = copy(encoded, size);
+    for (size_t i = 0; i < size; i++) {
+        for (int bit = 0; bit < 8; bit++) {
+            corrupt[i] ^= (uint8_t)(1u << bit);
+            walk_corrupt(name, corrupt, size, (uint32_t)i);
+            corrupt[i] ^= (uint8_t)(1u << bit);
+        }
+    }
+    free(corrupt);
+}
+
+int main(void) {
+    static const char *sources[] = {
+        "",
+        "<view/>",
+        "<view class=\"a {{ b }}\" wx:if=\"{{ c }}\">\n  <text>{{ msg }} and more</text>\n</view>\n",
+        "<import src=\"a.wxml\"/>\n<template name=\"t\"><view>{{ x }}</view></template>\n"
+        "<template is=\"t\" data=\"{{ ...item }}\"/>\n<wxs module=\"m\">module.exports = 1;</wxs>\n",
+        "<view>\n  <text>unclosed\n</view>\n",
+    };
+    size_t source_count = sizeof sources / sizeof *sources;
+
+    // A document of a few hundred nodes, so that the trees span several
+    // checkpoint blocks.
+    char long_source[4096] = "";
+    for (int i = 0; i < 40; i++) {
+        strcat(long_source, "<view id=\"x\">{{ a }}<text>b</text></view>\n");
+    }
+
+    TSParser *parser = ts_parser_new();
+    if (!ts_parser_set_language(parser, tree_sitter_wxml())) {
+        fputs("flat-test: the tree-sitter runtime cannot load this parser's language\n", stderr);
+        ts_parser_delete(parser);
+        return 2;
+    }
+    for (size_t s = 0; s <= source_count; s++) {
+        const char *source = s < source_count ? sources[s] : long_source;
+        char name[32];
+        snprintf(name, sizeof name, "source %zu", s);
+
+        TSTree *tree = ts_parser_parse_string(parser, NULL, source, (uint32_t)strlen(source));
+        size_t size;
+        void *encoded = wxml_tree_encode(tree, &size);
+        if (tree == NULL || encoded == NULL) {
+            fail(name, "parse or encode", 0);
+        } else {
+            uint8_t *exact = copy(encoded, size);
+            check_round_trip(name, tree, exact, size);
+            if (s < source_count) {
+                check_damage(name, exact, size);
+            }
+            free(exact);
+        }
+        free(encoded);
+        ts_tree_delete(tree);
+    }
+    ts_parser_delete(parser);
+
+    printf("%zu sources, %d failures\n", source_count + 1, failures);
+    return failures > 0 ? 1 : 0;
+}
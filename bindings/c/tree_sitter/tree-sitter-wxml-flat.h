@@ -0,0 +1,105 @@
+#ifndef TREE_SITTER_WXML_FLAT_H_
+#define TREE_SITTER_WXML_FLAT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct TSTree TSTree;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A flat, position-independent encoding of a WXML syntax tree that can be
+ * written to disk, shared between processes and read straight out of a
+ * memory mapping. Defined in libtree-sitter-wxml-flat, which links against
+ * the tree-sitter runtime.
+ *
+ * Nodes are numbered in preorder, so the root is node 0, a node's parent
+ * always has a smaller index, and a node's first child, if it has any, is
+ * the next node. Every property is stored as its own array: symbols as
+ * 16-bit values and flags as bytes, both indexed directly, while start
+ * bytes, lengths, parent and sibling links are delta-encoded varint
+ * streams with a checkpoint every WXML_FLAT_BLOCK nodes. Sequential reads
+ * through wxml_flat_cursor cost O(1) per node; random access decodes at
+ * most one block.
+ *
+ * All values are little-endian and the buffer needs no alignment.
+ */
+
+#define WXML_FLAT_BLOCK 64
+#define WXML_FLAT_NONE UINT32_MAX
+
+enum {
+    WXML_FLAT_NAMED = 1 << 0,
+    WXML_FLAT_MISSING = 1 << 1,
+    WXML_FLAT_EXTRA = 1 << 2,
+    WXML_FLAT_HAS_ERROR = 1 << 3,
+};
+
+typedef struct wxml_flat_node {
+    uint32_t index;
+    uint32_t parent;       /* WXML_FLAT_NONE for the root */
+    uint32_t next_sibling; /* WXML_FLAT_NONE for the last child */
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint16_t symbol;
+    uint8_t flags;
+} wxml_flat_node;
+
+/* A view of an encoded tree. It points into the buffer it was decoded from. */
+typedef struct wxml_flat_tree {
+    uint32_t node_count;
+    uint32_t source_length;
+    const uint8_t *symbols;
+    const uint8_t *flags;
+    const uint8_t *streams[4];
+    const uint8_t *stream_ends[4];
+    const uint8_t *checkpoints;
+} wxml_flat_tree;
+
+typedef struct wxml_flat_cursor {
+    const wxml_flat_tree *tree;
+    uint32_t index;
+    uint32_t start_byte;
+    const uint8_t *streams[4];
+} wxml_flat_cursor;
+
+/*
+ * Encode `tree` into a buffer allocated with malloc. Returns NULL if
+ * allocation fails. The caller frees the buffer with free().
+ */
+void *wxml_tree_encode(const TSTree *tree, size_t *size);
+
+/*
+ * Check the header and layout of `size` bytes at `data` and point `tree`
+ * into them. Nothing is copied, so `data` must outlive `tree`. Returns
+ * false if the buffer is not an encoded tree for this grammar's ABI and
+ * symbol table.
+ */
+bool wxml_tree_decode(const void *data, size_t size, wxml_flat_tree *tree);
+
+static inline uint16_t wxml_flat_tree_symbol(const wxml_flat_tree *tree, uint32_t index) {
+    return (uint16_t)(tree->symbols[2 * index] | tree->symbols[2 * index + 1] << 8);
+}
+
+static inline uint8_t wxml_flat_tree_flags(const wxml_flat_tree *tree, uint32_t index) {
+    return tree->flags[index];
+}
+
+/* Read node `index` in full. Returns false if it is out of range or corrupt. */
+bool wxml_flat_tree_node(const wxml_flat_tree *tree, uint32_t index, wxml_flat_node *node);
+
+/* Position `cursor` so that the next call to wxml_flat_cursor_next yields `index`. */
+void wxml_flat_cursor_seek(wxml_flat_cursor *cursor, const wxml_flat_tree *tree, uint32_t index);
+
+/* Read the next node in preorder. Returns false at the end or on corrupt input. */
+bool wxml_flat_cursor_next(wxml_flat_cursor *cursor, wxml_flat_node *node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_WXML_FLAT_H_
@@ -0,0 +1,51 @@
+#ifndef TREE_SITTER_WXML_POOL_H_
+#define TREE_SITTER_WXML_POOL_H_
+
+#include <stdint.h>
+
+typedef struct TSParser TSParser;
+typedef struct TSTree TSTree;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A fixed set of WXML parsers shared between threads, so that parsers and
+ * their internal buffers are reused across requests. Acquire and release
+ * are lock-free. Defined in libtree-sitter-wxml-pool, which links against
+ * the tree-sitter runtime.
+ */
+typedef struct wxml_parser_pool wxml_parser_pool;
+
+/*
+ * Create a pool of `size` parsers. Returns NULL if allocation fails or the
+ * runtime cannot load the WXML language.
+ */
+wxml_parser_pool *wxml_parser_pool_create(uint32_t size);
+
+/* Delete the pool and its parsers. No parser may still be acquired. */
+void wxml_parser_pool_delete(wxml_parser_pool *pool);
+
+/* Take an idle parser, or return NULL if every parser is in use. */
+TSParser *wxml_parser_pool_acquire(wxml_parser_pool *pool);
+
+/*
+ * Reset a parser taken from `pool` and make it available again. A parser
+ * that does not belong to the pool is deleted instead.
+ */
+void wxml_parser_pool_release(wxml_parser_pool *pool, TSParser *parser);
+
+/*
+ * Parse `source` with a pooled parser, falling back to a temporary one
+ * when the pool is exhausted. `old_tree` may be NULL. Returns NULL if the
+ * temporary parser cannot be created or parsing fails.
+ */
+TSTree *wxml_parser_pool_parse(wxml_parser_pool *pool, const TSTree *old_tree,
+                               const char *source, uint32_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_WXML_POOL_H_
@@ -0,0 +1,129 @@
+#ifndef TREE_SITTER_WXML_PREORDER_H_
+#define TREE_SITTER_WXML_PREORDER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <tree_sitter/api.h>
+
+#include "tree-sitter-wxml-symbols.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A preorder walk that yields only nodes whose kind is in a bitmask of
+ * TS_WXML_KIND_BIT(id) values, and never descends into a subtree that
+ * cannot contain one of them, such as raw_text or comment. Subtrees with
+ * errors are always searched.
+ *
+ * The walk itself does not allocate. The cursor's stack only grows past
+ * the deepest level seen so far, so reusing an iterator across trees with
+ * wxml_preorder_reset makes steady-state traversal allocation-free.
+ */
+typedef struct wxml_preorder {
+    TSTreeCursor cursor;
+    uint64_t wanted;
+    bool started;
+    bool done;
+} wxml_preorder;
+
+/* The kinds that may occur below a node of kind `symbol`. */
+static inline uint64_t wxml_descendant_kinds(TSSymbol symbol) {
+    switch (symbol) {
+#define TS_WXML_DESCENDANTS_CASE(name, id, mask)                                                   \
+    case id:                                                                                       \
+        return mask;
+        TREE_SITTER_WXML_DESCENDANTS(TS_WXML_DESCENDANTS_CASE)
+#undef TS_WXML_DESCENDANTS_CASE
+        default:
+            return ~(uint64_t)0;
+    }
+}
+
+static inline wxml_preorder wxml_preorder_new(TSNode root, uint64_t wanted) {
+    wxml_preorder self = {ts_tree_cursor_new(root), wanted, false, false};
+    return self;
+}
+
+static inline void wxml_preorder_reset(wxml_preorder *self, TSNode root) {
+    ts_tree_cursor_reset(&self->cursor, root);
+    self->started = false;
+    self->done = false;
+}
+
+static inline void wxml_preorder_delete(wxml_preorder *self) {
+    ts_tree_cursor_delete(&self->cursor);
+}
+
+/*
+ * Like wxml_preorder_next, with the wanted kinds passed explicitly so that
+ * a constant mask folds into the traversal.
+ */
+static inline bool wxml_preorder_next_kinds(wxml_preorder *self, uint64_t wanted, TSNode *node) {
+#define TS_WXML_WANTS(symbol) ((symbol) < 64 && (TS_WXML_KIND_BIT(symbol) & wanted) != 0)
+    if (self->done) {
+        return false;
+    }
+    TSNode current = ts_tree_cursor_current_node(&self->cursor);
+    TSSymbol symbol = ts_node_symbol(current);
+    if (!self->started) {
+        self->started = true;
+        if (TS_WXML_WANTS(symbol)) {
+            *node = current;
+            return true;
+        }
+    }
+    for (;;) {
+        bool descend = (wxml_descendant_kinds(symbol) & wanted) != 0 || ts_node_has_error(current);
+        if (!descend || !ts_tree_cursor_goto_first_child(&self->cursor)) {
+            while (!ts_tree_cursor_goto_next_sibling(&self->cursor)) {
+                if (!ts_tree_cursor_goto_parent(&self->cursor)) {
+                    self->done = true;
+                    return false;
+                }
+            }
+        }
+        current = ts_tree_cursor_current_node(&self->cursor);
+        symbol = ts_node_symbol(current);
+        if (TS_WXML_WANTS(symbol)) {
+            *node = current;
+            return true;
+        }
+    }
+#undef TS_WXML_WANTS
+}
+
+/* Store the next wanted node in `node`, or return false at the end. */
+static inline bool wxml_preorder_next(wxml_preorder *self, TSNode *node) {
+    return wxml_preorder_next_kinds(self, self->wanted, node);
+}
+
+/*
+ * Count the ERROR and MISSING nodes at or below `root`, only descending
+ * into subtrees that contain an error.
+ */
+static inline uint32_t wxml_count_errors(TSNode root) {
+    uint32_t count = 0;
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    for (;;) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        bool error = ts_node_is_error(node) || ts_node_is_missing(node);
+        count += error ? 1 : 0;
+        if (!error && ts_node_has_error(node) && ts_tree_cursor_goto_first_child(&cursor)) {
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                ts_tree_cursor_delete(&cursor);
+                return count;
+            }
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_WXML_PREORDER_H_
@@ -0,0 +1,133 @@
+/* Generated by bindings/c/generate-symbols.js from src/parser.c. Do not edit. */
+
+#ifndef TREE_SITTER_WXML_SYMBOLS_H_
+#define TREE_SITTER_WXML_SYMBOLS_H_
+
+/* Named node kinds, as returned by ts_node_symbol. */
+#define TS_WXML_SYM_ATTRIBUTE_NAME         10    /* "attribute_name" */
+#define TS_WXML_SYM_ATTRIBUTE_VALUE        11    /* "attribute_value" */
+#define TS_WXML_SYM_ENTITY                 12    /* "entity" */
+#define TS_WXML_SYM_TEXT                   17    /* "text" */
+#define TS_WXML_SYM_TAG_NAME               23    /* "tag_name" */
+#define TS_WXML_SYM_RAW_TEXT               25    /* "raw_text" */
+#define TS_WXML_SYM_COMMENT                26    /* "comment" */
+#define TS_WXML_SYM_INTERPOLATION_START    27    /* "interpolation_start" */
+#define TS_WXML_SYM_INTERPOLATION_END      28    /* "interpolation_end" */
+#define TS_WXML_SYM_DOCUMENT               29    /* "document" */
+#define TS_WXML_SYM_ELEMENT                31    /* "element" */
+#define TS_WXML_SYM_START_TAG              32    /* "start_tag" */
+#define TS_WXML_SYM_SELF_CLOSING_TAG       33    /* "self_closing_tag" */
+#define TS_WXML_SYM_END_TAG                34    /* "end_tag" */
+#define TS_WXML_SYM_ATTRIBUTE              35    /* "attribute" */
+#define TS_WXML_SYM_QUOTED_ATTRIBUTE_VALUE 36    /* "quoted_attribute_value" */
+#define TS_WXML_SYM_INTERPOLATION          37    /* "interpolation" */
+#define TS_WXML_SYM_IMPORT_STATEMENT       40    /* "import_statement" */
+#define TS_WXML_SYM_INCLUDE_STATEMENT      41    /* "include_statement" */
+#define TS_WXML_SYM_TEMPLATE_ELEMENT       42    /* "template_element" */
+#define TS_WXML_SYM_TEMPLATE_START_TAG     43    /* "template_start_tag" */
+#define TS_WXML_SYM_TEMPLATE_END_TAG       44    /* "template_end_tag" */
+#define TS_WXML_SYM_SLOT_ELEMENT           45    /* "slot_element" */
+#define TS_WXML_SYM_SLOT_START_TAG         46    /* "slot_start_tag" */
+#define TS_WXML_SYM_SLOT_END_TAG           47    /* "slot_end_tag" */
+#define TS_WXML_SYM_BLOCK_ELEMENT          48    /* "block_element" */
+#define TS_WXML_SYM_WXS_ELEMENT            49    /* "wxs_element" */
+#define TS_WXML_SYM_BLOCK_START_TAG        50    /* "block_start_tag" */
+#define TS_WXML_SYM_BLOCK_END_TAG          51    /* "block_end_tag" */
+#define TS_WXML_SYM_WXS_START_TAG          52    /* "wxs_start_tag" */
+#define TS_WXML_SYM_WXS_END_TAG            53    /* "wxs_end_tag" */
+#define TS_WXML_SYM_EXPRESSION             58    /* "expression" */
+#define TS_WXML_SYM_ERROR                  65535 /* "ERROR" */
+
+/* Anonymous node kinds. */
+#define TS_WXML_SYM_LT       1     /* "<" */
+#define TS_WXML_SYM_GT       2     /* ">" */
+#define TS_WXML_SYM_SLASH_GT 7     /* "/>" */
+#define TS_WXML_SYM_LT_SLASH 8     /* "</" */
+#define TS_WXML_SYM_EQ       9     /* "=" */
+#define TS_WXML_SYM_SQUOTE   13    /* "'" */
+#define TS_WXML_SYM_DQUOTE   15    /* "\"" */
+#define TS_WXML_SYM_LBRACE   19    /* "{" */
+#define TS_WXML_SYM_RBRACE   20    /* "}" */
+
+/* Node kinds introduced by aliases. */
+#define TS_WXML_ALIAS_EXPRESSION 58    /* "expression" */
+
+/* Field ids, as accepted by ts_node_child_by_field_id. */
+#define TS_WXML_FIELD_COUNT 0
+
+/* X(name, id) for every named node kind. */
+#define TREE_SITTER_WXML_NAMED_SYMBOLS(X) \
+    X(attribute_name, 10)                 \
+    X(attribute_value, 11)                \
+    X(entity, 12)                         \
+    X(text, 17)                           \
+    X(tag_name, 23)                       \
+    X(raw_text, 25)                       \
+    X(comment, 26)                        \
+    X(interpolation_start, 27)            \
+    X(interpolation_end, 28)              \
+    X(document, 29)                       \
+    X(element, 31)                        \
+    X(start_tag, 32)                      \
+    X(self_closing_tag, 33)               \
+    X(end_tag, 34)                        \
+    X(attribute, 35)                      \
+    X(quoted_attribute_value, 36)         \
+    X(interpolation, 37)                  \
+    X(import_statement, 40)               \
+    X(include_statement, 41)              \
+    X(template_element, 42)               \
+    X(template_start_tag, 43)             \
+    X(template_end_tag, 44)               \
+    X(slot_element, 45)                   \
+    X(slot_start_tag, 46)                 \
+    X(slot_end_tag, 47)                   \
+    X(block_element, 48)                  \
+    X(wxs_element, 49)                    \
+    X(block_start_tag, 50)                \
+    X(block_end_tag, 51)                  \
+    X(wxs_start_tag, 52)                  \
+    X(wxs_end_tag, 53)                    \
+    X(expression, 58)
+
+/* X(name, id, mask) for every named node kind, where mask has the bit
+ * TS_WXML_KIND_BIT(id) set for each kind that may occur below it. */
+#define TS_WXML_KIND_BIT(id) (1ULL << (id))
+#define TREE_SITTER_WXML_DESCENDANTS(X)                  \
+    X(attribute_name, 10, 0x0000000000000000ULL)         \
+    X(attribute_value, 11, 0x0000000000000000ULL)        \
+    X(entity, 12, 0x0000000000000000ULL)                 \
+    X(text, 17, 0x0000000000000000ULL)                   \
+    X(tag_name, 23, 0x0000000000000000ULL)               \
+    X(raw_text, 25, 0x0000000000000000ULL)               \
+    X(comment, 26, 0x0000000000000000ULL)                \
+    X(interpolation_start, 27, 0x0000000000000000ULL)    \
+    X(interpolation_end, 28, 0x0000000000000000ULL)      \
+    X(document, 29, 0x043fff3f9e9abf86ULL)               \
+    X(element, 31, 0x043fff3f9e9abf86ULL)                \
+    X(start_tag, 32, 0x040000381c98bf86ULL)              \
+    X(self_closing_tag, 33, 0x040000381c98bf86ULL)       \
+    X(end_tag, 34, 0x000000000498a386ULL)                \
+    X(attribute, 35, 0x040000301c18bf86ULL)              \
+    X(quoted_attribute_value, 36, 0x040000201c18b386ULL) \
+    X(interpolation, 37, 0x040000201c18a386ULL)          \
+    X(import_statement, 40, 0x040000381c98bf86ULL)       \
+    X(include_statement, 41, 0x040000381c98bf86ULL)      \
+    X(template_element, 42, 0x043fff3f9e9abf86ULL)       \
+    X(template_start_tag, 43, 0x040000381c98bf86ULL)     \
+    X(template_end_tag, 44, 0x000000000498a386ULL)       \
+    X(slot_element, 45, 0x043fff3f9e9abf86ULL)           \
+    X(slot_start_tag, 46, 0x040000381c98bf86ULL)         \
+    X(slot_end_tag, 47, 0x000000000498a386ULL)           \
+    X(block_element, 48, 0x043fff3f9e9abf86ULL)          \
+    X(wxs_element, 49, 0x043000381e98bf86ULL)            \
+    X(block_start_tag, 50, 0x040000381c98bf86ULL)        \
+    X(block_end_tag, 51, 0x000000000498a386ULL)          \
+    X(wxs_start_tag, 52, 0x040000381c98bf86ULL)          \
+    X(wxs_end_tag, 53, 0x000000000498a386ULL)            \
+    X(expression, 58, 0x040000201c18a386ULL)
+
+/* X(name, id) for every field. */
+#define TREE_SITTER_WXML_FIELDS(X)
+
+#endif // TREE_SITTER_WXML_SYMBOLS_H_
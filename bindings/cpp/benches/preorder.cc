@@ -0,0 +1,123 @@
+// Compares wxml::Preorder against full cursor walks that test every node,
+// by kind name and by kind id, when collecting elements, attributes and
+// interpolations from a generated page.
+
+#include <tree_sitter/tree-sitter-wxml.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+std::string page(int rows) {
+    std::string source = "<import src=\"../common/item.wxml\" />\n";
+    for (int i = 0; i < rows; i++) {
+        source += "<view class=\"row-" + std::to_string(i) + "\" wx:for=\"{{list}}\" bindtap=\"onTap\">\n";
+        source += "  <!-- item " + std::to_string(i) + ": keep the markup below in sync with item.wxml -->\n";
+        source += "  <block wx:if=\"{{item.visible}}\">\n";
+        source += "    <text>{{item.count}} &amp; more</text>\n  </block>\n</view>\n";
+        if (i % 16 == 0) {
+            source += "<wxs module=\"fmt\">\n";
+            source += "  var pad = function (n) { return n < 10 ? '0' + n : '' + n; };\n";
+            source += "  module.exports = { pad: pad };\n</wxs>\n";
+        }
+    }
+    return source;
+}
+
+size_t walk_by_name(TSNode root) {
+    size_t count = 0;
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    for (;;) {
+        const char *type = ts_node_type(ts_tree_cursor_current_node(&cursor));
+        if (std::strcmp(type, "element") == 0 || std::strcmp(type, "attribute") == 0 ||
+            std::strcmp(type, "interpolation") == 0) {
+            count++;
+        }
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                ts_tree_cursor_delete(&cursor);
+                return count;
+            }
+        }
+    }
+}
+
+size_t walk_by_id(TSNode root) {
+    size_t count = 0;
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    for (;;) {
+        switch (ts_node_symbol(ts_tree_cursor_current_node(&cursor))) {
+            case wxml::symbol::element:
+            case wxml::symbol::attribute:
+            case wxml::symbol::interpolation:
+                count++;
+                break;
+            default:
+                break;
+        }
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                ts_tree_cursor_delete(&cursor);
+                return count;
+            }
+        }
+    }
+}
+
+using Wanted = wxml::Preorder<wxml::symbol::element, wxml::symbol::attribute, wxml::symbol::interpolation>;
+
+size_t walk_preorder(Wanted &preorder, TSNode root) {
+    size_t count = 0;
+    preorder.reset(root);
+    TSNode node;
+    while (preorder.next(node)) {
+        count++;
+    }
+    return count;
+}
+
+template <typename Walk> double measure(const char *name, int iterations, size_t expected, Walk walk) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        if (walk() != expected) {
+            std::fprintf(stderr, "%s found a different number of nodes\n", name);
+            std::exit(1);
+        }
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    double per_walk = elapsed.count() / iterations;
+    std::printf("%-10s %10.1f us/walk\n", name, per_walk);
+    return per_walk;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int rows = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    std::string source = page(rows);
+    wxml::Parser parser;
+    wxml::Tree tree = parser.parse(source);
+    TSNode root = tree.root();
+    Wanted preorder(root);
+
+    size_t expected = walk_by_id(root);
+    std::printf("%zu bytes, %u nodes, %zu wanted\n", source.size(), ts_node_descendant_count(root), expected);
+    double by_name = measure("by name", iterations, expected, [&] { return walk_by_name(root); });
+    double by_id = measure("by id", iterations, expected, [&] { return walk_by_id(root); });
+    double filtered = measure("preorder", iterations, expected, [&] { return walk_preorder(preorder, root); });
+    std::printf("preorder is %.2fx faster than by name, %.2fx faster than by id\n", by_name / filtered,
+                by_id / filtered);
+    return 0;
+}
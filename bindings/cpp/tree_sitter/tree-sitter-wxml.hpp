@@ -0,0 +1,238 @@
+#ifndef TREE_SITTER_WXML_HPP_
+#define TREE_SITTER_WXML_HPP_
+
+#include <tree_sitter/api.h>
+#include <tree_sitter/tree-sitter-wxml-preorder.h>
+#include <tree_sitter/tree-sitter-wxml-symbols.h>
+#include <tree_sitter/tree-sitter-wxml.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <string_view>
+#include <utility>
+
+namespace wxml {
+
+// Public ids of the named node kinds, as returned by ts_node_symbol.
+namespace symbol {
+#define TREE_SITTER_WXML_SYMBOL_CONSTANT(name, id) inline constexpr TSSymbol name = id;
+TREE_SITTER_WXML_NAMED_SYMBOLS(TREE_SITTER_WXML_SYMBOL_CONSTANT)
+#undef TREE_SITTER_WXML_SYMBOL_CONSTANT
+
+inline constexpr TSSymbol error = TS_WXML_SYM_ERROR;
+} // namespace symbol
+
+// Field ids, as accepted by ts_node_child_by_field_id.
+namespace field {
+#define TREE_SITTER_WXML_FIELD_CONSTANT(name, id) inline constexpr TSFieldId name = id;
+TREE_SITTER_WXML_FIELDS(TREE_SITTER_WXML_FIELD_CONSTANT)
+#undef TREE_SITTER_WXML_FIELD_CONSTANT
+} // namespace field
+
+// An owned syntax tree.
+class Tree {
+  public:
+    Tree() noexcept = default;
+    explicit Tree(TSTree *tree) noexcept : tree_(tree) {}
+    Tree(Tree &&other) noexcept : tree_(std::exchange(other.tree_, nullptr)) {}
+    Tree &operator=(Tree &&other) noexcept {
+        std::swap(tree_, other.tree_);
+        return *this;
+    }
+    Tree(const Tree &) = delete;
+    Tree &operator=(const Tree &) = delete;
+    ~Tree() {
+        if (tree_ != nullptr) {
+            ts_tree_delete(tree_);
+        }
+    }
+
+    // A shallow copy that can be used from another thread.
+    Tree copy() const { return Tree(ts_tree_copy(tree_)); }
+
+    void edit(const TSInputEdit &edit) { ts_tree_edit(tree_, &edit); }
+
+    TSNode root() const { return ts_tree_root_node(tree_); }
+    TSTree *get() const noexcept { return tree_; }
+    TSTree *release() noexcept { return std::exchange(tree_, nullptr); }
+    explicit operator bool() const noexcept { return tree_ != nullptr; }
+
+  private:
+    TSTree *tree_ = nullptr;
+};
+
+// An owned parser, already set to the WXML language.
+class Parser {
+  public:
+    Parser() : parser_(ts_parser_new()) {
+        if (parser_ == nullptr) {
+            throw std::bad_alloc();
+        }
+        ts_parser_set_language(parser_, tree_sitter_wxml());
+    }
+    Parser(Parser &&other) noexcept : parser_(std::exchange(other.parser_, nullptr)) {}
+    Parser &operator=(Parser &&other) noexcept {
+        std::swap(parser_, other.parser_);
+        return *this;
+    }
+    Parser(const Parser &) = delete;
+    Parser &operator=(const Parser &) = delete;
+    ~Parser() {
+        if (parser_ != nullptr) {
+            ts_parser_delete(parser_);
+        }
+    }
+
+    // Parse `source`, reusing the unchanged parts of an edited `old_tree`.
+    // The returned tree is empty if parsing was cancelled.
+    Tree parse(std::string_view source, const Tree *old_tree = nullptr) {
+        return Tree(ts_parser_parse_string(parser_, old_tree != nullptr ? old_tree->get() : nullptr,
+                                           source.data(), static_cast<uint32_t>(source.size())));
+    }
+
+    void reset() { ts_parser_reset(parser_); }
+    TSParser *get() const noexcept { return parser_; }
+
+  private:
+    TSParser *parser_ = nullptr;
+};
+
+// A preorder tree walk that dispatches on node kind at compile time.
+//
+// Derive with CRTP and define public `bool visit_<kind>(TSNode)` hooks,
+// returning false to skip the node's children, and `void
+// leave_<kind>(TSNode)` hooks. `visit_node` and `leave_node` run for every
+// node before the kind-specific hook. Hooks that are not defined fall back
+// to the empty inline defaults below and compile away.
+template <typename Derived> class Visitor {
+  public:
+    void walk(const Tree &tree) { walk(tree.root()); }
+
+    void walk(TSNode root) {
+        TSTreeCursor cursor = ts_tree_cursor_new(root);
+        for (;;) {
+            TSNode node = ts_tree_cursor_current_node(&cursor);
+            if (enter(node) && ts_tree_cursor_goto_first_child(&cursor)) {
+                continue;
+            }
+            leave(node);
+            while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+                if (!ts_tree_cursor_goto_parent(&cursor)) {
+                    ts_tree_cursor_delete(&cursor);
+                    return;
+                }
+                leave(ts_tree_cursor_current_node(&cursor));
+            }
+        }
+    }
+
+    bool visit_node(TSNode) { return true; }
+    void leave_node(TSNode) {}
+    bool visit_error(TSNode) { return true; }
+    void leave_error(TSNode) {}
+
+#define TREE_SITTER_WXML_VISITOR_HOOKS(name, id)                                                   \
+    bool visit_##name(TSNode) { return true; }                                                     \
+    void leave_##name(TSNode) {}
+    TREE_SITTER_WXML_NAMED_SYMBOLS(TREE_SITTER_WXML_VISITOR_HOOKS)
+#undef TREE_SITTER_WXML_VISITOR_HOOKS
+
+  private:
+    Derived &self() { return static_cast<Derived &>(*this); }
+
+    bool enter(TSNode node) {
+        if (!self().visit_node(node)) {
+            return false;
+        }
+        switch (ts_node_symbol(node)) {
+#define TREE_SITTER_WXML_VISIT_CASE(name, id)                                                      \
+    case symbol::name:                                                                             \
+        return self().visit_##name(node);
+            TREE_SITTER_WXML_NAMED_SYMBOLS(TREE_SITTER_WXML_VISIT_CASE)
+#undef TREE_SITTER_WXML_VISIT_CASE
+            case symbol::error:
+                return self().visit_error(node);
+            default:
+                return true;
+        }
+    }
+
+    void leave(TSNode node) {
+        switch (ts_node_symbol(node)) {
+#define TREE_SITTER_WXML_LEAVE_CASE(name, id)                                                      \
+    case symbol::name:                                                                             \
+        self().leave_##name(node);                                                                 \
+        break;
+            TREE_SITTER_WXML_NAMED_SYMBOLS(TREE_SITTER_WXML_LEAVE_CASE)
+#undef TREE_SITTER_WXML_LEAVE_CASE
+            case symbol::error:
+                self().leave_error(node);
+                break;
+            default:
+                break;
+        }
+        self().leave_node(node);
+    }
+};
+
+// A bitset of node kinds, built at compile time.
+template <TSSymbol... Kinds> inline constexpr uint64_t kinds = (uint64_t{0} | ... | TS_WXML_KIND_BIT(Kinds));
+
+// A preorder range over the nodes of the given kinds, skipping subtrees that
+// cannot contain any of them. See tree-sitter-wxml-preorder.h.
+//
+//     for (TSNode node : wxml::Preorder<wxml::symbol::element>(tree.root())) { ... }
+template <TSSymbol... Kinds> class Preorder {
+    static_assert(((Kinds < 64) && ...), "Preorder only tracks kinds with ids below 64");
+    static constexpr uint64_t wanted = kinds<Kinds...>;
+
+  public:
+    class iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = TSNode;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const TSNode *;
+        using reference = const TSNode &;
+
+        iterator() noexcept = default;
+        explicit iterator(wxml_preorder *it) : it_(it) { ++*this; }
+
+        reference operator*() const noexcept { return node_; }
+        pointer operator->() const noexcept { return &node_; }
+        iterator &operator++() {
+            if (!wxml_preorder_next_kinds(it_, wanted, &node_)) {
+                it_ = nullptr;
+            }
+            return *this;
+        }
+        bool operator==(const iterator &other) const noexcept { return it_ == other.it_; }
+        bool operator!=(const iterator &other) const noexcept { return it_ != other.it_; }
+
+      private:
+        wxml_preorder *it_ = nullptr;
+        TSNode node_{};
+    };
+
+    explicit Preorder(TSNode root) : it_(wxml_preorder_new(root, wanted)) {}
+    Preorder(const Preorder &) = delete;
+    Preorder &operator=(const Preorder &) = delete;
+    ~Preorder() { wxml_preorder_delete(&it_); }
+
+    // Restart at `root`, keeping the cursor's stack.
+    void reset(TSNode root) { wxml_preorder_reset(&it_, root); }
+
+    bool next(TSNode &node) { return wxml_preorder_next_kinds(&it_, wanted, &node); }
+
+    iterator begin() { return iterator(&it_); }
+    iterator end() noexcept { return iterator(); }
+
+  private:
+    wxml_preorder it_;
+};
+
+} // namespace wxml
+
+#endif // TREE_SITTER_WXML_HPP_
@@ -0,0 +1,45 @@
+// Package ast provides typed wrappers and integer kind ids for WXML nodes,
+// so traversals can switch on Node.KindId instead of comparing Node.Kind
+// strings.
+//
+// The kind ids are constants generated from src/parser.c and
+// src/node-types.json; run go generate after regenerating the parser.
+package ast
+
+//go:generate go run gen.go
+
+import tree_sitter "github.com/tree-sitter/go-tree-sitter"
+
+// KindError is the kind id of ERROR nodes.
+const KindError uint16 = 0xFFFF
+
+// firstChild returns the first child of node with the given kind, or nil.
+func firstChild(node *tree_sitter.Node, kind uint16) *tree_sitter.Node {
+	var found *tree_sitter.Node
+	eachChild(node, kind, func(child *tree_sitter.Node) bool {
+		found = child
+		return false
+	})
+	return found
+}
+
+// eachChild calls fn with every child of node with the given kind until fn
+// returns false.
+func eachChild(node *tree_sitter.Node, kind uint16, fn func(*tree_sitter.Node) bool) {
+	if node == nil {
+		return
+	}
+	cursor := node.Walk()
+	defer cursor.Close()
+	if !cursor.GotoFirstChild() {
+		return
+	}
+	for {
+		if child := cursor.Node(); child.KindId() == kind && !fn(child) {
+			return
+		}
+		if !cursor.GotoNextSibling() {
+			return
+		}
+	}
+}
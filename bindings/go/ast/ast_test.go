@@ -0,0 +1,63 @@
+package ast_test
+
+import (
+	"testing"
+
+	tree_sitter "github.com/tree-sitter/go-tree-sitter"
+	tree_sitter_wxml "github.com/blocklune/tree-sitter-wxml/bindings/go"
+	"github.com/blocklune/tree-sitter-wxml/bindings/go/ast"
+)
+
+func TestKindIdsMatchLanguage(t *testing.T) {
+	language := tree_sitter.NewLanguage(tree_sitter_wxml.Language())
+	kinds := map[string]uint16{
+		"document":         ast.KindDocument,
+		"element":          ast.KindElement,
+		"start_tag":        ast.KindStartTag,
+		"attribute":        ast.KindAttribute,
+		"interpolation":    ast.KindInterpolation,
+		"expression":       ast.KindExpression,
+		"tag_name":         ast.KindTagName,
+		"import_statement": ast.KindImportStatement,
+	}
+	for kind, id := range kinds {
+		if got := language.IdForNodeKind(kind, true); got != id {
+			t.Errorf("%s: generated id %d, language has %d", kind, id, got)
+		}
+	}
+}
+
+func TestTypedAccessors(t *testing.T) {
+	source := []byte(`<view class="a" hidden="{{ x }}"><text>hi</text></view>`)
+	parser := tree_sitter.NewParser()
+	defer parser.Close()
+	parser.SetLanguage(tree_sitter.NewLanguage(tree_sitter_wxml.Language()))
+	tree := parser.Parse(source, nil)
+	defer tree.Close()
+
+	document, ok := ast.AsDocument(tree.RootNode())
+	if !ok {
+		t.Fatal("root is not a document")
+	}
+	element, ok := document.Element()
+	if !ok {
+		t.Fatal("document has no element")
+	}
+	startTag, ok := element.StartTag()
+	if !ok {
+		t.Fatal("element has no start tag")
+	}
+	var names []string
+	startTag.EachAttribute(func(attribute ast.Attribute) bool {
+		if name, ok := attribute.AttributeName(); ok {
+			names = append(names, name.Utf8Text(source))
+		}
+		return true
+	})
+	if len(names) != 2 || names[0] != "class" || names[1] != "hidden" {
+		t.Errorf("unexpected attribute names %q", names)
+	}
+	if _, ok := ast.AsElement(startTag.Node); ok {
+		t.Error("a start tag was cast to an element")
+	}
+}
@@ -0,0 +1,240 @@
+//go:build ignore
+
+// gen.go writes nodes.go, the kind and field ids and typed node wrappers of
+// package ast. Kinds and their children come from node-types.json; ids are
+// resolved from the symbol tables in parser.c, the same way
+// ts_language_symbol_for_name resolves them at runtime.
+package main
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/json"
+	"fmt"
+	"go/format"
+	"log"
+	"os"
+	"sort"
+	"strconv"
+	"strings"
+)
+
+type symbol struct {
+	name    string
+	visible bool
+	named   bool
+	public  int
+}
+
+type nodeType struct {
+	Type     string               `json:"type"`
+	Named    bool                 `json:"named"`
+	Fields   map[string]childInfo `json:"fields"`
+	Children *childInfo           `json:"children"`
+}
+
+type childInfo struct {
+	Multiple bool `json:"multiple"`
+	Types    []struct {
+		Type  string `json:"type"`
+		Named bool   `json:"named"`
+	} `json:"types"`
+}
+
+func main() {
+	parser, err := os.ReadFile("../../../src/parser.c")
+	if err != nil {
+		log.Fatal(err)
+	}
+	data, err := os.ReadFile("../../../src/node-types.json")
+	if err != nil {
+		log.Fatal(err)
+	}
+	var nodeTypes []nodeType
+	if err := json.Unmarshal(data, &nodeTypes); err != nil {
+		log.Fatal(err)
+	}
+
+	symbols := readSymbols(string(parser))
+	kindID := func(name string) int {
+		for _, s := range symbols {
+			if s.visible && s.named && s.name == name {
+				return s.public
+			}
+		}
+		log.Fatalf("no symbol for node kind %q", name)
+		return 0
+	}
+	fields := readFields(string(parser))
+
+	var b bytes.Buffer
+	b.WriteString("// Code generated by gen.go from node-types.json and parser.c. DO NOT EDIT.\n\n")
+	b.WriteString("package ast\n\n")
+	b.WriteString("import tree_sitter \"github.com/tree-sitter/go-tree-sitter\"\n\n")
+	b.WriteString("// Kind ids of the named node kinds, as returned by Node.KindId.\nconst (\n")
+	for _, t := range nodeTypes {
+		if t.Named {
+			fmt.Fprintf(&b, "\tKind%s uint16 = %d\n", typeName(t.Type), kindID(t.Type))
+		}
+	}
+	b.WriteString(")\n")
+	if len(fields) > 0 {
+		b.WriteString("\n// Field ids, as accepted by Node.ChildByFieldId.\nconst (\n")
+		for _, f := range fields {
+			fmt.Fprintf(&b, "\tField%s uint16 = %d\n", typeName(f.name), f.id)
+		}
+		b.WriteString(")\n")
+	}
+
+	for _, t := range nodeTypes {
+		if !t.Named {
+			continue
+		}
+		ty := typeName(t.Type)
+		fmt.Fprintf(&b, "\n// %s is a typed %s node.\ntype %s struct{ *tree_sitter.Node }\n", ty, t.Type, ty)
+		fmt.Fprintf(&b, "\n// As%s returns node as a %s if it has that kind.\n", ty, ty)
+		fmt.Fprintf(&b, "func As%s(node *tree_sitter.Node) (%s, bool) {\n", ty, ty)
+		fmt.Fprintf(&b, "\treturn %s{node}, node != nil && node.KindId() == Kind%s\n}\n", ty, ty)
+
+		for _, name := range sortedKeys(t.Fields) {
+			fmt.Fprintf(&b, "\n// %s returns the %s field.\n", typeName(name), name)
+			fmt.Fprintf(&b, "func (n %s) %s() *tree_sitter.Node {\n", ty, typeName(name))
+			fmt.Fprintf(&b, "\treturn n.ChildByFieldId(Field%s)\n}\n", typeName(name))
+		}
+		if t.Children == nil {
+			continue
+		}
+		for _, child := range t.Children.Types {
+			if !child.Named {
+				continue
+			}
+			cty := typeName(child.Type)
+			fmt.Fprintf(&b, "\n// %s returns the first %s child.\n", cty, child.Type)
+			fmt.Fprintf(&b, "func (n %s) %s() (%s, bool) {\n", ty, cty, cty)
+			fmt.Fprintf(&b, "\treturn As%s(firstChild(n.Node, Kind%s))\n}\n", cty, cty)
+			if t.Children.Multiple {
+				fmt.Fprintf(&b, "\n// Each%s calls fn with every %s child until fn returns false.\n", cty, child.Type)
+				fmt.Fprintf(&b, "func (n %s) Each%s(fn func(%s) bool) {\n", ty, cty, cty)
+				fmt.Fprintf(&b, "\teachChild(n.Node, Kind%s, func(child *tree_sitter.Node) bool { return fn(%s{child}) })\n}\n", cty, cty)
+			}
+		}
+	}
+
+	source, err := format.Source(b.Bytes())
+	if err != nil {
+		log.Fatal(err)
+	}
+	if err := os.WriteFile("nodes.go", source, 0o644); err != nil {
+		log.Fatal(err)
+	}
+}
+
+// readSymbols reads the symbol names, metadata and public symbol map from
+// parser.c, indexed by symbol id.
+func readSymbols(parser string) []symbol {
+	ids := map[string]int{"ts_builtin_sym_end": 0}
+	for _, line := range section(parser, "enum ts_symbol_identifiers {") {
+		if name, id, ok := strings.Cut(strings.TrimSuffix(strings.TrimSpace(line), ","), " = "); ok {
+			ids[name] = atoi(id)
+		}
+	}
+	symbols := make([]symbol, len(ids))
+	entry := func(line string) (int, string, bool) {
+		key, value, ok := strings.Cut(strings.TrimSpace(line), "] = ")
+		if !ok {
+			return 0, "", false
+		}
+		return ids[strings.TrimPrefix(key, "[")], strings.TrimSuffix(value, ","), true
+	}
+	for _, line := range section(parser, "ts_symbol_names[] = {") {
+		if id, value, ok := entry(line); ok {
+			name, err := strconv.Unquote(value)
+			if err != nil {
+				log.Fatalf("invalid symbol name %s", value)
+			}
+			symbols[id].name = name
+		}
+	}
+	for _, line := range section(parser, "ts_symbol_map[] = {") {
+		if id, value, ok := entry(line); ok {
+			symbols[id].public = ids[value]
+		}
+	}
+	current := 0
+	for _, line := range section(parser, "ts_symbol_metadata[] = {") {
+		line = strings.TrimSpace(line)
+		if id, _, ok := entry(line); ok {
+			current = id
+		} else if value, ok := strings.CutPrefix(line, ".visible = "); ok {
+			symbols[current].visible = strings.HasPrefix(value, "true")
+		} else if value, ok := strings.CutPrefix(line, ".named = "); ok {
+			symbols[current].named = strings.HasPrefix(value, "true")
+		}
+	}
+	return symbols
+}
+
+type field struct {
+	name string
+	id   int
+}
+
+// readFields reads the field ids from parser.c. Grammars without fields
+// have no field enum.
+func readFields(parser string) []field {
+	var fields []field
+	for _, line := range section(parser, "enum ts_field_identifiers {") {
+		if name, id, ok := strings.Cut(strings.TrimSuffix(strings.TrimSpace(line), ","), " = "); ok {
+			fields = append(fields, field{strings.TrimPrefix(name, "field_"), atoi(id)})
+		}
+	}
+	return fields
+}
+
+// section returns the lines of the top-level block opened by the line
+// containing header.
+func section(source, header string) []string {
+	var lines []string
+	inside := false
+	scanner := bufio.NewScanner(strings.NewReader(source))
+	scanner.Buffer(nil, 1<<20)
+	for scanner.Scan() {
+		line := scanner.Text()
+		switch {
+		case !inside:
+			inside = strings.Contains(line, header)
+		case line == "};":
+			return lines
+		default:
+			lines = append(lines, line)
+		}
+	}
+	return lines
+}
+
+func atoi(s string) int {
+	n, err := strconv.Atoi(s)
+	if err != nil {
+		log.Fatalf("invalid id %q", s)
+	}
+	return n
+}
+
+func typeName(kind string) string {
+	var b strings.Builder
+	for _, part := range strings.Split(kind, "_") {
+		if part != "" {
+			b.WriteString(strings.ToUpper(part[:1]) + part[1:])
+		}
+	}
+	return b.String()
+}
+
+func sortedKeys(m map[string]childInfo) []string {
+	keys := make([]string, 0, len(m))
+	for key := range m {
+		keys = append(keys, key)
+	}
+	sort.Strings(keys)
+	return keys
+}
@@ -0,0 +1,1192 @@
+// Code generated by gen.go from node-types.json and parser.c. DO NOT EDIT.
+
+package ast
+
+import tree_sitter "github.com/tree-sitter/go-tree-sitter"
+
+// Kind ids of the named node kinds, as returned by Node.KindId.
+const (
+	KindAttribute            uint16 = 35
+	KindBlockElement         uint16 = 48
+	KindBlockEndTag          uint16 = 51
+	KindBlockStartTag        uint16 = 50
+	KindDocument             uint16 = 29
+	KindElement              uint16 = 31
+	KindEndTag               uint16 = 34
+	KindExpression           uint16 = 58
+	KindImportStatement      uint16 = 40
+	KindIncludeStatement     uint16 = 41
+	KindInterpolation        uint16 = 37
+	KindQuotedAttributeValue uint16 = 36
+	KindSelfClosingTag       uint16 = 33
+	KindSlotElement          uint16 = 45
+	KindSlotEndTag           uint16 = 47
+	KindSlotStartTag         uint16 = 46
+	KindStartTag             uint16 = 32
+	KindTemplateElement      uint16 = 42
+	KindTemplateEndTag       uint16 = 44
+	KindTemplateStartTag     uint16 = 43
+	KindWxsElement           uint16 = 49
+	KindWxsEndTag            uint16 = 53
+	KindWxsStartTag          uint16 = 52
+	KindAttributeName        uint16 = 10
+	KindAttributeValue       uint16 = 11
+	KindComment              uint16 = 26
+	KindEntity               uint16 = 12
+	KindInterpolationEnd     uint16 = 28
+	KindInterpolationStart   uint16 = 27
+	KindRawText              uint16 = 25
+	KindTagName              uint16 = 23
+	KindText                 uint16 = 17
+)
+
+// Attribute is a typed attribute node.
+type Attribute struct{ *tree_sitter.Node }
+
+// AsAttribute returns node as a Attribute if it has that kind.
+func AsAttribute(node *tree_sitter.Node) (Attribute, bool) {
+	return Attribute{node}, node != nil && node.KindId() == KindAttribute
+}
+
+// AttributeName returns the first attribute_name child.
+func (n Attribute) AttributeName() (AttributeName, bool) {
+	return AsAttributeName(firstChild(n.Node, KindAttributeName))
+}
+
+// EachAttributeName calls fn with every attribute_name child until fn returns false.
+func (n Attribute) EachAttributeName(fn func(AttributeName) bool) {
+	eachChild(n.Node, KindAttributeName, func(child *tree_sitter.Node) bool { return fn(AttributeName{child}) })
+}
+
+// AttributeValue returns the first attribute_value child.
+func (n Attribute) AttributeValue() (AttributeValue, bool) {
+	return AsAttributeValue(firstChild(n.Node, KindAttributeValue))
+}
+
+// EachAttributeValue calls fn with every attribute_value child until fn returns false.
+func (n Attribute) EachAttributeValue(fn func(AttributeValue) bool) {
+	eachChild(n.Node, KindAttributeValue, func(child *tree_sitter.Node) bool { return fn(AttributeValue{child}) })
+}
+
+// QuotedAttributeValue returns the first quoted_attribute_value child.
+func (n Attribute) QuotedAttributeValue() (QuotedAttributeValue, bool) {
+	return AsQuotedAttributeValue(firstChild(n.Node, KindQuotedAttributeValue))
+}
+
+// EachQuotedAttributeValue calls fn with every quoted_attribute_value child until fn returns false.
+func (n Attribute) EachQuotedAttributeValue(fn func(QuotedAttributeValue) bool) {
+	eachChild(n.Node, KindQuotedAttributeValue, func(child *tree_sitter.Node) bool { return fn(QuotedAttributeValue{child}) })
+}
+
+// BlockElement is a typed block_element node.
+type BlockElement struct{ *tree_sitter.Node }
+
+// AsBlockElement returns node as a BlockElement if it has that kind.
+func AsBlockElement(node *tree_sitter.Node) (BlockElement, bool) {
+	return BlockElement{node}, node != nil && node.KindId() == KindBlockElement
+}
+
+// BlockElement returns the first block_element child.
+func (n BlockElement) BlockElement() (BlockElement, bool) {
+	return AsBlockElement(firstChild(n.Node, KindBlockElement))
+}
+
+// EachBlockElement calls fn with every block_element child until fn returns false.
+func (n BlockElement) EachBlockElement(fn func(BlockElement) bool) {
+	eachChild(n.Node, KindBlockElement, func(child *tree_sitter.Node) bool { return fn(BlockElement{child}) })
+}
+
+// BlockEndTag returns the first block_end_tag child.
+func (n BlockElement) BlockEndTag() (BlockEndTag, bool) {
+	return AsBlockEndTag(firstChild(n.Node, KindBlockEndTag))
+}
+
+// EachBlockEndTag calls fn with every block_end_tag child until fn returns false.
+func (n BlockElement) EachBlockEndTag(fn func(BlockEndTag) bool) {
+	eachChild(n.Node, KindBlockEndTag, func(child *tree_sitter.Node) bool { return fn(BlockEndTag{child}) })
+}
+
+// BlockStartTag returns the first block_start_tag child.
+func (n BlockElement) BlockStartTag() (BlockStartTag, bool) {
+	return AsBlockStartTag(firstChild(n.Node, KindBlockStartTag))
+}
+
+// EachBlockStartTag calls fn with every block_start_tag child until fn returns false.
+func (n BlockElement) EachBlockStartTag(fn func(BlockStartTag) bool) {
+	eachChild(n.Node, KindBlockStartTag, func(child *tree_sitter.Node) bool { return fn(BlockStartTag{child}) })
+}
+
+// Element returns the first element child.
+func (n BlockElement) Element() (Element, bool) {
+	return AsElement(firstChild(n.Node, KindElement))
+}
+
+// EachElement calls fn with every element child until fn returns false.
+func (n BlockElement) EachElement(fn func(Element) bool) {
+	eachChild(n.Node, KindElement, func(child *tree_sitter.Node) bool { return fn(Element{child}) })
+}
+
+// Entity returns the first entity child.
+func (n BlockElement) Entity() (Entity, bool) {
+	return AsEntity(firstChild(n.Node, KindEntity))
+}
+
+// EachEntity calls fn with every entity child until fn returns false.
+func (n BlockElement) EachEntity(fn func(Entity) bool) {
+	eachChild(n.Node, KindEntity, func(child *tree_sitter.Node) bool { return fn(Entity{child}) })
+}
+
+// ImportStatement returns the first import_statement child.
+func (n BlockElement) ImportStatement() (ImportStatement, bool) {
+	return AsImportStatement(firstChild(n.Node, KindImportStatement))
+}
+
+// EachImportStatement calls fn with every import_statement child until fn returns false.
+func (n BlockElement) EachImportStatement(fn func(ImportStatement) bool) {
+	eachChild(n.Node, KindImportStatement, func(child *tree_sitter.Node) bool { return fn(ImportStatement{child}) })
+}
+
+// IncludeStatement returns the first include_statement child.
+func (n BlockElement) IncludeStatement() (IncludeStatement, bool) {
+	return AsIncludeStatement(firstChild(n.Node, KindIncludeStatement))
+}
+
+// EachIncludeStatement calls fn with every include_statement child until fn returns false.
+func (n BlockElement) EachIncludeStatement(fn func(IncludeStatement) bool) {
+	eachChild(n.Node, KindIncludeStatement, func(child *tree_sitter.Node) bool { return fn(IncludeStatement{child}) })
+}
+
+// Interpolation returns the first interpolation child.
+func (n BlockElement) Interpolation() (Interpolation, bool) {
+	return AsInterpolation(firstChild(n.Node, KindInterpolation))
+}
+
+// EachInterpolation calls fn with every interpolation child until fn returns false.
+func (n BlockElement) EachInterpolation(fn func(Interpolation) bool) {
+	eachChild(n.Node, KindInterpolation, func(child *tree_sitter.Node) bool { return fn(Interpolation{child}) })
+}
+
+// SlotElement returns the first slot_element child.
+func (n BlockElement) SlotElement() (SlotElement, bool) {
+	return AsSlotElement(firstChild(n.Node, KindSlotElement))
+}
+
+// EachSlotElement calls fn with every slot_element child until fn returns false.
+func (n BlockElement) EachSlotElement(fn func(SlotElement) bool) {
+	eachChild(n.Node, KindSlotElement, func(child *tree_sitter.Node) bool { return fn(SlotElement{child}) })
+}
+
+// TemplateElement returns the first template_element child.
+func (n BlockElement) TemplateElement() (TemplateElement, bool) {
+	return AsTemplateElement(firstChild(n.Node, KindTemplateElement))
+}
+
+// EachTemplateElement calls fn with every template_element child until fn returns false.
+func (n BlockElement) EachTemplateElement(fn func(TemplateElement) bool) {
+	eachChild(n.Node, KindTemplateElement, func(child *tree_sitter.Node) bool { return fn(TemplateElement{child}) })
+}
+
+// Text returns the first text child.
+func (n BlockElement) Text() (Text, bool) {
+	return AsText(firstChild(n.Node, KindText))
+}
+
+// EachText calls fn with every text child until fn returns false.
+func (n BlockElement) EachText(fn func(Text) bool) {
+	eachChild(n.Node, KindText, func(child *tree_sitter.Node) bool { return fn(Text{child}) })
+}
+
+// WxsElement returns the first wxs_element child.
+func (n BlockElement) WxsElement() (WxsElement, bool) {
+	return AsWxsElement(firstChild(n.Node, KindWxsElement))
+}
+
+// EachWxsElement calls fn with every wxs_element child until fn returns false.
+func (n BlockElement) EachWxsElement(fn func(WxsElement) bool) {
+	eachChild(n.Node, KindWxsElement, func(child *tree_sitter.Node) bool { return fn(WxsElement{child}) })
+}
+
+// BlockEndTag is a typed block_end_tag node.
+type BlockEndTag struct{ *tree_sitter.Node }
+
+// AsBlockEndTag returns node as a BlockEndTag if it has that kind.
+func AsBlockEndTag(node *tree_sitter.Node) (BlockEndTag, bool) {
+	return BlockEndTag{node}, node != nil && node.KindId() == KindBlockEndTag
+}
+
+// TagName returns the first tag_name child.
+func (n BlockEndTag) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// BlockStartTag is a typed block_start_tag node.
+type BlockStartTag struct{ *tree_sitter.Node }
+
+// AsBlockStartTag returns node as a BlockStartTag if it has that kind.
+func AsBlockStartTag(node *tree_sitter.Node) (BlockStartTag, bool) {
+	return BlockStartTag{node}, node != nil && node.KindId() == KindBlockStartTag
+}
+
+// Attribute returns the first attribute child.
+func (n BlockStartTag) Attribute() (Attribute, bool) {
+	return AsAttribute(firstChild(n.Node, KindAttribute))
+}
+
+// EachAttribute calls fn with every attribute child until fn returns false.
+func (n BlockStartTag) EachAttribute(fn func(Attribute) bool) {
+	eachChild(n.Node, KindAttribute, func(child *tree_sitter.Node) bool { return fn(Attribute{child}) })
+}
+
+// TagName returns the first tag_name child.
+func (n BlockStartTag) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// EachTagName calls fn with every tag_name child until fn returns false.
+func (n BlockStartTag) EachTagName(fn func(TagName) bool) {
+	eachChild(n.Node, KindTagName, func(child *tree_sitter.Node) bool { return fn(TagName{child}) })
+}
+
+// Document is a typed document node.
+type Document struct{ *tree_sitter.Node }
+
+// AsDocument returns node as a Document if it has that kind.
+func AsDocument(node *tree_sitter.Node) (Document, bool) {
+	return Document{node}, node != nil && node.KindId() == KindDocument
+}
+
+// BlockElement returns the first block_element child.
+func (n Document) BlockElement() (BlockElement, bool) {
+	return AsBlockElement(firstChild(n.Node, KindBlockElement))
+}
+
+// EachBlockElement calls fn with every block_element child until fn returns false.
+func (n Document) EachBlockElement(fn func(BlockElement) bool) {
+	eachChild(n.Node, KindBlockElement, func(child *tree_sitter.Node) bool { return fn(BlockElement{child}) })
+}
+
+// Element returns the first element child.
+func (n Document) Element() (Element, bool) {
+	return AsElement(firstChild(n.Node, KindElement))
+}
+
+// EachElement calls fn with every element child until fn returns false.
+func (n Document) EachElement(fn func(Element) bool) {
+	eachChild(n.Node, KindElement, func(child *tree_sitter.Node) bool { return fn(Element{child}) })
+}
+
+// Entity returns the first entity child.
+func (n Document) Entity() (Entity, bool) {
+	return AsEntity(firstChild(n.Node, KindEntity))
+}
+
+// EachEntity calls fn with every entity child until fn returns false.
+func (n Document) EachEntity(fn func(Entity) bool) {
+	eachChild(n.Node, KindEntity, func(child *tree_sitter.Node) bool { return fn(Entity{child}) })
+}
+
+// ImportStatement returns the first import_statement child.
+func (n Document) ImportStatement() (ImportStatement, bool) {
+	return AsImportStatement(firstChild(n.Node, KindImportStatement))
+}
+
+// EachImportStatement calls fn with every import_statement child until fn returns false.
+func (n Document) EachImportStatement(fn func(ImportStatement) bool) {
+	eachChild(n.Node, KindImportStatement, func(child *tree_sitter.Node) bool { return fn(ImportStatement{child}) })
+}
+
+// IncludeStatement returns the first include_statement child.
+func (n Document) IncludeStatement() (IncludeStatement, bool) {
+	return AsIncludeStatement(firstChild(n.Node, KindIncludeStatement))
+}
+
+// EachIncludeStatement calls fn with every include_statement child until fn returns false.
+func (n Document) EachIncludeStatement(fn func(IncludeStatement) bool) {
+	eachChild(n.Node, KindIncludeStatement, func(child *tree_sitter.Node) bool { return fn(IncludeStatement{child}) })
+}
+
+// Interpolation returns the first interpolation child.
+func (n Document) Interpolation() (Interpolation, bool) {
+	return AsInterpolation(firstChild(n.Node, KindInterpolation))
+}
+
+// EachInterpolation calls fn with every interpolation child until fn returns false.
+func (n Document) EachInterpolation(fn func(Interpolation) bool) {
+	eachChild(n.Node, KindInterpolation, func(child *tree_sitter.Node) bool { return fn(Interpolation{child}) })
+}
+
+// SlotElement returns the first slot_element child.
+func (n Document) SlotElement() (SlotElement, bool) {
+	return AsSlotElement(firstChild(n.Node, KindSlotElement))
+}
+
+// EachSlotElement calls fn with every slot_element child until fn returns false.
+func (n Document) EachSlotElement(fn func(SlotElement) bool) {
+	eachChild(n.Node, KindSlotElement, func(child *tree_sitter.Node) bool { return fn(SlotElement{child}) })
+}
+
+// TemplateElement returns the first template_element child.
+func (n Document) TemplateElement() (TemplateElement, bool) {
+	return AsTemplateElement(firstChild(n.Node, KindTemplateElement))
+}
+
+// EachTemplateElement calls fn with every template_element child until fn returns false.
+func (n Document) EachTemplateElement(fn func(TemplateElement) bool) {
+	eachChild(n.Node, KindTemplateElement, func(child *tree_sitter.Node) bool { return fn(TemplateElement{child}) })
+}
+
+// Text returns the first text child.
+func (n Document) Text() (Text, bool) {
+	return AsText(firstChild(n.Node, KindText))
+}
+
+// EachText calls fn with every text child until fn returns false.
+func (n Document) EachText(fn func(Text) bool) {
+	eachChild(n.Node, KindText, func(child *tree_sitter.Node) bool { return fn(Text{child}) })
+}
+
+// WxsElement returns the first wxs_element child.
+func (n Document) WxsElement() (WxsElement, bool) {
+	return AsWxsElement(firstChild(n.Node, KindWxsElement))
+}
+
+// EachWxsElement calls fn with every wxs_element child until fn returns false.
+func (n Document) EachWxsElement(fn func(WxsElement) bool) {
+	eachChild(n.Node, KindWxsElement, func(child *tree_sitter.Node) bool { return fn(WxsElement{child}) })
+}
+
+// Element is a typed element node.
+type Element struct{ *tree_sitter.Node }
+
+// AsElement returns node as a Element if it has that kind.
+func AsElement(node *tree_sitter.Node) (Element, bool) {
+	return Element{node}, node != nil && node.KindId() == KindElement
+}
+
+// BlockElement returns the first block_element child.
+func (n Element) BlockElement() (BlockElement, bool) {
+	return AsBlockElement(firstChild(n.Node, KindBlockElement))
+}
+
+// EachBlockElement calls fn with every block_element child until fn returns false.
+func (n Element) EachBlockElement(fn func(BlockElement) bool) {
+	eachChild(n.Node, KindBlockElement, func(child *tree_sitter.Node) bool { return fn(BlockElement{child}) })
+}
+
+// Element returns the first element child.
+func (n Element) Element() (Element, bool) {
+	return AsElement(firstChild(n.Node, KindElement))
+}
+
+// EachElement calls fn with every element child until fn returns false.
+func (n Element) EachElement(fn func(Element) bool) {
+	eachChild(n.Node, KindElement, func(child *tree_sitter.Node) bool { return fn(Element{child}) })
+}
+
+// EndTag returns the first end_tag child.
+func (n Element) EndTag() (EndTag, bool) {
+	return AsEndTag(firstChild(n.Node, KindEndTag))
+}
+
+// EachEndTag calls fn with every end_tag child until fn returns false.
+func (n Element) EachEndTag(fn func(EndTag) bool) {
+	eachChild(n.Node, KindEndTag, func(child *tree_sitter.Node) bool { return fn(EndTag{child}) })
+}
+
+// Entity returns the first entity child.
+func (n Element) Entity() (Entity, bool) {
+	return AsEntity(firstChild(n.Node, KindEntity))
+}
+
+// EachEntity calls fn with every entity child until fn returns false.
+func (n Element) EachEntity(fn func(Entity) bool) {
+	eachChild(n.Node, KindEntity, func(child *tree_sitter.Node) bool { return fn(Entity{child}) })
+}
+
+// ImportStatement returns the first import_statement child.
+func (n Element) ImportStatement() (ImportStatement, bool) {
+	return AsImportStatement(firstChild(n.Node, KindImportStatement))
+}
+
+// EachImportStatement calls fn with every import_statement child until fn returns false.
+func (n Element) EachImportStatement(fn func(ImportStatement) bool) {
+	eachChild(n.Node, KindImportStatement, func(child *tree_sitter.Node) bool { return fn(ImportStatement{child}) })
+}
+
+// IncludeStatement returns the first include_statement child.
+func (n Element) IncludeStatement() (IncludeStatement, bool) {
+	return AsIncludeStatement(firstChild(n.Node, KindIncludeStatement))
+}
+
+// EachIncludeStatement calls fn with every include_statement child until fn returns false.
+func (n Element) EachIncludeStatement(fn func(IncludeStatement) bool) {
+	eachChild(n.Node, KindIncludeStatement, func(child *tree_sitter.Node) bool { return fn(IncludeStatement{child}) })
+}
+
+// Interpolation returns the first interpolation child.
+func (n Element) Interpolation() (Interpolation, bool) {
+	return AsInterpolation(firstChild(n.Node, KindInterpolation))
+}
+
+// EachInterpolation calls fn with every interpolation child until fn returns false.
+func (n Element) EachInterpolation(fn func(Interpolation) bool) {
+	eachChild(n.Node, KindInterpolation, func(child *tree_sitter.Node) bool { return fn(Interpolation{child}) })
+}
+
+// SelfClosingTag returns the first self_closing_tag child.
+func (n Element) SelfClosingTag() (SelfClosingTag, bool) {
+	return AsSelfClosingTag(firstChild(n.Node, KindSelfClosingTag))
+}
+
+// EachSelfClosingTag calls fn with every self_closing_tag child until fn returns false.
+func (n Element) EachSelfClosingTag(fn func(SelfClosingTag) bool) {
+	eachChild(n.Node, KindSelfClosingTag, func(child *tree_sitter.Node) bool { return fn(SelfClosingTag{child}) })
+}
+
+// SlotElement returns the first slot_element child.
+func (n Element) SlotElement() (SlotElement, bool) {
+	return AsSlotElement(firstChild(n.Node, KindSlotElement))
+}
+
+// EachSlotElement calls fn with every slot_element child until fn returns false.
+func (n Element) EachSlotElement(fn func(SlotElement) bool) {
+	eachChild(n.Node, KindSlotElement, func(child *tree_sitter.Node) bool { return fn(SlotElement{child}) })
+}
+
+// StartTag returns the first start_tag child.
+func (n Element) StartTag() (StartTag, bool) {
+	return AsStartTag(firstChild(n.Node, KindStartTag))
+}
+
+// EachStartTag calls fn with every start_tag child until fn returns false.
+func (n Element) EachStartTag(fn func(StartTag) bool) {
+	eachChild(n.Node, KindStartTag, func(child *tree_sitter.Node) bool { return fn(StartTag{child}) })
+}
+
+// TemplateElement returns the first template_element child.
+func (n Element) TemplateElement() (TemplateElement, bool) {
+	return AsTemplateElement(firstChild(n.Node, KindTemplateElement))
+}
+
+// EachTemplateElement calls fn with every template_element child until fn returns false.
+func (n Element) EachTemplateElement(fn func(TemplateElement) bool) {
+	eachChild(n.Node, KindTemplateElement, func(child *tree_sitter.Node) bool { return fn(TemplateElement{child}) })
+}
+
+// Text returns the first text child.
+func (n Element) Text() (Text, bool) {
+	return AsText(firstChild(n.Node, KindText))
+}
+
+// EachText calls fn with every text child until fn returns false.
+func (n Element) EachText(fn func(Text) bool) {
+	eachChild(n.Node, KindText, func(child *tree_sitter.Node) bool { return fn(Text{child}) })
+}
+
+// WxsElement returns the first wxs_element child.
+func (n Element) WxsElement() (WxsElement, bool) {
+	return AsWxsElement(firstChild(n.Node, KindWxsElement))
+}
+
+// EachWxsElement calls fn with every wxs_element child until fn returns false.
+func (n Element) EachWxsElement(fn func(WxsElement) bool) {
+	eachChild(n.Node, KindWxsElement, func(child *tree_sitter.Node) bool { return fn(WxsElement{child}) })
+}
+
+// EndTag is a typed end_tag node.
+type EndTag struct{ *tree_sitter.Node }
+
+// AsEndTag returns node as a EndTag if it has that kind.
+func AsEndTag(node *tree_sitter.Node) (EndTag, bool) {
+	return EndTag{node}, node != nil && node.KindId() == KindEndTag
+}
+
+// TagName returns the first tag_name child.
+func (n EndTag) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// Expression is a typed expression node.
+type Expression struct{ *tree_sitter.Node }
+
+// AsExpression returns node as a Expression if it has that kind.
+func AsExpression(node *tree_sitter.Node) (Expression, bool) {
+	return Expression{node}, node != nil && node.KindId() == KindExpression
+}
+
+// Interpolation returns the first interpolation child.
+func (n Expression) Interpolation() (Interpolation, bool) {
+	return AsInterpolation(firstChild(n.Node, KindInterpolation))
+}
+
+// EachInterpolation calls fn with every interpolation child until fn returns false.
+func (n Expression) EachInterpolation(fn func(Interpolation) bool) {
+	eachChild(n.Node, KindInterpolation, func(child *tree_sitter.Node) bool { return fn(Interpolation{child}) })
+}
+
+// ImportStatement is a typed import_statement node.
+type ImportStatement struct{ *tree_sitter.Node }
+
+// AsImportStatement returns node as a ImportStatement if it has that kind.
+func AsImportStatement(node *tree_sitter.Node) (ImportStatement, bool) {
+	return ImportStatement{node}, node != nil && node.KindId() == KindImportStatement
+}
+
+// Attribute returns the first attribute child.
+func (n ImportStatement) Attribute() (Attribute, bool) {
+	return AsAttribute(firstChild(n.Node, KindAttribute))
+}
+
+// EachAttribute calls fn with every attribute child until fn returns false.
+func (n ImportStatement) EachAttribute(fn func(Attribute) bool) {
+	eachChild(n.Node, KindAttribute, func(child *tree_sitter.Node) bool { return fn(Attribute{child}) })
+}
+
+// TagName returns the first tag_name child.
+func (n ImportStatement) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// EachTagName calls fn with every tag_name child until fn returns false.
+func (n ImportStatement) EachTagName(fn func(TagName) bool) {
+	eachChild(n.Node, KindTagName, func(child *tree_sitter.Node) bool { return fn(TagName{child}) })
+}
+
+// IncludeStatement is a typed include_statement node.
+type IncludeStatement struct{ *tree_sitter.Node }
+
+// AsIncludeStatement returns node as a IncludeStatement if it has that kind.
+func AsIncludeStatement(node *tree_sitter.Node) (IncludeStatement, bool) {
+	return IncludeStatement{node}, node != nil && node.KindId() == KindIncludeStatement
+}
+
+// Attribute returns the first attribute child.
+func (n IncludeStatement) Attribute() (Attribute, bool) {
+	return AsAttribute(firstChild(n.Node, KindAttribute))
+}
+
+// EachAttribute calls fn with every attribute child until fn returns false.
+func (n IncludeStatement) EachAttribute(fn func(Attribute) bool) {
+	eachChild(n.Node, KindAttribute, func(child *tree_sitter.Node) bool { return fn(Attribute{child}) })
+}
+
+// TagName returns the first tag_name child.
+func (n IncludeStatement) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// EachTagName calls fn with every tag_name child until fn returns false.
+func (n IncludeStatement) EachTagName(fn func(TagName) bool) {
+	eachChild(n.Node, KindTagName, func(child *tree_sitter.Node) bool { return fn(TagName{child}) })
+}
+
+// Interpolation is a typed interpolation node.
+type Interpolation struct{ *tree_sitter.Node }
+
+// AsInterpolation returns node as a Interpolation if it has that kind.
+func AsInterpolation(node *tree_sitter.Node) (Interpolation, bool) {
+	return Interpolation{node}, node != nil && node.KindId() == KindInterpolation
+}
+
+// Expression returns the first expression child.
+func (n Interpolation) Expression() (Expression, bool) {
+	return AsExpression(firstChild(n.Node, KindExpression))
+}
+
+// EachExpression calls fn with every expression child until fn returns false.
+func (n Interpolation) EachExpression(fn func(Expression) bool) {
+	eachChild(n.Node, KindExpression, func(child *tree_sitter.Node) bool { return fn(Expression{child}) })
+}
+
+// InterpolationEnd returns the first interpolation_end child.
+func (n Interpolation) InterpolationEnd() (InterpolationEnd, bool) {
+	return AsInterpolationEnd(firstChild(n.Node, KindInterpolationEnd))
+}
+
+// EachInterpolationEnd calls fn with every interpolation_end child until fn returns false.
+func (n Interpolation) EachInterpolationEnd(fn func(InterpolationEnd) bool) {
+	eachChild(n.Node, KindInterpolationEnd, func(child *tree_sitter.Node) bool { return fn(InterpolationEnd{child}) })
+}
+
+// InterpolationStart returns the first interpolation_start child.
+func (n Interpolation) InterpolationStart() (InterpolationStart, bool) {
+	return AsInterpolationStart(firstChild(n.Node, KindInterpolationStart))
+}
+
+// EachInterpolationStart calls fn with every interpolation_start child until fn returns false.
+func (n Interpolation) EachInterpolationStart(fn func(InterpolationStart) bool) {
+	eachChild(n.Node, KindInterpolationStart, func(child *tree_sitter.Node) bool { return fn(InterpolationStart{child}) })
+}
+
+// QuotedAttributeValue is a typed quoted_attribute_value node.
+type QuotedAttributeValue struct{ *tree_sitter.Node }
+
+// AsQuotedAttributeValue returns node as a QuotedAttributeValue if it has that kind.
+func AsQuotedAttributeValue(node *tree_sitter.Node) (QuotedAttributeValue, bool) {
+	return QuotedAttributeValue{node}, node != nil && node.KindId() == KindQuotedAttributeValue
+}
+
+// Entity returns the first entity child.
+func (n QuotedAttributeValue) Entity() (Entity, bool) {
+	return AsEntity(firstChild(n.Node, KindEntity))
+}
+
+// EachEntity calls fn with every entity child until fn returns false.
+func (n QuotedAttributeValue) EachEntity(fn func(Entity) bool) {
+	eachChild(n.Node, KindEntity, func(child *tree_sitter.Node) bool { return fn(Entity{child}) })
+}
+
+// Interpolation returns the first interpolation child.
+func (n QuotedAttributeValue) Interpolation() (Interpolation, bool) {
+	return AsInterpolation(firstChild(n.Node, KindInterpolation))
+}
+
+// EachInterpolation calls fn with every interpolation child until fn returns false.
+func (n QuotedAttributeValue) EachInterpolation(fn func(Interpolation) bool) {
+	eachChild(n.Node, KindInterpolation, func(child *tree_sitter.Node) bool { return fn(Interpolation{child}) })
+}
+
+// SelfClosingTag is a typed self_closing_tag node.
+type SelfClosingTag struct{ *tree_sitter.Node }
+
+// AsSelfClosingTag returns node as a SelfClosingTag if it has that kind.
+func AsSelfClosingTag(node *tree_sitter.Node) (SelfClosingTag, bool) {
+	return SelfClosingTag{node}, node != nil && node.KindId() == KindSelfClosingTag
+}
+
+// Attribute returns the first attribute child.
+func (n SelfClosingTag) Attribute() (Attribute, bool) {
+	return AsAttribute(firstChild(n.Node, KindAttribute))
+}
+
+// EachAttribute calls fn with every attribute child until fn returns false.
+func (n SelfClosingTag) EachAttribute(fn func(Attribute) bool) {
+	eachChild(n.Node, KindAttribute, func(child *tree_sitter.Node) bool { return fn(Attribute{child}) })
+}
+
+// TagName returns the first tag_name child.
+func (n SelfClosingTag) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// EachTagName calls fn with every tag_name child until fn returns false.
+func (n SelfClosingTag) EachTagName(fn func(TagName) bool) {
+	eachChild(n.Node, KindTagName, func(child *tree_sitter.Node) bool { return fn(TagName{child}) })
+}
+
+// SlotElement is a typed slot_element node.
+type SlotElement struct{ *tree_sitter.Node }
+
+// AsSlotElement returns node as a SlotElement if it has that kind.
+func AsSlotElement(node *tree_sitter.Node) (SlotElement, bool) {
+	return SlotElement{node}, node != nil && node.KindId() == KindSlotElement
+}
+
+// BlockElement returns the first block_element child.
+func (n SlotElement) BlockElement() (BlockElement, bool) {
+	return AsBlockElement(firstChild(n.Node, KindBlockElement))
+}
+
+// EachBlockElement calls fn with every block_element child until fn returns false.
+func (n SlotElement) EachBlockElement(fn func(BlockElement) bool) {
+	eachChild(n.Node, KindBlockElement, func(child *tree_sitter.Node) bool { return fn(BlockElement{child}) })
+}
+
+// Element returns the first element child.
+func (n SlotElement) Element() (Element, bool) {
+	return AsElement(firstChild(n.Node, KindElement))
+}
+
+// EachElement calls fn with every element child until fn returns false.
+func (n SlotElement) EachElement(fn func(Element) bool) {
+	eachChild(n.Node, KindElement, func(child *tree_sitter.Node) bool { return fn(Element{child}) })
+}
+
+// Entity returns the first entity child.
+func (n SlotElement) Entity() (Entity, bool) {
+	return AsEntity(firstChild(n.Node, KindEntity))
+}
+
+// EachEntity calls fn with every entity child until fn returns false.
+func (n SlotElement) EachEntity(fn func(Entity) bool) {
+	eachChild(n.Node, KindEntity, func(child *tree_sitter.Node) bool { return fn(Entity{child}) })
+}
+
+// ImportStatement returns the first import_statement child.
+func (n SlotElement) ImportStatement() (ImportStatement, bool) {
+	return AsImportStatement(firstChild(n.Node, KindImportStatement))
+}
+
+// EachImportStatement calls fn with every import_statement child until fn returns false.
+func (n SlotElement) EachImportStatement(fn func(ImportStatement) bool) {
+	eachChild(n.Node, KindImportStatement, func(child *tree_sitter.Node) bool { return fn(ImportStatement{child}) })
+}
+
+// IncludeStatement returns the first include_statement child.
+func (n SlotElement) IncludeStatement() (IncludeStatement, bool) {
+	return AsIncludeStatement(firstChild(n.Node, KindIncludeStatement))
+}
+
+// EachIncludeStatement calls fn with every include_statement child until fn returns false.
+func (n SlotElement) EachIncludeStatement(fn func(IncludeStatement) bool) {
+	eachChild(n.Node, KindIncludeStatement, func(child *tree_sitter.Node) bool { return fn(IncludeStatement{child}) })
+}
+
+// Interpolation returns the first interpolation child.
+func (n SlotElement) Interpolation() (Interpolation, bool) {
+	return AsInterpolation(firstChild(n.Node, KindInterpolation))
+}
+
+// EachInterpolation calls fn with every interpolation child until fn returns false.
+func (n SlotElement) EachInterpolation(fn func(Interpolation) bool) {
+	eachChild(n.Node, KindInterpolation, func(child *tree_sitter.Node) bool { return fn(Interpolation{child}) })
+}
+
+// SlotElement returns the first slot_element child.
+func (n SlotElement) SlotElement() (SlotElement, bool) {
+	return AsSlotElement(firstChild(n.Node, KindSlotElement))
+}
+
+// EachSlotElement calls fn with every slot_element child until fn returns false.
+func (n SlotElement) EachSlotElement(fn func(SlotElement) bool) {
+	eachChild(n.Node, KindSlotElement, func(child *tree_sitter.Node) bool { return fn(SlotElement{child}) })
+}
+
+// SlotEndTag returns the first slot_end_tag child.
+func (n SlotElement) SlotEndTag() (SlotEndTag, bool) {
+	return AsSlotEndTag(firstChild(n.Node, KindSlotEndTag))
+}
+
+// EachSlotEndTag calls fn with every slot_end_tag child until fn returns false.
+func (n SlotElement) EachSlotEndTag(fn func(SlotEndTag) bool) {
+	eachChild(n.Node, KindSlotEndTag, func(child *tree_sitter.Node) bool { return fn(SlotEndTag{child}) })
+}
+
+// SlotStartTag returns the first slot_start_tag child.
+func (n SlotElement) SlotStartTag() (SlotStartTag, bool) {
+	return AsSlotStartTag(firstChild(n.Node, KindSlotStartTag))
+}
+
+// EachSlotStartTag calls fn with every slot_start_tag child until fn returns false.
+func (n SlotElement) EachSlotStartTag(fn func(SlotStartTag) bool) {
+	eachChild(n.Node, KindSlotStartTag, func(child *tree_sitter.Node) bool { return fn(SlotStartTag{child}) })
+}
+
+// TemplateElement returns the first template_element child.
+func (n SlotElement) TemplateElement() (TemplateElement, bool) {
+	return AsTemplateElement(firstChild(n.Node, KindTemplateElement))
+}
+
+// EachTemplateElement calls fn with every template_element child until fn returns false.
+func (n SlotElement) EachTemplateElement(fn func(TemplateElement) bool) {
+	eachChild(n.Node, KindTemplateElement, func(child *tree_sitter.Node) bool { return fn(TemplateElement{child}) })
+}
+
+// Text returns the first text child.
+func (n SlotElement) Text() (Text, bool) {
+	return AsText(firstChild(n.Node, KindText))
+}
+
+// EachText calls fn with every text child until fn returns false.
+func (n SlotElement) EachText(fn func(Text) bool) {
+	eachChild(n.Node, KindText, func(child *tree_sitter.Node) bool { return fn(Text{child}) })
+}
+
+// WxsElement returns the first wxs_element child.
+func (n SlotElement) WxsElement() (WxsElement, bool) {
+	return AsWxsElement(firstChild(n.Node, KindWxsElement))
+}
+
+// EachWxsElement calls fn with every wxs_element child until fn returns false.
+func (n SlotElement) EachWxsElement(fn func(WxsElement) bool) {
+	eachChild(n.Node, KindWxsElement, func(child *tree_sitter.Node) bool { return fn(WxsElement{child}) })
+}
+
+// SlotEndTag is a typed slot_end_tag node.
+type SlotEndTag struct{ *tree_sitter.Node }
+
+// AsSlotEndTag returns node as a SlotEndTag if it has that kind.
+func AsSlotEndTag(node *tree_sitter.Node) (SlotEndTag, bool) {
+	return SlotEndTag{node}, node != nil && node.KindId() == KindSlotEndTag
+}
+
+// TagName returns the first tag_name child.
+func (n SlotEndTag) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// SlotStartTag is a typed slot_start_tag node.
+type SlotStartTag struct{ *tree_sitter.Node }
+
+// AsSlotStartTag returns node as a SlotStartTag if it has that kind.
+func AsSlotStartTag(node *tree_sitter.Node) (SlotStartTag, bool) {
+	return SlotStartTag{node}, node != nil && node.KindId() == KindSlotStartTag
+}
+
+// Attribute returns the first attribute child.
+func (n SlotStartTag) Attribute() (Attribute, bool) {
+	return AsAttribute(firstChild(n.Node, KindAttribute))
+}
+
+// EachAttribute calls fn with every attribute child until fn returns false.
+func (n SlotStartTag) EachAttribute(fn func(Attribute) bool) {
+	eachChild(n.Node, KindAttribute, func(child *tree_sitter.Node) bool { return fn(Attribute{child}) })
+}
+
+// TagName returns the first tag_name child.
+func (n SlotStartTag) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// EachTagName calls fn with every tag_name child until fn returns false.
+func (n SlotStartTag) EachTagName(fn func(TagName) bool) {
+	eachChild(n.Node, KindTagName, func(child *tree_sitter.Node) bool { return fn(TagName{child}) })
+}
+
+// StartTag is a typed start_tag node.
+type StartTag struct{ *tree_sitter.Node }
+
+// AsStartTag returns node as a StartTag if it has that kind.
+func AsStartTag(node *tree_sitter.Node) (StartTag, bool) {
+	return StartTag{node}, node != nil && node.KindId() == KindStartTag
+}
+
+// Attribute returns the first attribute child.
+func (n StartTag) Attribute() (Attribute, bool) {
+	return AsAttribute(firstChild(n.Node, KindAttribute))
+}
+
+// EachAttribute calls fn with every attribute child until fn returns false.
+func (n StartTag) EachAttribute(fn func(Attribute) bool) {
+	eachChild(n.Node, KindAttribute, func(child *tree_sitter.Node) bool { return fn(Attribute{child}) })
+}
+
+// TagName returns the first tag_name child.
+func (n StartTag) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// EachTagName calls fn with every tag_name child until fn returns false.
+func (n StartTag) EachTagName(fn func(TagName) bool) {
+	eachChild(n.Node, KindTagName, func(child *tree_sitter.Node) bool { return fn(TagName{child}) })
+}
+
+// TemplateElement is a typed template_element node.
+type TemplateElement struct{ *tree_sitter.Node }
+
+// AsTemplateElement returns node as a TemplateElement if it has that kind.
+func AsTemplateElement(node *tree_sitter.Node) (TemplateElement, bool) {
+	return TemplateElement{node}, node != nil && node.KindId() == KindTemplateElement
+}
+
+// BlockElement returns the first block_element child.
+func (n TemplateElement) BlockElement() (BlockElement, bool) {
+	return AsBlockElement(firstChild(n.Node, KindBlockElement))
+}
+
+// EachBlockElement calls fn with every block_element child until fn returns false.
+func (n TemplateElement) EachBlockElement(fn func(BlockElement) bool) {
+	eachChild(n.Node, KindBlockElement, func(child *tree_sitter.Node) bool { return fn(BlockElement{child}) })
+}
+
+// Element returns the first element child.
+func (n TemplateElement) Element() (Element, bool) {
+	return AsElement(firstChild(n.Node, KindElement))
+}
+
+// EachElement calls fn with every element child until fn returns false.
+func (n TemplateElement) EachElement(fn func(Element) bool) {
+	eachChild(n.Node, KindElement, func(child *tree_sitter.Node) bool { return fn(Element{child}) })
+}
+
+// Entity returns the first entity child.
+func (n TemplateElement) Entity() (Entity, bool) {
+	return AsEntity(firstChild(n.Node, KindEntity))
+}
+
+// EachEntity calls fn with every entity child until fn returns false.
+func (n TemplateElement) EachEntity(fn func(Entity) bool) {
+	eachChild(n.Node, KindEntity, func(child *tree_sitter.Node) bool { return fn(Entity{child}) })
+}
+
+// ImportStatement returns the first import_statement child.
+func (n TemplateElement) ImportStatement() (ImportStatement, bool) {
+	return AsImportStatement(firstChild(n.Node, KindImportStatement))
+}
+
+// EachImportStatement calls fn with every import_statement child until fn returns false.
+func (n TemplateElement) EachImportStatement(fn func(ImportStatement) bool) {
+	eachChild(n.Node, KindImportStatement, func(child *tree_sitter.Node) bool { return fn(ImportStatement{child}) })
+}
+
+// IncludeStatement returns the first include_statement child.
+func (n TemplateElement) IncludeStatement() (IncludeStatement, bool) {
+	return AsIncludeStatement(firstChild(n.Node, KindIncludeStatement))
+}
+
+// EachIncludeStatement calls fn with every include_statement child until fn returns false.
+func (n TemplateElement) EachIncludeStatement(fn func(IncludeStatement) bool) {
+	eachChild(n.Node, KindIncludeStatement, func(child *tree_sitter.Node) bool { return fn(IncludeStatement{child}) })
+}
+
+// Interpolation returns the first interpolation child.
+func (n TemplateElement) Interpolation() (Interpolation, bool) {
+	return AsInterpolation(firstChild(n.Node, KindInterpolation))
+}
+
+// EachInterpolation calls fn with every interpolation child until fn returns false.
+func (n TemplateElement) EachInterpolation(fn func(Interpolation) bool) {
+	eachChild(n.Node, KindInterpolation, func(child *tree_sitter.Node) bool { return fn(Interpolation{child}) })
+}
+
+// SlotElement returns the first slot_element child.
+func (n TemplateElement) SlotElement() (SlotElement, bool) {
+	return AsSlotElement(firstChild(n.Node, KindSlotElement))
+}
+
+// EachSlotElement calls fn with every slot_element child until fn returns false.
+func (n TemplateElement) EachSlotElement(fn func(SlotElement) bool) {
+	eachChild(n.Node, KindSlotElement, func(child *tree_sitter.Node) bool { return fn(SlotElement{child}) })
+}
+
+// TemplateElement returns the first template_element child.
+func (n TemplateElement) TemplateElement() (TemplateElement, bool) {
+	return AsTemplateElement(firstChild(n.Node, KindTemplateElement))
+}
+
+// EachTemplateElement calls fn with every template_element child until fn returns false.
+func (n TemplateElement) EachTemplateElement(fn func(TemplateElement) bool) {
+	eachChild(n.Node, KindTemplateElement, func(child *tree_sitter.Node) bool { return fn(TemplateElement{child}) })
+}
+
+// TemplateEndTag returns the first template_end_tag child.
+func (n TemplateElement) TemplateEndTag() (TemplateEndTag, bool) {
+	return AsTemplateEndTag(firstChild(n.Node, KindTemplateEndTag))
+}
+
+// EachTemplateEndTag calls fn with every template_end_tag child until fn returns false.
+func (n TemplateElement) EachTemplateEndTag(fn func(TemplateEndTag) bool) {
+	eachChild(n.Node, KindTemplateEndTag, func(child *tree_sitter.Node) bool { return fn(TemplateEndTag{child}) })
+}
+
+// TemplateStartTag returns the first template_start_tag child.
+func (n TemplateElement) TemplateStartTag() (TemplateStartTag, bool) {
+	return AsTemplateStartTag(firstChild(n.Node, KindTemplateStartTag))
+}
+
+// EachTemplateStartTag calls fn with every template_start_tag child until fn returns false.
+func (n TemplateElement) EachTemplateStartTag(fn func(TemplateStartTag) bool) {
+	eachChild(n.Node, KindTemplateStartTag, func(child *tree_sitter.Node) bool { return fn(TemplateStartTag{child}) })
+}
+
+// Text returns the first text child.
+func (n TemplateElement) Text() (Text, bool) {
+	return AsText(firstChild(n.Node, KindText))
+}
+
+// EachText calls fn with every text child until fn returns false.
+func (n TemplateElement) EachText(fn func(Text) bool) {
+	eachChild(n.Node, KindText, func(child *tree_sitter.Node) bool { return fn(Text{child}) })
+}
+
+// WxsElement returns the first wxs_element child.
+func (n TemplateElement) WxsElement() (WxsElement, bool) {
+	return AsWxsElement(firstChild(n.Node, KindWxsElement))
+}
+
+// EachWxsElement calls fn with every wxs_element child until fn returns false.
+func (n TemplateElement) EachWxsElement(fn func(WxsElement) bool) {
+	eachChild(n.Node, KindWxsElement, func(child *tree_sitter.Node) bool { return fn(WxsElement{child}) })
+}
+
+// TemplateEndTag is a typed template_end_tag node.
+type TemplateEndTag struct{ *tree_sitter.Node }
+
+// AsTemplateEndTag returns node as a TemplateEndTag if it has that kind.
+func AsTemplateEndTag(node *tree_sitter.Node) (TemplateEndTag, bool) {
+	return TemplateEndTag{node}, node != nil && node.KindId() == KindTemplateEndTag
+}
+
+// TagName returns the first tag_name child.
+func (n TemplateEndTag) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// TemplateStartTag is a typed template_start_tag node.
+type TemplateStartTag struct{ *tree_sitter.Node }
+
+// AsTemplateStartTag returns node as a TemplateStartTag if it has that kind.
+func AsTemplateStartTag(node *tree_sitter.Node) (TemplateStartTag, bool) {
+	return TemplateStartTag{node}, node != nil && node.KindId() == KindTemplateStartTag
+}
+
+// Attribute returns the first attribute child.
+func (n TemplateStartTag) Attribute() (Attribute, bool) {
+	return AsAttribute(firstChild(n.Node, KindAttribute))
+}
+
+// EachAttribute calls fn with every attribute child until fn returns false.
+func (n TemplateStartTag) EachAttribute(fn func(Attribute) bool) {
+	eachChild(n.Node, KindAttribute, func(child *tree_sitter.Node) bool { return fn(Attribute{child}) })
+}
+
+// TagName returns the first tag_name child.
+func (n TemplateStartTag) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// EachTagName calls fn with every tag_name child until fn returns false.
+func (n TemplateStartTag) EachTagName(fn func(TagName) bool) {
+	eachChild(n.Node, KindTagName, func(child *tree_sitter.Node) bool { return fn(TagName{child}) })
+}
+
+// WxsElement is a typed wxs_element node.
+type WxsElement struct{ *tree_sitter.Node }
+
+// AsWxsElement returns node as a WxsElement if it has that kind.
+func AsWxsElement(node *tree_sitter.Node) (WxsElement, bool) {
+	return WxsElement{node}, node != nil && node.KindId() == KindWxsElement
+}
+
+// RawText returns the first raw_text child.
+func (n WxsElement) RawText() (RawText, bool) {
+	return AsRawText(firstChild(n.Node, KindRawText))
+}
+
+// EachRawText calls fn with every raw_text child until fn returns false.
+func (n WxsElement) EachRawText(fn func(RawText) bool) {
+	eachChild(n.Node, KindRawText, func(child *tree_sitter.Node) bool { return fn(RawText{child}) })
+}
+
+// WxsEndTag returns the first wxs_end_tag child.
+func (n WxsElement) WxsEndTag() (WxsEndTag, bool) {
+	return AsWxsEndTag(firstChild(n.Node, KindWxsEndTag))
+}
+
+// EachWxsEndTag calls fn with every wxs_end_tag child until fn returns false.
+func (n WxsElement) EachWxsEndTag(fn func(WxsEndTag) bool) {
+	eachChild(n.Node, KindWxsEndTag, func(child *tree_sitter.Node) bool { return fn(WxsEndTag{child}) })
+}
+
+// WxsStartTag returns the first wxs_start_tag child.
+func (n WxsElement) WxsStartTag() (WxsStartTag, bool) {
+	return AsWxsStartTag(firstChild(n.Node, KindWxsStartTag))
+}
+
+// EachWxsStartTag calls fn with every wxs_start_tag child until fn returns false.
+func (n WxsElement) EachWxsStartTag(fn func(WxsStartTag) bool) {
+	eachChild(n.Node, KindWxsStartTag, func(child *tree_sitter.Node) bool { return fn(WxsStartTag{child}) })
+}
+
+// WxsEndTag is a typed wxs_end_tag node.
+type WxsEndTag struct{ *tree_sitter.Node }
+
+// AsWxsEndTag returns node as a WxsEndTag if it has that kind.
+func AsWxsEndTag(node *tree_sitter.Node) (WxsEndTag, bool) {
+	return WxsEndTag{node}, node != nil && node.KindId() == KindWxsEndTag
+}
+
+// TagName returns the first tag_name child.
+func (n WxsEndTag) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// WxsStartTag is a typed wxs_start_tag node.
+type WxsStartTag struct{ *tree_sitter.Node }
+
+// AsWxsStartTag returns node as a WxsStartTag if it has that kind.
+func AsWxsStartTag(node *tree_sitter.Node) (WxsStartTag, bool) {
+	return WxsStartTag{node}, node != nil && node.KindId() == KindWxsStartTag
+}
+
+// Attribute returns the first attribute child.
+func (n WxsStartTag) Attribute() (Attribute, bool) {
+	return AsAttribute(firstChild(n.Node, KindAttribute))
+}
+
+// EachAttribute calls fn with every attribute child until fn returns false.
+func (n WxsStartTag) EachAttribute(fn func(Attribute) bool) {
+	eachChild(n.Node, KindAttribute, func(child *tree_sitter.Node) bool { return fn(Attribute{child}) })
+}
+
+// TagName returns the first tag_name child.
+func (n WxsStartTag) TagName() (TagName, bool) {
+	return AsTagName(firstChild(n.Node, KindTagName))
+}
+
+// EachTagName calls fn with every tag_name child until fn returns false.
+func (n WxsStartTag) EachTagName(fn func(TagName) bool) {
+	eachChild(n.Node, KindTagName, func(child *tree_sitter.Node) bool { return fn(TagName{child}) })
+}
+
+// AttributeName is a typed attribute_name node.
+type AttributeName struct{ *tree_sitter.Node }
+
+// AsAttributeName returns node as a AttributeName if it has that kind.
+func AsAttributeName(node *tree_sitter.Node) (AttributeName, bool) {
+	return AttributeName{node}, node != nil && node.KindId() == KindAttributeName
+}
+
+// AttributeValue is a typed attribute_value node.
+type AttributeValue struct{ *tree_sitter.Node }
+
+// AsAttributeValue returns node as a AttributeValue if it has that kind.
+func AsAttributeValue(node *tree_sitter.Node) (AttributeValue, bool) {
+	return AttributeValue{node}, node != nil && node.KindId() == KindAttributeValue
+}
+
+// Comment is a typed comment node.
+type Comment struct{ *tree_sitter.Node }
+
+// AsComment returns node as a Comment if it has that kind.
+func AsComment(node *tree_sitter.Node) (Comment, bool) {
+	return Comment{node}, node != nil && node.KindId() == KindComment
+}
+
+// Entity is a typed entity node.
+type Entity struct{ *tree_sitter.Node }
+
+// AsEntity returns node as a Entity if it has that kind.
+func AsEntity(node *tree_sitter.Node) (Entity, bool) {
+	return Entity{node}, node != nil && node.KindId() == KindEntity
+}
+
+// InterpolationEnd is a typed interpolation_end node.
+type InterpolationEnd struct{ *tree_sitter.Node }
+
+// AsInterpolationEnd returns node as a InterpolationEnd if it has that kind.
+func AsInterpolationEnd(node *tree_sitter.Node) (InterpolationEnd, bool) {
+	return InterpolationEnd{node}, node != nil && node.KindId() == KindInterpolationEnd
+}
+
+// InterpolationStart is a typed interpolation_start node.
+type InterpolationStart struct{ *tree_sitter.Node }
+
+// AsInterpolationStart returns node as a InterpolationStart if it has that kind.
+func AsInterpolationStart(node *tree_sitter.Node) (InterpolationStart, bool) {
+	return InterpolationStart{node}, node != nil && node.KindId() == KindInterpolationStart
+}
+
+// RawText is a typed raw_text node.
+type RawText struct{ *tree_sitter.Node }
+
+// AsRawText returns node as a RawText if it has that kind.
+func AsRawText(node *tree_sitter.Node) (RawText, bool) {
+	return RawText{node}, node != nil && node.KindId() == KindRawText
+}
+
+// TagName is a typed tag_name node.
+type TagName struct{ *tree_sitter.Node }
+
+// AsTagName returns node as a TagName if it has that kind.
+func AsTagName(node *tree_sitter.Node) (TagName, bool) {
+	return TagName{node}, node != nil && node.KindId() == KindTagName
+}
+
+// Text is a typed text node.
+type Text struct{ *tree_sitter.Node }
+
+// AsText returns node as a Text if it has that kind.
+func AsText(node *tree_sitter.Node) (Text, bool) {
+	return Text{node}, node != nil && node.KindId() == KindText
+}
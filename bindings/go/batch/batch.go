@@ -0,0 +1,164 @@
+// Package batch parses WXML documents with a pooled native parser and
+// returns each tree as a flat slice of nodes, parsed and built in C in one
+// cgo call.
+//
+// Unlike the parent package, it links against the tree-sitter runtime
+// through pkg-config.
+package batch
+
+// #cgo pkg-config: tree-sitter
+// #cgo CFLAGS: -std=c11
+// #include "flatten.h"
+import "C"
+
+import (
+	"errors"
+	"runtime"
+	"sync"
+	"sync/atomic"
+	"unsafe"
+
+	tree_sitter_wxml "github.com/blocklune/tree-sitter-wxml/bindings/go"
+)
+
+// KindError is the Kind of ERROR nodes.
+const KindError = 0xFFFF
+
+// ErrCancelled is returned when the runtime gives up on a document.
+var ErrCancelled = errors.New("tree-sitter-wxml: parsing was cancelled")
+
+// ErrLanguage is returned when the linked tree-sitter runtime cannot load
+// this grammar's language ABI.
+var ErrLanguage = errors.New("tree-sitter-wxml: the tree-sitter runtime cannot load this language ABI")
+
+var errNoMemory = errors.New("tree-sitter-wxml: out of memory")
+
+// Node is one node of a flattened tree. Nodes are stored in preorder, so
+// index 0 is the root, which is also its own Parent.
+type Node struct {
+	Kind      uint16
+	Depth     uint16
+	StartByte uint32
+	EndByte   uint32
+	Parent    uint32
+}
+
+// Parser is a native parser for this grammar. It is not safe for concurrent
+// use; take one per goroutine from a ParserPool.
+type Parser struct {
+	ptr *C.TSParser
+	// Records of the last document, reused so that a document usually
+	// costs a single cgo call to parse and flatten.
+	scratch []Node
+}
+
+// NewParser returns a parser whose native resources are released when it is
+// garbage collected, or ErrLanguage if the runtime cannot load the grammar.
+func NewParser() (*Parser, error) {
+	ptr := C.ts_parser_new()
+	if !C.ts_parser_set_language(ptr, (*C.TSLanguage)(tree_sitter_wxml.Language())) {
+		C.ts_parser_delete(ptr)
+		return nil, ErrLanguage
+	}
+	p := &Parser{ptr: ptr}
+	runtime.SetFinalizer(p, func(p *Parser) { C.ts_parser_delete(p.ptr) })
+	return p, nil
+}
+
+// Parse parses source and returns its nodes in preorder.
+func (p *Parser) Parse(source []byte) ([]Node, error) {
+	var data *C.char
+	if len(source) > 0 {
+		data = (*C.char)(unsafe.Pointer(&source[0]))
+	}
+	if len(p.scratch) == 0 {
+		// Markup averages well over four bytes per node.
+		p.scratch = make([]Node, len(source)/4+64)
+	}
+	var count C.uint32_t
+	var tree *C.TSTree
+	status := C.wxml_batch_parse(p.ptr, data, C.uint32_t(len(source)),
+		(*C.wxml_node_record)(unsafe.Pointer(&p.scratch[0])), C.uint32_t(len(p.scratch)), &count, &tree)
+	runtime.KeepAlive(p)
+	switch status {
+	case C.WXML_BATCH_CANCELLED:
+		return nil, ErrCancelled
+	case C.WXML_BATCH_NO_MEMORY:
+		return nil, errNoMemory
+	case C.WXML_BATCH_TOO_SMALL:
+		p.scratch = make([]Node, count)
+		if !C.wxml_batch_flatten(tree, (*C.wxml_node_record)(unsafe.Pointer(&p.scratch[0]))) {
+			return nil, errNoMemory
+		}
+	}
+	nodes := make([]Node, count)
+	copy(nodes, p.scratch)
+	return nodes, nil
+}
+
+// ParserPool reuses parsers, and their internal buffers, across documents.
+type ParserPool struct {
+	pool sync.Pool
+}
+
+// NewParserPool returns an empty pool that creates parsers on demand.
+func NewParserPool() *ParserPool {
+	return &ParserPool{}
+}
+
+// Get takes a parser from the pool, creating one if the pool is empty.
+func (p *ParserPool) Get() (*Parser, error) {
+	if parser, ok := p.pool.Get().(*Parser); ok {
+		return parser, nil
+	}
+	return NewParser()
+}
+
+// Put returns a parser to the pool.
+func (p *ParserPool) Put(parser *Parser) {
+	p.pool.Put(parser)
+}
+
+var defaultPool = NewParserPool()
+
+// Parse parses one document with a parser from the default pool.
+func Parse(source []byte) ([]Node, error) {
+	parser, err := defaultPool.Get()
+	if err != nil {
+		return nil, err
+	}
+	defer defaultPool.Put(parser)
+	return parser.Parse(source)
+}
+
+// ParseMany parses every source on up to GOMAXPROCS goroutines and returns
+// the results in input order, along with any errors joined together.
+func ParseMany(sources [][]byte) ([][]Node, error) {
+	results := make([][]Node, len(sources))
+	errs := make([]error, len(sources))
+	var next atomic.Int64
+	var wg sync.WaitGroup
+	for w := min(runtime.GOMAXPROCS(0), len(sources)); w > 0; w-- {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			parser, err := defaultPool.Get()
+			if err == nil {
+				defer defaultPool.Put(parser)
+			}
+			for {
+				i := int(next.Add(1) - 1)
+				if i >= len(sources) {
+					return
+				}
+				if err != nil {
+					errs[i] = err
+					continue
+				}
+				results[i], errs[i] = parser.Parse(sources[i])
+			}
+		}()
+	}
+	wg.Wait()
+	return results, errors.Join(errs...)
+}
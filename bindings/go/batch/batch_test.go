@@ -0,0 +1,123 @@
+package batch_test
+
+import (
+	"fmt"
+	"strings"
+	"testing"
+
+	"github.com/blocklune/tree-sitter-wxml/bindings/go/batch"
+)
+
+func TestParse(t *testing.T) {
+	source := []byte("<view><text>hi</text></view>")
+	nodes, err := batch.Parse(source)
+	if err != nil {
+		t.Fatal(err)
+	}
+	element := nodes[1]
+	if element.Depth != 1 || element.Parent != 0 || int(element.EndByte) != len(source) {
+		t.Errorf("unexpected element record %+v", element)
+	}
+	for i, node := range nodes[1:] {
+		if nodes[node.Parent].Depth != node.Depth-1 {
+			t.Errorf("node %d has parent at depth %d", i+1, nodes[node.Parent].Depth)
+		}
+	}
+}
+
+func TestParseManyKeepsOrder(t *testing.T) {
+	sources := [][]byte{[]byte("<view/>"), []byte("<text>{{ a }}</text>"), []byte("")}
+	results, err := batch.ParseMany(sources)
+	if err != nil {
+		t.Fatal(err)
+	}
+	for i, nodes := range results {
+		if int(nodes[0].EndByte) != len(sources[i]) {
+			t.Errorf("result %d covers %d bytes, want %d", i, nodes[0].EndByte, len(sources[i]))
+		}
+	}
+}
+
+func page(n int) []byte {
+	var b strings.Builder
+	b.WriteString("<import src=\"../common/item.wxml\" />\n")
+	for i := 0; i < n; i++ {
+		fmt.Fprintf(&b, "<view class=\"row-%d\" wx:for=\"{{list}}\" bindtap=\"onTap\">\n", i)
+		b.WriteString("  <!-- item -->\n  <block wx:if=\"{{item.visible}}\">\n")
+		b.WriteString("    <text>{{item.count}} &amp; more</text>\n  </block>\n</view>\n")
+	}
+	return []byte(b.String())
+}
+
+func BenchmarkParseNewParser(b *testing.B) {
+	source := page(64)
+	b.SetBytes(int64(len(source)))
+	for i := 0; i < b.N; i++ {
+		parser, err := batch.NewParser()
+		if err != nil {
+			b.Fatal(err)
+		}
+		if _, err := parser.Parse(source); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkParsePooled(b *testing.B) {
+	source := page(64)
+	b.SetBytes(int64(len(source)))
+	for i := 0; i < b.N; i++ {
+		if _, err := batch.Parse(source); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func BenchmarkParseMany(b *testing.B) {
+	sources := make([][]byte, 256)
+	size := 0
+	for i := range sources {
+		sources[i] = page(16 + i%32)
+		size += len(sources[i])
+	}
+	b.SetBytes(int64(size))
+	for i := 0; i < b.N; i++ {
+		if _, err := batch.ParseMany(sources); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
+
+func TestParseGrowsScratch(t *testing.T) {
+	parser, err := batch.NewParser()
+	if err != nil {
+		t.Fatal(err)
+	}
+	small, large := page(1), page(256)
+	if _, err := parser.Parse(small); err != nil {
+		t.Fatal(err)
+	}
+	got, err := parser.Parse(large)
+	if err != nil {
+		t.Fatal(err)
+	}
+	fresh, err := batch.NewParser()
+	if err != nil {
+		t.Fatal(err)
+	}
+	want, err := fresh.Parse(large)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if len(got) != len(want) {
+		t.Fatalf("got %d nodes, want %d", len(got), len(want))
+	}
+	for i := range got {
+		if got[i] != want[i] {
+			t.Fatalf("node %d is %+v, want %+v", i, got[i], want[i])
+		}
+	}
+	if int(got[0].EndByte) != len(large) {
+		t.Errorf("root covers %d bytes, want %d", got[0].EndByte, len(large))
+	}
+}
@@ -0,0 +1,65 @@
+#include "flatten.h"
+
+#include <stdlib.h>
+
+wxml_batch_status wxml_batch_parse(TSParser *parser, const char *source, uint32_t length,
+                                   wxml_node_record *records, uint32_t capacity, uint32_t *count,
+                                   TSTree **tree) {
+    *tree = ts_parser_parse_string(parser, NULL, source, length);
+    if (*tree == NULL) {
+        *count = 0;
+        return WXML_BATCH_CANCELLED;
+    }
+    *count = ts_node_descendant_count(ts_tree_root_node(*tree));
+    if (*count > capacity) {
+        return WXML_BATCH_TOO_SMALL;
+    }
+    bool flattened = wxml_batch_flatten(*tree, records);
+    *tree = NULL;
+    return flattened ? WXML_BATCH_DONE : WXML_BATCH_NO_MEMORY;
+}
+
+bool wxml_batch_flatten(TSTree *tree, wxml_node_record *records) {
+    uint32_t capacity = 64, depth = 0;
+    uint32_t *parents = malloc(capacity * sizeof(uint32_t));
+    if (parents == NULL) {
+        ts_tree_delete(tree);
+        return false;
+    }
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(tree));
+    parents[0] = 0;
+    for (uint32_t i = 0;; i++) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        records[i] = (wxml_node_record){
+            .kind = ts_node_symbol(node),
+            .depth = depth < UINT16_MAX ? (uint16_t)depth : UINT16_MAX,
+            .start_byte = ts_node_start_byte(node),
+            .end_byte = ts_node_end_byte(node),
+            .parent = parents[depth],
+        };
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            if (++depth == capacity) {
+                uint32_t *grown = realloc(parents, (capacity *= 2) * sizeof(uint32_t));
+                if (grown == NULL) {
+                    break;
+                }
+                parents = grown;
+            }
+            parents[depth] = i;
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                free(parents);
+                ts_tree_cursor_delete(&cursor);
+                ts_tree_delete(tree);
+                return true;
+            }
+            depth--;
+        }
+    }
+    free(parents);
+    ts_tree_cursor_delete(&cursor);
+    ts_tree_delete(tree);
+    return false;
+}
@@ -0,0 +1,36 @@
+#ifndef TREE_SITTER_WXML_BATCH_FLATTEN_H_
+#define TREE_SITTER_WXML_BATCH_FLATTEN_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <tree_sitter/api.h>
+
+// One preorder node, laid out like batch.Node.
+typedef struct {
+    uint16_t kind;
+    uint16_t depth;
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t parent;
+} wxml_node_record;
+
+typedef enum {
+    WXML_BATCH_DONE,      // the nodes were written to `records`
+    WXML_BATCH_TOO_SMALL, // the tree has more than `capacity` nodes
+    WXML_BATCH_CANCELLED,
+    WXML_BATCH_NO_MEMORY,
+} wxml_batch_status;
+
+// Parses `source`, stores its number of nodes in `count` and, if there are
+// at most `capacity`, writes them to `records` in preorder, all in one cgo
+// call. On WXML_BATCH_TOO_SMALL the tree is left in `tree` for
+// wxml_batch_flatten; otherwise `tree` is set to NULL.
+wxml_batch_status wxml_batch_parse(TSParser *parser, const char *source, uint32_t length,
+                                   wxml_node_record *records, uint32_t capacity, uint32_t *count,
+                                   TSTree **tree);
+
+// Writes every node of `tree` to `records` in preorder and deletes the tree.
+// Returns false if the traversal could not allocate its stack.
+bool wxml_batch_flatten(TSTree *tree, wxml_node_record *records);
+
+#endif // TREE_SITTER_WXML_BATCH_FLATTEN_H_
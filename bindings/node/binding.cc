@@ -1,5 +1,17 @@
 #include <napi.h>
 
+#ifdef TREE_SITTER_WXML_NATIVE
+#include <tree_sitter/api.h>
+#include <tree_sitter/tree-sitter-wxml-preorder.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#endif
+
 typedef struct TSLanguage TSLanguage;
 
 extern "C" TSLanguage *tree_sitter_wxml();
@@ -9,10 +21,562 @@ const napi_type_tag LANGUAGE_TYPE_TAG = {
     0x8AF2E5212AD58ABF, 0xD5006CAD83ABBA16
 };
 
+#ifdef TREE_SITTER_WXML_NATIVE
+
+namespace {
+
+// Word columns of a node table, in the order they are laid out in `words`.
+enum TableColumn : uint32_t {
+    kStartByte,
+    kEndByte,
+    kParent,
+    kFirstChild,
+    kNextSibling,
+    kWordColumns,
+};
+
+// Preorder node table of one document. Index 0 is always the root, so 0
+// doubles as "no node" in the link columns.
+struct NodeTable {
+    uint32_t count = 0;
+    std::vector<uint32_t> words;
+    std::vector<uint16_t> kinds;
+};
+
+NodeTable BuildTable(TSNode root) {
+    NodeTable table;
+    table.count = ts_node_descendant_count(root);
+    table.words.resize(kWordColumns * table.count);
+    table.kinds.resize(table.count);
+    uint32_t *columns[kWordColumns];
+    for (uint32_t c = 0; c < kWordColumns; c++) {
+        columns[c] = table.words.data() + c * table.count;
+    }
+
+    std::vector<uint32_t> parents;
+    std::vector<uint32_t> last_child;
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    for (uint32_t i = 0;; i++) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        table.kinds[i] = ts_node_symbol(node);
+        columns[kStartByte][i] = ts_node_start_byte(node);
+        columns[kEndByte][i] = ts_node_end_byte(node);
+        if (!parents.empty()) {
+            columns[kParent][i] = parents.back();
+            if (last_child.back() != 0) {
+                columns[kNextSibling][last_child.back()] = i;
+            } else {
+                columns[kFirstChild][parents.back()] = i;
+            }
+            last_child.back() = i;
+        }
+
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            parents.push_back(i);
+            last_child.push_back(0);
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                ts_tree_cursor_delete(&cursor);
+                return table;
+            }
+            parents.pop_back();
+            last_child.pop_back();
+        }
+    }
+}
+
+// Copies a table into a single ArrayBuffer and exposes its columns as views
+// over it, with the 16-bit `kind` column last to keep the others aligned.
+Napi::Object TableToJS(Napi::Env env, const NodeTable &table) {
+    size_t word_bytes = table.words.size() * sizeof(uint32_t);
+    size_t kind_bytes = table.kinds.size() * sizeof(uint16_t);
+    Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(env, word_bytes + kind_bytes);
+    uint8_t *data = static_cast<uint8_t *>(buffer.Data());
+    if (table.count > 0) {
+        std::memcpy(data, table.words.data(), word_bytes);
+        std::memcpy(data + word_bytes, table.kinds.data(), kind_bytes);
+    }
+    auto column = [&](TableColumn c) {
+        return Napi::Uint32Array::New(env, table.count, buffer, c * table.count * sizeof(uint32_t));
+    };
+    Napi::Object object = Napi::Object::New(env);
+    object["length"] = Napi::Number::New(env, table.count);
+    object["kind"] = Napi::Uint16Array::New(env, table.count, buffer, word_bytes);
+    object["startByte"] = column(kStartByte);
+    object["endByte"] = column(kEndByte);
+    object["parent"] = column(kParent);
+    object["firstChild"] = column(kFirstChild);
+    object["nextSibling"] = column(kNextSibling);
+    return object;
+}
+
+// Sets the grammar on `parser`. This fails when the runtime vendored from
+// the `tree-sitter` package is older than the ABI the parser was generated
+// for, in which case every parse would return NULL.
+bool SetLanguage(TSParser *parser) { return ts_parser_set_language(parser, tree_sitter_wxml()); }
+
+std::string AbiMismatch() {
+    return "tree-sitter-wxml: ABI mismatch: the tree-sitter runtime only supports language ABI versions " +
+           std::to_string(TREE_SITTER_MIN_COMPATIBLE_LANGUAGE_VERSION) + " to " +
+           std::to_string(TREE_SITTER_LANGUAGE_VERSION) + ", which does not include this parser's";
+}
+
+// Summary of one parsed document. Trees produced by this copy of the runtime
+// cannot be handed to the `tree-sitter` package, so only plain data crosses
+// back into JavaScript.
+struct ParseResult {
+    bool parsed = false;
+    bool has_error = false;
+    uint32_t node_count = 0;
+    uint32_t error_count = 0;
+    NodeTable table;
+};
+
+// State shared by all workers of one `parseMany` call. Workers pull the next
+// document from `next`, so a few large files cannot stall the whole batch.
+struct ParseBatch {
+    ParseBatch(Napi::Env env, Napi::Array inputs)
+        : deferred(Napi::Promise::Deferred::New(env)), inputs(Napi::Persistent(inputs.As<Napi::Object>())) {}
+
+    Napi::Promise::Deferred deferred;
+    Napi::ObjectReference inputs;
+    std::vector<std::string> strings;
+    std::vector<const char *> sources;
+    std::vector<uint32_t> lengths;
+    std::vector<ParseResult> results;
+    std::atomic<size_t> next{0};
+    size_t pending = 0;
+    bool tables = false;
+    std::string error; // the first worker error, which rejects the batch
+
+    void Resolve(Napi::Env env) {
+        Napi::Array array = Napi::Array::New(env, results.size());
+        for (size_t i = 0; i < results.size(); i++) {
+            const ParseResult &result = results[i];
+            if (!result.parsed) {
+                array[i] = env.Null();
+                continue;
+            }
+            Napi::Object object = Napi::Object::New(env);
+            object["hasError"] = Napi::Boolean::New(env, result.has_error);
+            object["nodeCount"] = Napi::Number::New(env, result.node_count);
+            object["errorCount"] = Napi::Number::New(env, result.error_count);
+            if (tables) {
+                object["table"] = TableToJS(env, result.table);
+            }
+            array[i] = object;
+        }
+        inputs.Reset();
+        deferred.Resolve(array);
+    }
+};
+
+class ParseWorker : public Napi::AsyncWorker {
+  public:
+    ParseWorker(Napi::Env env, std::shared_ptr<ParseBatch> batch)
+        : Napi::AsyncWorker(env, "tree-sitter-wxml:parseMany"), batch_(std::move(batch)) {}
+
+    void Execute() override {
+        ParseBatch &batch = *batch_;
+        TSParser *parser = ts_parser_new();
+        if (!SetLanguage(parser)) {
+            ts_parser_delete(parser);
+            SetError(AbiMismatch());
+            return;
+        }
+        for (size_t i; (i = batch.next.fetch_add(1, std::memory_order_relaxed)) < batch.results.size();) {
+            TSTree *tree = ts_parser_parse_string(parser, nullptr, batch.sources[i], batch.lengths[i]);
+            if (tree == nullptr) {
+                continue;
+            }
+            TSNode root = ts_tree_root_node(tree);
+            ParseResult &result = batch.results[i];
+            result.parsed = true;
+            result.has_error = ts_node_has_error(root);
+            result.node_count = ts_node_descendant_count(root);
+            result.error_count = result.has_error ? wxml_count_errors(root) : 0;
+            if (batch.tables) {
+                result.table = BuildTable(root);
+            }
+            ts_tree_delete(tree);
+        }
+        ts_parser_delete(parser);
+    }
+
+    void OnOK() override { Finish(); }
+
+    void OnError(const Napi::Error &error) override {
+        if (batch_->error.empty()) {
+            batch_->error = error.Message();
+        }
+        Finish();
+    }
+
+  private:
+    void Finish() {
+        if (--batch_->pending != 0) {
+            return;
+        }
+        if (batch_->error.empty()) {
+            batch_->Resolve(Env());
+        } else {
+            batch_->inputs.Reset();
+            batch_->deferred.Reject(Napi::Error::New(Env(), batch_->error).Value());
+        }
+    }
+
+    std::shared_ptr<ParseBatch> batch_;
+};
+
+// Number of workers to queue when the caller does not ask for a specific
+// concurrency: one per libuv threadpool thread.
+uint32_t DefaultConcurrency() {
+    const char *size = std::getenv("UV_THREADPOOL_SIZE");
+    int value = size != nullptr ? std::atoi(size) : 0;
+    return value > 0 ? static_cast<uint32_t>(value) : 4;
+}
+
+// Resolves a Uint8Array or string argument to UTF-8 bytes. Strings are
+// copied into `storage`; typed arrays are borrowed and must be kept alive by
+// the caller.
+void ReadSource(Napi::Value input, std::string &storage, const char *&source, uint32_t &length) {
+    if (input.IsTypedArray() && input.As<Napi::TypedArray>().TypedArrayType() == napi_uint8_array) {
+        Napi::Uint8Array bytes = input.As<Napi::Uint8Array>();
+        source = reinterpret_cast<const char *>(bytes.Data());
+        length = static_cast<uint32_t>(bytes.ByteLength());
+    } else if (input.IsString()) {
+        storage = input.As<Napi::String>().Utf8Value();
+        source = storage.data();
+        length = static_cast<uint32_t>(storage.size());
+    } else {
+        throw Napi::TypeError::New(input.Env(), "expected a Uint8Array or a string");
+    }
+}
+
+// parseMany(inputs: Array<Buffer | Uint8Array | string>, options?: { concurrency?: number })
+Napi::Value ParseMany(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        throw Napi::TypeError::New(env, "parseMany expects an array of buffers or strings");
+    }
+    Napi::Array inputs = info[0].As<Napi::Array>();
+    auto batch = std::make_shared<ParseBatch>(env, inputs);
+    uint32_t concurrency = DefaultConcurrency();
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object options = info[1].As<Napi::Object>();
+        Napi::Value value = options.Get("concurrency");
+        if (!value.IsUndefined()) {
+            if (!value.IsNumber() || value.As<Napi::Number>().Int32Value() < 1) {
+                throw Napi::RangeError::New(env, "concurrency must be a positive integer");
+            }
+            concurrency = value.As<Napi::Number>().Uint32Value();
+        }
+        batch->tables = options.Get("table").ToBoolean();
+    }
+
+    uint32_t count = inputs.Length();
+    batch->strings.resize(count);
+    batch->sources.resize(count);
+    batch->lengths.resize(count);
+    batch->results.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        ReadSource(inputs[i], batch->strings[i], batch->sources[i], batch->lengths[i]);
+    }
+
+    Napi::Promise promise = batch->deferred.Promise();
+    if (count == 0) {
+        batch->Resolve(env);
+        return promise;
+    }
+    batch->pending = concurrency < count ? concurrency : count;
+    for (size_t i = 0, workers = batch->pending; i < workers; i++) {
+        (new ParseWorker(env, batch))->Queue();
+    }
+    return promise;
+}
+
+// parseTable(input: Uint8Array | string): NodeTable
+Napi::Value ParseTable(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    std::string storage;
+    const char *source = nullptr;
+    uint32_t length = 0;
+    ReadSource(info[0], storage, source, length);
+
+    TSParser *parser = ts_parser_new();
+    if (!SetLanguage(parser)) {
+        ts_parser_delete(parser);
+        throw Napi::Error::New(env, AbiMismatch());
+    }
+    TSTree *tree = ts_parser_parse_string(parser, nullptr, source, length);
+    ts_parser_delete(parser);
+    if (tree == nullptr) {
+        return env.Null();
+    }
+    NodeTable table = BuildTable(ts_tree_root_node(tree));
+    ts_tree_delete(tree);
+    return TableToJS(env, table);
+}
+
+// Symbol names indexed by kind id, for decoding the `kind` column.
+Napi::Array KindNames(Napi::Env env) {
+    const TSLanguage *language = tree_sitter_wxml();
+    uint32_t count = ts_language_symbol_count(language);
+    Napi::Array names = Napi::Array::New(env, count);
+    for (uint32_t i = 0; i < count; i++) {
+        names[i] = Napi::String::New(env, ts_language_symbol_name(language, static_cast<TSSymbol>(i)));
+    }
+    return names;
+}
+
+// Event types of `parseEvents`. Each event is three words in a batch:
+// type, start byte and end byte.
+enum EventType : uint32_t {
+    kOpenTag = 1,     // tag name of a start or self-closing tag
+    kCloseTag,        // tag name of the element being closed
+    kAttributeName,
+    kAttributeValue,  // value without its quotes
+    kText,
+    kEntity,
+    kInterpolation,   // expression between the delimiters
+    kRawText,
+    kComment,
+};
+
+constexpr uint32_t kEventWords = 3;
+// Largest accepted batchSize: 1M events, a 12 MiB batch buffer.
+constexpr uint32_t kMaxBatchSize = 1u << 20;
+
+// Symbols the event stream dispatches on, resolved once per process.
+struct EventSymbols {
+    TSSymbol tag_name, attribute_name, attribute_value, quoted_attribute_value;
+    TSSymbol text, entity, interpolation, raw_text, comment;
+    TSSymbol end_tag, template_end_tag, slot_end_tag, block_end_tag, wxs_end_tag;
+    TSSymbol self_closing_tag, import_statement, include_statement;
+
+    EventSymbols() {
+        const TSLanguage *language = tree_sitter_wxml();
+        auto named = [language](const char *name) {
+            return ts_language_symbol_for_name(language, name, static_cast<uint32_t>(std::strlen(name)), true);
+        };
+        tag_name = named("tag_name");
+        attribute_name = named("attribute_name");
+        attribute_value = named("attribute_value");
+        quoted_attribute_value = named("quoted_attribute_value");
+        text = named("text");
+        entity = named("entity");
+        interpolation = named("interpolation");
+        raw_text = named("raw_text");
+        comment = named("comment");
+        end_tag = named("end_tag");
+        template_end_tag = named("template_end_tag");
+        slot_end_tag = named("slot_end_tag");
+        block_end_tag = named("block_end_tag");
+        wxs_end_tag = named("wxs_end_tag");
+        self_closing_tag = named("self_closing_tag");
+        import_statement = named("import_statement");
+        include_statement = named("include_statement");
+    }
+
+    bool IsEndTag(TSSymbol symbol) const {
+        return symbol == end_tag || symbol == template_end_tag || symbol == slot_end_tag ||
+               symbol == block_end_tag || symbol == wxs_end_tag;
+    }
+
+    bool IsSelfClosing(TSSymbol symbol) const {
+        return symbol == self_closing_tag || symbol == import_statement || symbol == include_statement;
+    }
+};
+
+// Walks one tree and hands events to a JavaScript callback in fixed-size
+// batches written into a single reused ArrayBuffer.
+class EventStream {
+  public:
+    EventStream(Napi::Env env, Napi::Function callback, uint32_t batch_size, TSTree *tree)
+        : env_(env), callback_(callback), batch_size_(batch_size), tree_(tree),
+          buffer_(Napi::ArrayBuffer::New(env, size_t{batch_size} * kEventWords * sizeof(uint32_t))),
+          events_(static_cast<uint32_t *>(buffer_.Data())), cursor_(ts_tree_cursor_new(ts_tree_root_node(tree))) {}
+
+    ~EventStream() {
+        ts_tree_cursor_delete(&cursor_);
+        ts_tree_delete(tree_);
+    }
+
+    // Returns the number of events delivered, stopping early when the
+    // callback returns `false`.
+    double Run() {
+        static const EventSymbols symbols;
+        std::vector<TSSymbol> parents;
+        uint32_t open_start = 0, open_end = 0;
+        for (;;) {
+            TSNode node = ts_tree_cursor_current_node(&cursor_);
+            TSSymbol symbol = ts_node_symbol(node);
+            uint32_t start = ts_node_start_byte(node), end = ts_node_end_byte(node);
+            bool descend = false;
+            if (symbol == symbols.tag_name) {
+                if (!parents.empty() && symbols.IsEndTag(parents.back())) {
+                    Emit(kCloseTag, start, end);
+                } else {
+                    Emit(kOpenTag, start, end);
+                    open_start = start;
+                    open_end = end;
+                }
+            } else if (symbol == symbols.attribute_name) {
+                Emit(kAttributeName, start, end);
+            } else if (symbol == symbols.attribute_value) {
+                Emit(kAttributeValue, start, end);
+            } else if (symbol == symbols.quoted_attribute_value) {
+                Emit(kAttributeValue, start + 1, end > start + 1 ? end - 1 : end);
+                descend = true;
+            } else if (symbol == symbols.text) {
+                Emit(kText, start, end);
+            } else if (symbol == symbols.entity) {
+                Emit(kEntity, start, end);
+            } else if (symbol == symbols.interpolation) {
+                uint32_t count = ts_node_child_count(node);
+                TSNode first = ts_node_child(node, 0), last = ts_node_child(node, count - 1);
+                uint32_t inner_start = ts_node_end_byte(first);
+                uint32_t inner_end = count > 1 ? ts_node_start_byte(last) : inner_start;
+                Emit(kInterpolation, inner_start, inner_end < inner_start ? inner_start : inner_end);
+            } else if (symbol == symbols.raw_text) {
+                Emit(kRawText, start, end);
+            } else if (symbol == symbols.comment) {
+                Emit(kComment, start, end);
+            } else {
+                descend = ts_node_child_count(node) > 0;
+            }
+            if (stopped_) {
+                return emitted_;
+            }
+
+            if (descend && ts_tree_cursor_goto_first_child(&cursor_)) {
+                parents.push_back(symbol);
+                continue;
+            }
+            for (;;) {
+                if (symbols.IsSelfClosing(ts_node_symbol(ts_tree_cursor_current_node(&cursor_)))) {
+                    Emit(kCloseTag, open_start, open_end);
+                }
+                if (ts_tree_cursor_goto_next_sibling(&cursor_)) {
+                    break;
+                }
+                if (!ts_tree_cursor_goto_parent(&cursor_)) {
+                    Flush();
+                    return emitted_;
+                }
+                parents.pop_back();
+            }
+        }
+    }
+
+  private:
+    void Emit(uint32_t type, uint32_t start, uint32_t end) {
+        if (stopped_) {
+            return;
+        }
+        uint32_t *event = events_ + pending_ * kEventWords;
+        event[0] = type;
+        event[1] = start;
+        event[2] = end;
+        if (++pending_ == batch_size_) {
+            Flush();
+        }
+    }
+
+    void Flush() {
+        if (pending_ == 0 || stopped_) {
+            return;
+        }
+        Napi::Uint32Array batch = Napi::Uint32Array::New(env_, pending_ * kEventWords, buffer_, 0);
+        emitted_ += pending_;
+        pending_ = 0;
+        Napi::Value result = callback_.Call({batch});
+        stopped_ = result.IsBoolean() && !result.As<Napi::Boolean>().Value();
+    }
+
+    Napi::Env env_;
+    Napi::Function callback_;
+    uint32_t batch_size_;
+    TSTree *tree_;
+    Napi::ArrayBuffer buffer_;
+    uint32_t *events_;
+    TSTreeCursor cursor_;
+    uint32_t pending_ = 0;
+    double emitted_ = 0;
+    bool stopped_ = false;
+};
+
+// parseEvents(input: Uint8Array | string, onEvents: (events: Uint32Array) => boolean | void,
+//             options?: { batchSize?: number }): number
+Napi::Value ParseEvents(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    std::string storage;
+    const char *source = nullptr;
+    uint32_t length = 0;
+    ReadSource(info[0], storage, source, length);
+    if (info.Length() < 2 || !info[1].IsFunction()) {
+        throw Napi::TypeError::New(env, "parseEvents expects a callback");
+    }
+    uint32_t batch_size = 1024;
+    if (info.Length() > 2 && info[2].IsObject()) {
+        Napi::Value value = info[2].As<Napi::Object>().Get("batchSize");
+        if (!value.IsUndefined()) {
+            if (!value.IsNumber() || value.As<Napi::Number>().Int32Value() < 1) {
+                throw Napi::RangeError::New(env, "batchSize must be a positive integer");
+            }
+            if (value.As<Napi::Number>().DoubleValue() > kMaxBatchSize) {
+                throw Napi::RangeError::New(env, "batchSize must be at most " + std::to_string(kMaxBatchSize));
+            }
+            batch_size = value.As<Napi::Number>().Uint32Value();
+        }
+    }
+
+    TSParser *parser = ts_parser_new();
+    if (!SetLanguage(parser)) {
+        ts_parser_delete(parser);
+        throw Napi::Error::New(env, AbiMismatch());
+    }
+    TSTree *tree = ts_parser_parse_string(parser, nullptr, source, length);
+    ts_parser_delete(parser);
+    if (tree == nullptr) {
+        return env.Null();
+    }
+    EventStream stream(env, info[1].As<Napi::Function>(), batch_size, tree);
+    return Napi::Number::New(env, stream.Run());
+}
+
+// Values of the `type` word of each event.
+Napi::Object EventTypes(Napi::Env env) {
+    Napi::Object types = Napi::Object::New(env);
+    types["OPEN_TAG"] = Napi::Number::New(env, kOpenTag);
+    types["CLOSE_TAG"] = Napi::Number::New(env, kCloseTag);
+    types["ATTRIBUTE_NAME"] = Napi::Number::New(env, kAttributeName);
+    types["ATTRIBUTE_VALUE"] = Napi::Number::New(env, kAttributeValue);
+    types["TEXT"] = Napi::Number::New(env, kText);
+    types["ENTITY"] = Napi::Number::New(env, kEntity);
+    types["INTERPOLATION"] = Napi::Number::New(env, kInterpolation);
+    types["RAW_TEXT"] = Napi::Number::New(env, kRawText);
+    types["COMMENT"] = Napi::Number::New(env, kComment);
+    return types;
+}
+
+} // namespace
+
+#endif // TREE_SITTER_WXML_NATIVE
+
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
     auto language = Napi::External<TSLanguage>::New(env, tree_sitter_wxml());
     language.TypeTag(&LANGUAGE_TYPE_TAG);
     exports["language"] = language;
+#ifdef TREE_SITTER_WXML_NATIVE
+    exports["parseMany"] = Napi::Function::New(env, ParseMany, "parseMany");
+    exports["parseTable"] = Napi::Function::New(env, ParseTable, "parseTable");
+    exports["kindNames"] = KindNames(env);
+    exports["parseEvents"] = Napi::Function::New(env, ParseEvents, "parseEvents");
+    exports["EventType"] = EventTypes(env);
+#endif
     return exports;
 }
 
@@ -3,7 +3,66 @@ const { test } = require("node:test");
 
 const Parser = require("tree-sitter");
 
+const binding = require(".");
+const native = typeof binding.parseMany === "function";
+
 test("can load grammar", () => {
   const parser = new Parser();
   assert.doesNotThrow(() => parser.setLanguage(require(".")));
 });
+
+test("parseMany summarizes every input in order", { skip: !native }, async () => {
+  const inputs = [
+    Buffer.from('<view class="a">{{ msg }}</view>'),
+    "<text>hello</text>",
+    "<view>",
+  ];
+  const results = await binding.parseMany(inputs, { concurrency: 2 });
+  assert.strictEqual(results.length, inputs.length);
+  assert.strictEqual(results[0].hasError, false);
+  assert.strictEqual(results[1].hasError, false);
+  assert.strictEqual(results[2].hasError, true);
+  assert.ok(results[2].errorCount > 0);
+  assert.ok(results[0].nodeCount > results[1].nodeCount);
+});
+
+test("parseTable links nodes in preorder", { skip: !native }, () => {
+  const source = "<view><text>hi</text></view>";
+  const table = binding.parseTable(source);
+  assert.strictEqual(binding.kindNames[table.kind[0]], "document");
+  const element = table.firstChild[0];
+  assert.strictEqual(binding.kindNames[table.kind[element]], "element");
+  assert.strictEqual(table.parent[element], 0);
+  assert.strictEqual(table.endByte[element], source.length);
+  const startTag = table.firstChild[element];
+  const inner = table.nextSibling[startTag];
+  assert.strictEqual(binding.kindNames[table.kind[inner]], "element");
+  assert.strictEqual(source.slice(table.startByte[inner], table.endByte[inner]), "<text>hi</text>");
+});
+
+test("parseEvents streams tags, attributes and text", { skip: !native }, () => {
+  const source = '<view id="a">{{ x }}<icon/></view>';
+  const { EventType } = binding;
+  const seen = [];
+  const count = binding.parseEvents(source, (events) => {
+    for (let i = 0; i < events.length; i += 3) {
+      seen.push([events[i], source.slice(events[i + 1], events[i + 2])]);
+    }
+  }, { batchSize: 2 });
+  assert.strictEqual(count, seen.length);
+  assert.deepStrictEqual(seen, [
+    [EventType.OPEN_TAG, "view"],
+    [EventType.ATTRIBUTE_NAME, "id"],
+    [EventType.ATTRIBUTE_VALUE, "a"],
+    [EventType.INTERPOLATION, " x "],
+    [EventType.OPEN_TAG, "icon"],
+    [EventType.CLOSE_TAG, "icon"],
+    [EventType.CLOSE_TAG, "view"],
+  ]);
+});
+
+test("parseEvents rejects batch sizes out of range", { skip: !native }, () => {
+  for (const batchSize of [0, 1431655766, 2 ** 20 + 1]) {
+    assert.throws(() => binding.parseEvents("<view/>", () => {}, { batchSize }), RangeError);
+  }
+});
@@ -18,9 +18,81 @@ type NodeInfo =
       children: ChildNode[];
     });
 
+/**
+ * A document flattened into preorder columns, one entry per node. Index 0 is
+ * the root, so 0 also means "no node" in `parent`, `firstChild` and
+ * `nextSibling`.
+ */
+type NodeTable = {
+  length: number;
+  kind: Uint16Array;
+  startByte: Uint32Array;
+  endByte: Uint32Array;
+  parent: Uint32Array;
+  firstChild: Uint32Array;
+  nextSibling: Uint32Array;
+};
+
+type ParseSummary = {
+  hasError: boolean;
+  nodeCount: number;
+  errorCount: number;
+  table?: NodeTable;
+};
+
+type ParseManyOptions = {
+  /** Number of threadpool workers to use, defaults to `UV_THREADPOOL_SIZE` or 4. */
+  concurrency?: number;
+  /** Also return the node table of every document. */
+  table?: boolean;
+};
+
+/** Values of the first word of every `parseEvents` event. */
+type EventTypes = {
+  OPEN_TAG: number;
+  CLOSE_TAG: number;
+  ATTRIBUTE_NAME: number;
+  ATTRIBUTE_VALUE: number;
+  TEXT: number;
+  ENTITY: number;
+  INTERPOLATION: number;
+  RAW_TEXT: number;
+  COMMENT: number;
+};
+
+type ParseEventsOptions = {
+  /** Maximum number of events per callback, defaults to 1024, at most 2^20. */
+  batchSize?: number;
+};
+
 type Language = {
   language: unknown;
   nodeTypeInfo: NodeInfo[];
+  /**
+   * Parses every input on the libuv threadpool. Only available when the addon
+   * was built with the `tree-sitter` package installed. Rejects if that
+   * package's runtime cannot load this parser's ABI version.
+   */
+  parseMany?: (
+    inputs: Array<Uint8Array | string>,
+    options?: ParseManyOptions,
+  ) => Promise<Array<ParseSummary | null>>;
+  /** Parses one input on the calling thread and returns its node table. */
+  parseTable?: (input: Uint8Array | string) => NodeTable | null;
+  /** Symbol names indexed by the ids in `NodeTable.kind`. */
+  kindNames?: string[];
+  /**
+   * Streams a document as `[type, startByte, endByte]` triples in batches.
+   * The array is reused between calls, so copy anything kept past the
+   * callback. Returning `false` stops the stream. Returns the number of events
+   * delivered.
+   */
+  parseEvents?: (
+    input: Uint8Array | string,
+    onEvents: (events: Uint32Array) => boolean | void,
+    options?: ParseEventsOptions,
+  ) => number | null;
+  EventType?: EventTypes;
 };
 
 declare const language: Language;
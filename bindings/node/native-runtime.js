@@ -0,0 +1,31 @@
+#!/usr/bin/env node
+// Prints the lib directory of the tree-sitter runtime vendored by the
+// `tree-sitter` package installed next to this one, or nothing if there is
+// no such package or its runtime cannot load src/parser.c's language ABI.
+// binding.gyp only builds the native parsing API against a runtime this
+// prints, so the API is either usable or absent, never always failing.
+
+const fs = require("node:fs");
+const path = require("node:path");
+
+function define(source, name) {
+  const match = source.match(new RegExp(`#define ${name} (\\d+)`));
+  return match ? Number(match[1]) : NaN;
+}
+
+try {
+  const lib = path.join(path.dirname(require.resolve("tree-sitter/package.json")), "vendor", "tree-sitter", "lib");
+  const api = fs.readFileSync(path.join(lib, "include", "tree_sitter", "api.h"), "utf8");
+  const parser = fs.readFileSync(path.join(__dirname, "..", "..", "src", "parser.c"), "utf8");
+  const abi = define(parser, "LANGUAGE_VERSION");
+  const min = define(api, "TREE_SITTER_MIN_COMPATIBLE_LANGUAGE_VERSION");
+  const max = define(api, "TREE_SITTER_LANGUAGE_VERSION");
+  if (abi >= min && abi <= max) {
+    process.stdout.write(lib);
+  } else {
+    console.error(`tree-sitter-wxml: the installed tree-sitter runtime supports ABI ${min} to ${max}, ` +
+      `not ${abi}; building without the native parsing API`);
+  }
+} catch (_) {
+  // No tree-sitter package: build the language only.
+}
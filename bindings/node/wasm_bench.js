@@ -0,0 +1,111 @@
+// Compares the wasm build against the native binding: time to load the
+// language and parse throughput over the test corpus and a large page.
+//
+//   make wasm && node --test bindings/node/wasm_bench.js
+//
+// Needs `tree-sitter` and `web-tree-sitter` to be installed; each side is
+// skipped when its module or artifact is missing.
+
+const assert = require("node:assert");
+const fs = require("node:fs");
+const path = require("node:path");
+const { test } = require("node:test");
+
+const root = path.join(__dirname, "..", "..");
+const wasmPath = process.env.TREE_SITTER_WXML_WASM || path.join(root, "tree-sitter-wxml.wasm");
+const iterations = Number(process.env.BENCH_ITERATIONS) || 20;
+
+function tryRequire(id) {
+  try {
+    return require(id);
+  } catch (_) {
+    return null;
+  }
+}
+
+function corpusInputs() {
+  const dir = path.join(root, "test", "corpus");
+  const inputs = [];
+  for (const file of fs.readdirSync(dir).sort()) {
+    const lines = fs.readFileSync(path.join(dir, file), "utf8").split("\n");
+    for (let i = 0; i < lines.length; i++) {
+      if (!/^=+$/.test(lines[i]) || !/^=+$/.test(lines[i + 2] || "")) continue;
+      const start = i + 3;
+      let end = start;
+      while (end < lines.length && !/^-+$/.test(lines[end])) end++;
+      inputs.push(lines.slice(start, end).join("\n").trim());
+      i = end;
+    }
+  }
+  return inputs;
+}
+
+function page(rows) {
+  let source = '<import src="../common/item.wxml" />\n';
+  for (let i = 0; i < rows; i++) {
+    source += `<view class="row-${i}" wx:for="{{list}}" bindtap="onTap">\n`;
+    source += '  <!-- item -->\n  <block wx:if="{{item.visible}}">\n';
+    source += "    <text>{{item.count}} &amp; more</text>\n  </block>\n</view>\n";
+  }
+  return source;
+}
+
+const inputs = [...corpusInputs(), page(2000)];
+const totalBytes = inputs.reduce((sum, input) => sum + Buffer.byteLength(input), 0);
+
+function throughput(parse) {
+  for (const input of inputs) parse(input);
+  const start = process.hrtime.bigint();
+  for (let i = 0; i < iterations; i++) {
+    for (const input of inputs) parse(input);
+  }
+  const seconds = Number(process.hrtime.bigint() - start) / 1e9;
+  return (totalBytes * iterations) / seconds / 1e6;
+}
+
+const results = {};
+
+const nativeStart = process.hrtime.bigint();
+const nativeLanguage = tryRequire(".");
+const nativeLoadMs = Number(process.hrtime.bigint() - nativeStart) / 1e6;
+const nativeSkip = !nativeLanguage ? "the native binding has not been built"
+  : !tryRequire("tree-sitter") ? "tree-sitter is not installed"
+  : false;
+
+test("native binding", { skip: nativeSkip }, (t) => {
+  const Parser = require("tree-sitter");
+  const parser = new Parser();
+  parser.setLanguage(nativeLanguage);
+
+  assert.strictEqual(parser.parse(inputs[inputs.length - 1]).rootNode.hasError, false);
+  const mbps = throughput((input) => parser.parse(input));
+  results.native = mbps;
+  t.diagnostic(`load ${nativeLoadMs.toFixed(2)} ms, parse ${mbps.toFixed(1)} MB/s`);
+});
+
+const webTreeSitter = tryRequire("web-tree-sitter");
+const wasmSkip = !webTreeSitter ? "web-tree-sitter is not installed"
+  : !fs.existsSync(wasmPath) ? `${path.basename(wasmPath)} has not been built`
+  : false;
+
+test("wasm build", { skip: wasmSkip }, async (t) => {
+  const Parser = webTreeSitter.Parser || webTreeSitter;
+  const Language = webTreeSitter.Language || Parser.Language;
+  const start = process.hrtime.bigint();
+  await Parser.init();
+  const language = await Language.load(fs.readFileSync(wasmPath));
+  const parser = new Parser();
+  parser.setLanguage(language);
+  const loadMs = Number(process.hrtime.bigint() - start) / 1e6;
+
+  const check = parser.parse(inputs[inputs.length - 1]);
+  assert.strictEqual(check.rootNode.hasError, false);
+  check.delete();
+  const mbps = throughput((input) => parser.parse(input).delete());
+  results.wasm = mbps;
+  const size = fs.statSync(wasmPath).size;
+  t.diagnostic(`${(size / 1024).toFixed(1)} KiB, load ${loadMs.toFixed(2)} ms, parse ${mbps.toFixed(1)} MB/s`);
+  if (results.native) {
+    t.diagnostic(`wasm runs at ${((mbps / results.native) * 100).toFixed(0)}% of native`);
+  }
+});
@@ -1,8 +1,11 @@
-from unittest import TestCase
+from struct import iter_unpack
+from unittest import TestCase, skipUnless
 
 import tree_sitter
 import tree_sitter_wxml
 
+NATIVE = hasattr(tree_sitter_wxml, "parse_many")
+
 
 class TestLanguage(TestCase):
     def test_can_load_grammar(self):
@@ -10,3 +13,30 @@ class TestLanguage(TestCase):
             tree_sitter.Language(tree_sitter_wxml.language())
         except Exception:
             self.fail("Error loading WeiXin Markup Language grammar")
+
+
+@skipUnless(NATIVE, "built without the tree-sitter runtime")
+class TestParseMany(TestCase):
+    def test_results_keep_input_order(self):
+        sources = [b'<view class="a">{{ msg }}</view>', "<text>hi</text>", b"<view>"]
+        results = tree_sitter_wxml.parse_many(sources, threads=2)
+        self.assertEqual(len(results), 3)
+        self.assertFalse(results[0][0])
+        self.assertFalse(results[1][0])
+        self.assertTrue(results[2][0])
+        self.assertGreater(results[2][2], 0)
+        self.assertTrue(results.sexp(1).startswith("(document (element"))
+
+    def test_rejects_other_types(self):
+        with self.assertRaises(TypeError):
+            tree_sitter_wxml.parse_many([1])
+
+    def test_nodes_are_packed_records(self):
+        source = b"<view><text>hi</text></view>"
+        results = tree_sitter_wxml.parse_many([source], threads=1)
+        view = results.nodes(0)
+        rows = list(iter_unpack(tree_sitter_wxml.NODE_FORMAT, view))
+        self.assertEqual(len(rows), results[0][1])
+        kind, depth, start, end, parent = rows[1]
+        self.assertEqual((depth, start, end, parent), (1, 0, len(source), 0))
+        self.assertTrue(all(rows[row[4]][1] == row[1] - 1 for row in rows[1:]))
@@ -4,6 +4,23 @@ from importlib.resources import files as _files
 
 from ._binding import language
 
+try:
+    from ._binding import ParseResults, parse_many
+    _NATIVE = ["ParseResults", "parse_many", "NODE_FORMAT", "NODE_DTYPE"]
+except ImportError:  # built without the tree-sitter runtime
+    _NATIVE = []
+
+# Layout of the records returned by `ParseResults.nodes`, for `struct` and
+# `numpy.frombuffer` respectively. A root's parent is 0, its own index.
+NODE_FORMAT = "=HHIII"
+NODE_DTYPE = [
+    ("kind", "=u2"),
+    ("depth", "=u2"),
+    ("start_byte", "=u4"),
+    ("end_byte", "=u4"),
+    ("parent", "=u4"),
+]
+
 
 def _get_query(name, file):
     query = _files(f"{__package__}.queries") / file
@@ -28,6 +45,7 @@ def __getattr__(name):
 
 __all__ = [
     "language",
+    *_NATIVE,
     # "HIGHLIGHTS_QUERY",
     # "INJECTIONS_QUERY",
     # "LOCALS_QUERY",
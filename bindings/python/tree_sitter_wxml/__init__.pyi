@@ -1,4 +1,5 @@
-from typing import Final
+from collections.abc import Sequence
+from typing import Final, final
 
 # NOTE: uncomment these to include any queries that this grammar contains:
 
@@ -8,3 +9,17 @@ from typing import Final
 # TAGS_QUERY: Final[str]
 
 def language() -> object: ...
+
+# Only available when the extension was built against the tree-sitter runtime:
+
+NODE_FORMAT: Final[str]
+NODE_DTYPE: Final[list[tuple[str, str]]]
+
+@final
+class ParseResults:
+    def __len__(self) -> int: ...
+    def __getitem__(self, index: int, /) -> tuple[bool, int, int]: ...
+    def sexp(self, index: int, /) -> str: ...
+    def nodes(self, index: int, /) -> memoryview: ...
+
+def parse_many(sources: Sequence[bytes | str], threads: int = 0) -> ParseResults: ...
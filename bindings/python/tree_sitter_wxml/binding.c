@@ -8,7 +8,397 @@ static PyObject* _binding_language(PyObject *Py_UNUSED(self), PyObject *Py_UNUSE
     return PyCapsule_New(tree_sitter_wxml(), "tree_sitter.Language", NULL);
 }
 
+#ifdef TREE_SITTER_WXML_NATIVE
+
+#include <tree_sitter/api.h>
+#include <tree_sitter/tree-sitter-wxml-preorder.h>
+
+typedef struct {
+    PyTypeObject *parse_results_type;
+} ModuleState;
+
+/**
+ * Trees produced by `parse_many`. They belong to this module's copy of the
+ * runtime, so they are only exposed through summaries computed on access.
+ */
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t count;
+    TSTree **trees;
+} ParseResults;
+
+static void parse_results_dealloc(PyObject *self) {
+    ParseResults *results = (ParseResults *)self;
+    PyTypeObject *type = Py_TYPE(self);
+    for (Py_ssize_t i = 0; i < results->count; i++) {
+        if (results->trees[i] != NULL) {
+            ts_tree_delete(results->trees[i]);
+        }
+    }
+    PyMem_Free(results->trees);
+    freefunc tp_free = (freefunc)PyType_GetSlot(type, Py_tp_free);
+    tp_free(self);
+    Py_DECREF(type);
+}
+
+static Py_ssize_t parse_results_length(PyObject *self) {
+    return ((ParseResults *)self)->count;
+}
+
+static TSTree *parse_results_tree(PyObject *self, Py_ssize_t index) {
+    ParseResults *results = (ParseResults *)self;
+    if (index < 0) {
+        index += results->count;
+    }
+    if (index < 0 || index >= results->count) {
+        PyErr_SetString(PyExc_IndexError, "parse result index out of range");
+        return NULL;
+    }
+    if (results->trees[index] == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "document could not be parsed");
+    }
+    return results->trees[index];
+}
+
+static PyObject *parse_results_item(PyObject *self, Py_ssize_t index) {
+    TSTree *tree = parse_results_tree(self, index);
+    if (tree == NULL) {
+        return NULL;
+    }
+    TSNode root = ts_tree_root_node(tree);
+    bool has_error = ts_node_has_error(root);
+    return Py_BuildValue("(NII)", PyBool_FromLong(has_error), ts_node_descendant_count(root),
+                         has_error ? wxml_count_errors(root) : 0);
+}
+
+static PyObject *parse_results_sexp(PyObject *self, PyObject *arg) {
+    Py_ssize_t index = PyLong_AsSsize_t(arg);
+    if (index == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    TSTree *tree = parse_results_tree(self, index);
+    if (tree == NULL) {
+        return NULL;
+    }
+    char *string = ts_node_string(ts_tree_root_node(tree));
+    PyObject *result = PyUnicode_FromString(string);
+    free(string);
+    return result;
+}
+
+/**
+ * One row of the table returned by `ParseResults.nodes`, matching
+ * `NODE_FORMAT` and `NODE_DTYPE` in `__init__.py`.
+ */
+typedef struct {
+    uint16_t kind;
+    uint16_t depth;
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t parent;
+} NodeRecord;
+
+/**
+ * Writes the tree's nodes in preorder. Index 0 is the root, so a parent of 0
+ * on the root itself means "no parent". Runs without the GIL, so it only
+ * allocates with the C allocator.
+ */
+static bool write_node_records(TSNode root, NodeRecord *records) {
+    uint32_t capacity = 64, depth = 0;
+    uint32_t *parents = malloc(capacity * sizeof(uint32_t));
+    if (parents == NULL) {
+        return false;
+    }
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    parents[0] = 0;
+    for (uint32_t i = 0;; i++) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        records[i] = (NodeRecord){
+            .kind = ts_node_symbol(node),
+            .depth = depth < UINT16_MAX ? (uint16_t)depth : UINT16_MAX,
+            .start_byte = ts_node_start_byte(node),
+            .end_byte = ts_node_end_byte(node),
+            .parent = parents[depth],
+        };
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            if (++depth == capacity) {
+                uint32_t *grown = realloc(parents, (capacity *= 2) * sizeof(uint32_t));
+                if (grown == NULL) {
+                    free(parents);
+                    ts_tree_cursor_delete(&cursor);
+                    return false;
+                }
+                parents = grown;
+            }
+            parents[depth] = i;
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                free(parents);
+                ts_tree_cursor_delete(&cursor);
+                return true;
+            }
+            depth--;
+        }
+    }
+}
+
+static PyObject *parse_results_nodes(PyObject *self, PyObject *arg) {
+    Py_ssize_t index = PyLong_AsSsize_t(arg);
+    if (index == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    TSTree *tree = parse_results_tree(self, index);
+    if (tree == NULL) {
+        return NULL;
+    }
+    TSNode root = ts_tree_root_node(tree);
+    uint32_t count = ts_node_descendant_count(root);
+    PyObject *bytes = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)count * (Py_ssize_t)sizeof(NodeRecord));
+    if (bytes == NULL) {
+        return NULL;
+    }
+    NodeRecord *records = (NodeRecord *)PyBytes_AsString(bytes);
+    bool written;
+    Py_BEGIN_ALLOW_THREADS
+    written = write_node_records(root, records);
+    Py_END_ALLOW_THREADS
+    if (!written) {
+        Py_DECREF(bytes);
+        return PyErr_NoMemory();
+    }
+    PyObject *view = PyMemoryView_FromObject(bytes);
+    Py_DECREF(bytes);
+    return view;
+}
+
+static PyMethodDef parse_results_methods[] = {
+    {"sexp", parse_results_sexp, METH_O,
+     "Get the S-expression of the document at the given index."},
+    {"nodes", parse_results_nodes, METH_O,
+     "Get the nodes of the document at the given index as a memoryview of packed records."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyType_Slot parse_results_slots[] = {
+    {Py_tp_doc, "Trees parsed by parse_many, summarized lazily as "
+                "(has_error, node_count, error_count) tuples."},
+    {Py_tp_dealloc, parse_results_dealloc},
+    {Py_tp_methods, parse_results_methods},
+    {Py_sq_length, parse_results_length},
+    {Py_sq_item, parse_results_item},
+    {0, NULL}
+};
+
+static PyType_Spec parse_results_spec = {
+    .name = "tree_sitter_wxml._binding.ParseResults",
+    .basicsize = sizeof(ParseResults),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .slots = parse_results_slots,
+};
+
+/**
+ * Work shared by the threads of one `parse_many` call. Each thread owns a
+ * parser and claims the next unparsed document under `lock`.
+ */
+typedef struct {
+    const char **sources;
+    Py_ssize_t *lengths;
+    TSTree **trees;
+    Py_ssize_t count;
+    Py_ssize_t next;
+    int running;
+    bool abi_mismatch;
+    PyThread_type_lock lock;
+    PyThread_type_lock done;
+} ParseJob;
+
+static void parse_worker(void *payload) {
+    ParseJob *job = payload;
+    TSParser *parser = ts_parser_new();
+    bool loaded = ts_parser_set_language(parser, tree_sitter_wxml());
+    for (;;) {
+        PyThread_acquire_lock(job->lock, WAIT_LOCK);
+        Py_ssize_t index = loaded ? job->next++ : job->count;
+        job->abi_mismatch |= !loaded;
+        PyThread_release_lock(job->lock);
+        if (index >= job->count) {
+            break;
+        }
+        job->trees[index] = ts_parser_parse_string(parser, NULL, job->sources[index], (uint32_t)job->lengths[index]);
+    }
+    ts_parser_delete(parser);
+
+    PyThread_acquire_lock(job->lock, WAIT_LOCK);
+    bool last = --job->running == 0;
+    PyThread_release_lock(job->lock);
+    if (last) {
+        PyThread_release_lock(job->done);
+    }
+}
+
+/**
+ * Starts `threads - 1` helper threads and works on the calling thread too.
+ * Must be called without the GIL held.
+ */
+static void run_parse_job(ParseJob *job, int threads) {
+    job->running = threads;
+    PyThread_acquire_lock(job->done, WAIT_LOCK);
+    for (int i = 1; i < threads; i++) {
+        if (PyThread_start_new_thread(parse_worker, job) == (unsigned long)-1) {
+            PyThread_acquire_lock(job->lock, WAIT_LOCK);
+            job->running--;
+            PyThread_release_lock(job->lock);
+        }
+    }
+    parse_worker(job);
+    PyThread_acquire_lock(job->done, WAIT_LOCK);
+    PyThread_release_lock(job->done);
+}
+
+static int default_thread_count(void) {
+    PyObject *os = PyImport_ImportModule("os");
+    if (os == NULL) {
+        return -1;
+    }
+    PyObject *count = PyObject_CallMethod(os, "cpu_count", NULL);
+    Py_DECREF(os);
+    if (count == NULL) {
+        return -1;
+    }
+    long value = count == Py_None ? 1 : PyLong_AsLong(count);
+    Py_DECREF(count);
+    return value == -1 && PyErr_Occurred() ? -1 : (int)value;
+}
+
+static PyObject *_binding_parse_many(PyObject *self, PyObject *args, PyObject *kwargs) {
+    static char *keywords[] = {"sources", "threads", NULL};
+    PyObject *sequence;
+    int threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|i:parse_many", keywords, &sequence, &threads)) {
+        return NULL;
+    }
+    if (threads <= 0 && (threads = default_thread_count()) < 0) {
+        return NULL;
+    }
+
+    // The tuple keeps every source object, and so every borrowed buffer,
+    // alive while the GIL is released.
+    PyObject *items = PySequence_Tuple(sequence);
+    if (items == NULL) {
+        return NULL;
+    }
+    ModuleState *state = PyModule_GetState(self);
+    ParseResults *results = NULL;
+    ParseJob job = {.count = PyTuple_Size(items)};
+    job.sources = PyMem_Calloc(job.count + 1, sizeof(const char *));
+    job.lengths = PyMem_Calloc(job.count + 1, sizeof(Py_ssize_t));
+    job.trees = PyMem_Calloc(job.count + 1, sizeof(TSTree *));
+    job.lock = PyThread_allocate_lock();
+    job.done = PyThread_allocate_lock();
+    if (job.sources == NULL || job.lengths == NULL || job.trees == NULL || job.lock == NULL || job.done == NULL) {
+        PyErr_NoMemory();
+        goto exit;
+    }
+
+    for (Py_ssize_t i = 0; i < job.count; i++) {
+        PyObject *item = PyTuple_GetItem(items, i);
+        char *bytes;
+        if (PyBytes_Check(item)) {
+            if (PyBytes_AsStringAndSize(item, &bytes, &job.lengths[i]) < 0) {
+                goto exit;
+            }
+            job.sources[i] = bytes;
+        } else if (PyUnicode_Check(item)) {
+            if ((job.sources[i] = PyUnicode_AsUTF8AndSize(item, &job.lengths[i])) == NULL) {
+                goto exit;
+            }
+        } else {
+            PyErr_SetString(PyExc_TypeError, "parse_many() sources must be bytes or str");
+            goto exit;
+        }
+        if (job.lengths[i] > UINT32_MAX) {
+            PyErr_SetString(PyExc_OverflowError, "parse_many() source is larger than 4 GiB");
+            goto exit;
+        }
+    }
+
+    if (threads > job.count) {
+        threads = job.count > 0 ? (int)job.count : 1;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    run_parse_job(&job, threads);
+    Py_END_ALLOW_THREADS
+    if (job.abi_mismatch) {
+        PyErr_Format(PyExc_RuntimeError,
+                     "tree-sitter-wxml: ABI mismatch: the tree-sitter runtime only supports language ABI "
+                     "versions %d to %d, which does not include this parser's",
+                     TREE_SITTER_MIN_COMPATIBLE_LANGUAGE_VERSION, TREE_SITTER_LANGUAGE_VERSION);
+        goto exit;
+    }
+
+    allocfunc tp_alloc = (allocfunc)PyType_GetSlot(state->parse_results_type, Py_tp_alloc);
+    results = (ParseResults *)tp_alloc(state->parse_results_type, 0);
+    if (results != NULL) {
+        results->count = job.count;
+        results->trees = job.trees;
+        job.trees = NULL;
+    }
+
+exit:
+    if (job.trees != NULL) {
+        for (Py_ssize_t i = 0; i < job.count; i++) {
+            if (job.trees[i] != NULL) {
+                ts_tree_delete(job.trees[i]);
+            }
+        }
+    }
+    PyMem_Free(job.trees);
+    PyMem_Free(job.sources);
+    PyMem_Free(job.lengths);
+    if (job.lock != NULL) {
+        PyThread_free_lock(job.lock);
+    }
+    if (job.done != NULL) {
+        PyThread_free_lock(job.done);
+    }
+    Py_DECREF(items);
+    return (PyObject *)results;
+}
+
+static int module_exec(PyObject *module) {
+    ModuleState *state = PyModule_GetState(module);
+    state->parse_results_type = (PyTypeObject *)PyType_FromModuleAndSpec(module, &parse_results_spec, NULL);
+    if (state->parse_results_type == NULL) {
+        return -1;
+    }
+    return PyModule_AddObjectRef(module, "ParseResults", (PyObject *)state->parse_results_type);
+}
+
+static int module_traverse(PyObject *module, visitproc visit, void *arg) {
+    ModuleState *state = PyModule_GetState(module);
+    Py_VISIT(state->parse_results_type);
+    return 0;
+}
+
+static int module_clear(PyObject *module) {
+    ModuleState *state = PyModule_GetState(module);
+    Py_CLEAR(state->parse_results_type);
+    return 0;
+}
+
+static void module_free(void *module) {
+    module_clear((PyObject *)module);
+}
+
+#endif // TREE_SITTER_WXML_NATIVE
+
 static struct PyModuleDef_Slot slots[] = {
+#ifdef TREE_SITTER_WXML_NATIVE
+    {Py_mod_exec, module_exec},
+#endif
 #ifdef Py_GIL_DISABLED
     {Py_mod_gil, Py_MOD_GIL_NOT_USED},
 #endif
@@ -18,6 +408,11 @@ static struct PyModuleDef_Slot slots[] = {
 static PyMethodDef methods[] = {
     {"language", _binding_language, METH_NOARGS,
      "Get the tree-sitter language for this grammar."},
+#ifdef TREE_SITTER_WXML_NATIVE
+    {"parse_many", (PyCFunction)(void(*)(void))_binding_parse_many, METH_VARARGS | METH_KEYWORDS,
+     "Parse a sequence of bytes or str sources on `threads` threads, with the GIL released. "
+     "Raises RuntimeError if the runtime cannot load this parser's ABI."},
+#endif
     {NULL, NULL, 0, NULL}
 };
 
@@ -25,7 +420,14 @@ static struct PyModuleDef module = {
     .m_base = PyModuleDef_HEAD_INIT,
     .m_name = "_binding",
     .m_doc = NULL,
+#ifdef TREE_SITTER_WXML_NATIVE
+    .m_size = sizeof(ModuleState),
+    .m_traverse = module_traverse,
+    .m_clear = module_clear,
+    .m_free = module_free,
+#else
     .m_size = 0,
+#endif
     .m_methods = methods,
     .m_slots = slots,
 };
@@ -0,0 +1,67 @@
+//! Measures how `parse_many` throughput scales with the number of threads.
+//!
+//! Run with `cargo bench --features parallel`.
+
+use std::thread;
+use std::time::Instant;
+
+use tree_sitter_wxml::parallel::parse_many;
+
+const DOCUMENTS: usize = 4096;
+
+/// A mid-sized page exercising most of the grammar.
+fn page(index: usize) -> String {
+    let mut page = String::from("<import src=\"../common/item.wxml\" />\n");
+    page.push_str(
+        "<wxs module=\"fmt\">\nmodule.exports.n = function (v) { return v + 1; };\n</wxs>\n",
+    );
+    for item in 0..(index % 16 + 16) {
+        page.push_str(&format!(
+            concat!(
+                "<view class=\"row row-{0}\" wx:for=\"{{{{list}}}}\" wx:key=\"id\" bindtap=\"onTap\">\n",
+                "  <!-- item {0} -->\n",
+                "  <block wx:if=\"{{{{item.visible && {0} > 1}}}}\">\n",
+                "    <text>{{{{fmt.n(item.count)}}}} &amp; more</text>\n",
+                "    <template is=\"item\" data=\"{{{{...item}}}}\" />\n",
+                "  </block>\n",
+                "  <image src=\"{{{{item.icon}}}}\" mode=\"aspectFit\" />\n",
+                "</view>\n",
+            ),
+            item
+        ));
+    }
+    page
+}
+
+fn main() {
+    let sources: Vec<String> = (0..DOCUMENTS).map(page).collect();
+    let megabytes = sources.iter().map(String::len).sum::<usize>() as f64 / 1e6;
+    let max_threads = thread::available_parallelism().map_or(1, |n| n.get());
+
+    let mut baseline = None;
+    let mut threads = 1;
+    loop {
+        let pool = rayon::ThreadPoolBuilder::new()
+            .num_threads(threads)
+            .build()
+            .expect("Error building thread pool");
+        pool.install(|| parse_many(&sources));
+
+        let start = Instant::now();
+        let trees = pool.install(|| parse_many(&sources));
+        let seconds = start.elapsed().as_secs_f64();
+        assert!(trees.iter().all(Option::is_some));
+
+        let throughput = megabytes / seconds;
+        let baseline = *baseline.get_or_insert(throughput);
+        println!(
+            "{threads:>3} threads: {throughput:>8.1} MB/s, {:>5.2}x",
+            throughput / baseline
+        );
+
+        if threads == max_threads {
+            break;
+        }
+        threads = (threads * 2).min(max_threads);
+    }
+}
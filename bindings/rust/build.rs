@@ -18,4 +18,270 @@ fn main() {
     }
 
     c_config.compile("tree-sitter-wxml");
+
+    #[cfg(feature = "typed")]
+    typed::generate(src_dir);
+}
+
+/// Generates the typed node wrappers included by `bindings/rust/nodes.rs`.
+///
+/// Node kinds and their children come from `node-types.json`; kind ids are
+/// resolved here from the symbol tables in `parser.c`, the same way
+/// `ts_language_symbol_for_name` resolves them at runtime.
+#[cfg(feature = "typed")]
+mod typed {
+    use std::collections::HashMap;
+    use std::fmt::Write as _;
+    use std::fs;
+    use std::path::{Path, PathBuf};
+
+    struct Symbol {
+        name: String,
+        visible: bool,
+        named: bool,
+        public: u16,
+    }
+
+    pub fn generate(src_dir: &Path) {
+        let node_types_path = src_dir.join("node-types.json");
+        let parser_path = src_dir.join("parser.c");
+        println!(
+            "cargo:rerun-if-changed={}",
+            node_types_path.to_str().unwrap()
+        );
+
+        let parser = fs::read_to_string(&parser_path).expect("Error reading parser.c");
+        let symbols = read_symbols(&parser);
+        let node_types: serde_json::Value = serde_json::from_str(
+            &fs::read_to_string(&node_types_path).expect("Error reading node-types.json"),
+        )
+        .expect("Error parsing node-types.json");
+
+        let kind_id = |name: &str, named: bool| {
+            symbols
+                .iter()
+                .find(|symbol| symbol.visible && symbol.named == named && symbol.name == name)
+                .map(|symbol| symbol.public)
+                .unwrap_or_else(|| panic!("No symbol for node kind {name:?}"))
+        };
+
+        let mut kinds = String::new();
+        let mut wrappers = String::new();
+        for node_type in node_types
+            .as_array()
+            .expect("node-types.json is not an array")
+        {
+            if !node_type["named"].as_bool().unwrap_or(false) {
+                continue;
+            }
+            let kind = node_type["type"]
+                .as_str()
+                .expect("Node type without a name");
+            let id = kind_id(kind, true);
+            let ty = type_name(kind);
+            writeln!(kinds, "    pub const {}: u16 = {id};", kind.to_uppercase()).unwrap();
+
+            let mut accessors = String::new();
+            if let Some(children) = node_type.get("children") {
+                let multiple = children["multiple"].as_bool().unwrap_or(false);
+                for child in children["types"].as_array().into_iter().flatten() {
+                    if !child["named"].as_bool().unwrap_or(false) {
+                        continue;
+                    }
+                    let child_kind = child["type"].as_str().unwrap();
+                    let child_ty = type_name(child_kind);
+                    let method = method_name(child_kind);
+                    write!(
+                        accessors,
+                        concat!(
+                            "\n",
+                            "    /// The first `{kind}` child.\n",
+                            "    #[inline]\n",
+                            "    pub fn {method}(&self) -> Option<{ty}<'tree>> {{\n",
+                            "        first_child(self.0)\n",
+                            "    }}\n",
+                        ),
+                        kind = child_kind,
+                        method = method,
+                        ty = child_ty,
+                    )
+                    .unwrap();
+                    if multiple {
+                        write!(
+                            accessors,
+                            concat!(
+                                "\n",
+                                "    /// All `{kind}` children, in order.\n",
+                                "    #[inline]\n",
+                                "    pub fn {method}_children(&self) -> Children<'tree, {ty}<'tree>> {{\n",
+                                "        Children::new(self.0)\n",
+                                "    }}\n",
+                            ),
+                            kind = child_kind,
+                            method = method.trim_end_matches('_'),
+                            ty = child_ty,
+                        )
+                        .unwrap();
+                    }
+                }
+            }
+
+            write!(
+                wrappers,
+                concat!(
+                    "\n",
+                    "/// A typed `{kind}` node.\n",
+                    "#[derive(Clone, Copy, Debug, PartialEq, Eq, Hash)]\n",
+                    "#[repr(transparent)]\n",
+                    "pub struct {ty}<'tree>(Node<'tree>);\n",
+                    "\n",
+                    "impl<'tree> TypedNode<'tree> for {ty}<'tree> {{\n",
+                    "    const KIND_ID: u16 = kind::{konst};\n",
+                    "    const KIND: &'static str = {kind:?};\n",
+                    "\n",
+                    "    #[inline]\n",
+                    "    fn cast(node: Node<'tree>) -> Option<Self> {{\n",
+                    "        (node.kind_id() == Self::KIND_ID).then_some(Self(node))\n",
+                    "    }}\n",
+                    "\n",
+                    "    #[inline]\n",
+                    "    fn node(&self) -> Node<'tree> {{\n",
+                    "        self.0\n",
+                    "    }}\n",
+                    "}}\n",
+                ),
+                kind = kind,
+                ty = ty,
+                konst = kind.to_uppercase(),
+            )
+            .unwrap();
+            if !accessors.is_empty() {
+                write!(wrappers, "\nimpl<'tree> {ty}<'tree> {{{accessors}}}\n").unwrap();
+            }
+        }
+
+        let out = format!(
+            concat!(
+                "// Generated by build.rs from node-types.json and parser.c. Do not edit.\n",
+                "\n",
+                "/// Kind ids of the named node kinds, as returned by `Node::kind_id`.\n",
+                "pub mod kind {{\n",
+                "{kinds}",
+                "}}\n",
+                "{wrappers}",
+            ),
+            kinds = kinds,
+            wrappers = wrappers,
+        );
+        let out_path = PathBuf::from(std::env::var("OUT_DIR").unwrap()).join("nodes.rs");
+        fs::write(out_path, out).expect("Error writing nodes.rs");
+    }
+
+    /// Reads the symbol names, metadata and public symbol map from `parser.c`,
+    /// indexed by symbol id.
+    fn read_symbols(parser: &str) -> Vec<Symbol> {
+        let mut ids = HashMap::from([("ts_builtin_sym_end".to_string(), 0usize)]);
+        for line in section(parser, "enum ts_symbol_identifiers {") {
+            if let Some((name, id)) = line.trim().trim_end_matches(',').split_once(" = ") {
+                ids.insert(name.to_string(), id.parse().expect("Invalid symbol id"));
+            }
+        }
+
+        let mut symbols: Vec<Symbol> = (0..ids.len())
+            .map(|_| Symbol {
+                name: String::new(),
+                visible: false,
+                named: false,
+                public: 0,
+            })
+            .collect();
+        let entry = |line: &str| {
+            let (key, value) = line.trim().split_once("] = ")?;
+            Some((
+                ids[key.trim_start_matches('[')],
+                value.trim_end_matches(',').to_string(),
+            ))
+        };
+        for line in section(parser, "ts_symbol_names[] = {") {
+            if let Some((id, value)) = entry(line) {
+                symbols[id].name = unescape(&value[1..value.len() - 1]);
+            }
+        }
+        for line in section(parser, "ts_symbol_map[] = {") {
+            if let Some((id, value)) = entry(line) {
+                symbols[id].public = ids[value.as_str()] as u16;
+            }
+        }
+        let mut current = 0;
+        for line in section(parser, "ts_symbol_metadata[] = {") {
+            let line = line.trim();
+            if let Some((id, _)) = entry(line) {
+                current = id;
+            } else if let Some(value) = line.strip_prefix(".visible = ") {
+                symbols[current].visible = value.starts_with("true");
+            } else if let Some(value) = line.strip_prefix(".named = ") {
+                symbols[current].named = value.starts_with("true");
+            }
+        }
+        symbols
+    }
+
+    /// The lines of the top-level block opened by the line containing `header`.
+    fn section<'a>(source: &'a str, header: &'a str) -> impl Iterator<Item = &'a str> {
+        source
+            .lines()
+            .skip_while(move |line| !line.contains(header))
+            .skip(1)
+            .take_while(|line| *line != "};")
+    }
+
+    fn unescape(literal: &str) -> String {
+        let mut result = String::new();
+        let mut chars = literal.chars();
+        while let Some(c) = chars.next() {
+            if c != '\\' {
+                result.push(c);
+                continue;
+            }
+            match chars.next() {
+                Some('n') => result.push('\n'),
+                Some('r') => result.push('\r'),
+                Some('t') => result.push('\t'),
+                Some('0') => result.push('\0'),
+                Some(other) => result.push(other),
+                None => {}
+            }
+        }
+        result
+    }
+
+    fn type_name(kind: &str) -> String {
+        kind.split('_')
+            .filter(|part| !part.is_empty())
+            .map(|part| {
+                let mut chars = part.chars();
+                chars
+                    .next()
+                    .unwrap()
+                    .to_uppercase()
+                    .chain(chars)
+                    .collect::<String>()
+            })
+            .collect()
+    }
+
+    fn method_name(kind: &str) -> String {
+        const KEYWORDS: &[&str] = &[
+            "as", "break", "const", "continue", "crate", "else", "enum", "extern", "false", "fn",
+            "for", "if", "impl", "in", "let", "loop", "match", "mod", "move", "mut", "pub", "ref",
+            "return", "self", "static", "struct", "super", "trait", "true", "type", "unsafe",
+            "use", "where", "while", "async", "await", "dyn",
+        ];
+        let name = kind.trim_start_matches('_').to_string();
+        if KEYWORDS.contains(&name.as_str()) {
+            name + "_"
+        } else {
+            name
+        }
+    }
 }
@@ -15,11 +15,21 @@
 //! assert!(!tree.root_node().has_error());
 //! ```
 //!
+//! With the `parallel` feature enabled, the [`parallel`] module parses many
+//! documents at once on the rayon thread pool. The `typed` feature adds the
+//! [`nodes`] module of typed node wrappers generated from `node-types.json`.
+//!
 //! [`Parser`]: https://docs.rs/tree-sitter/0.25.8/tree_sitter/struct.Parser.html
 //! [tree-sitter]: https://tree-sitter.github.io/
 
 use tree_sitter_language::LanguageFn;
 
+#[cfg(feature = "typed")]
+pub mod nodes;
+
+#[cfg(feature = "parallel")]
+pub mod parallel;
+
 extern "C" {
     fn tree_sitter_wxml() -> *const ();
 }
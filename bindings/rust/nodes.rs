@@ -0,0 +1,98 @@
+//! Typed wrappers around [`Node`], one per named node kind.
+//!
+//! The wrappers and their child accessors are generated by `build.rs` from
+//! `node-types.json`. Every check compares [`Node::kind_id`] against a
+//! constant from [`kind`], so no node kind strings are compared at runtime.
+
+use std::marker::PhantomData;
+
+use tree_sitter::{Node, TreeCursor};
+
+/// A node known to be of a single kind.
+pub trait TypedNode<'tree>: Sized + Copy {
+    /// The kind id of this node kind.
+    const KIND_ID: u16;
+
+    /// The name of this node kind.
+    const KIND: &'static str;
+
+    /// Wraps `node` if it is of this kind.
+    fn cast(node: Node<'tree>) -> Option<Self>;
+
+    /// The underlying untyped node.
+    fn node(&self) -> Node<'tree>;
+}
+
+/// Iterator over the children of one kind, backed by its own [`TreeCursor`].
+pub struct Children<'tree, T> {
+    cursor: TreeCursor<'tree>,
+    started: bool,
+    _kind: PhantomData<T>,
+}
+
+impl<'tree, T> Children<'tree, T> {
+    fn new(parent: Node<'tree>) -> Self {
+        Self {
+            cursor: parent.walk(),
+            started: false,
+            _kind: PhantomData,
+        }
+    }
+}
+
+impl<'tree, T: TypedNode<'tree>> Iterator for Children<'tree, T> {
+    type Item = T;
+
+    fn next(&mut self) -> Option<T> {
+        loop {
+            let moved = if self.started {
+                self.cursor.goto_next_sibling()
+            } else {
+                self.started = true;
+                self.cursor.goto_first_child()
+            };
+            if !moved {
+                return None;
+            }
+            if let Some(node) = T::cast(self.cursor.node()) {
+                return Some(node);
+            }
+        }
+    }
+}
+
+/// The first child of kind `T`. A cursor steps between siblings in constant
+/// time, whereas [`Node::child`] walks from the first child on every call.
+#[inline]
+fn first_child<'tree, T: TypedNode<'tree>>(parent: Node<'tree>) -> Option<T> {
+    let mut cursor = parent.walk();
+    let found = parent.children(&mut cursor).find_map(T::cast);
+    found
+}
+
+include!(concat!(env!("OUT_DIR"), "/nodes.rs"));
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_typed_children() {
+        let mut parser = tree_sitter::Parser::new();
+        parser
+            .set_language(&crate::LANGUAGE.into())
+            .expect("Error loading WeiXin Markup Language parser");
+        let source = r#"<view id="a"><text>{{ b }}</text></view>"#;
+        let tree = parser.parse(source, None).unwrap();
+
+        let document = Document::cast(tree.root_node()).unwrap();
+        let element = document.element().unwrap();
+        let attribute = element.start_tag().unwrap().attribute().unwrap();
+        let name = attribute.attribute_name().unwrap().node();
+        assert_eq!(name.utf8_text(source.as_bytes()).unwrap(), "id");
+
+        let inner = element.element_children().next().unwrap();
+        assert!(inner.interpolation().is_some());
+        assert!(StartTag::cast(inner.node()).is_none());
+    }
+}
@@ -0,0 +1,101 @@
+//! Parallel parsing of whole projects on the rayon thread pool.
+//!
+//! Every worker thread keeps one [`Parser`] for its whole lifetime, so the
+//! parser and its internal buffers are reused across documents.
+
+use std::cell::RefCell;
+use std::fs;
+use std::io;
+use std::path::{Path, PathBuf};
+
+use rayon::prelude::*;
+use tree_sitter::{Parser, Tree};
+
+thread_local! {
+    static PARSER: RefCell<Option<Parser>> = const { RefCell::new(None) };
+}
+
+/// Parses `source` with the calling thread's parser, creating it on first use.
+fn parse_on_current_thread(source: &[u8]) -> Option<Tree> {
+    PARSER.with(|parser| {
+        parser
+            .borrow_mut()
+            .get_or_insert_with(|| {
+                let mut parser = Parser::new();
+                parser
+                    .set_language(&crate::LANGUAGE.into())
+                    .expect("Error loading WeiXin Markup Language parser");
+                parser
+            })
+            .parse(source, None)
+    })
+}
+
+/// Parses every source in parallel and returns the trees in input order.
+///
+/// A tree is `None` only if parsing was cancelled.
+pub fn parse_many<S>(sources: &[S]) -> Vec<Option<Tree>>
+where
+    S: AsRef<[u8]> + Sync,
+{
+    sources
+        .par_iter()
+        .map(|source| parse_on_current_thread(source.as_ref()))
+        .collect()
+}
+
+/// A `.wxml` file read and parsed by [`parse_dir`].
+pub struct ParsedFile {
+    pub path: PathBuf,
+    pub source: Vec<u8>,
+    pub tree: Tree,
+}
+
+/// Reads and parses every `.wxml` file under `dir` in parallel.
+///
+/// Files are returned sorted by path, so the result does not depend on the
+/// number of threads or on directory iteration order.
+pub fn parse_dir(dir: impl AsRef<Path>) -> io::Result<Vec<ParsedFile>> {
+    let mut paths = Vec::new();
+    collect_wxml_files(dir.as_ref(), &mut paths)?;
+    paths.sort();
+    paths
+        .into_par_iter()
+        .map(|path| {
+            let source = fs::read(&path)?;
+            let tree = parse_on_current_thread(&source).ok_or_else(|| {
+                io::Error::new(io::ErrorKind::Interrupted, "parsing was cancelled")
+            })?;
+            Ok(ParsedFile { path, source, tree })
+        })
+        .collect()
+}
+
+fn collect_wxml_files(dir: &Path, paths: &mut Vec<PathBuf>) -> io::Result<()> {
+    for entry in fs::read_dir(dir)? {
+        let entry = entry?;
+        let file_type = entry.file_type()?;
+        let path = entry.path();
+        if file_type.is_dir() {
+            collect_wxml_files(&path, paths)?;
+        } else if file_type.is_file() && path.extension().is_some_and(|ext| ext == "wxml") {
+            paths.push(path);
+        }
+    }
+    Ok(())
+}
+
+#[cfg(test)]
+mod tests {
+    #[test]
+    fn test_parse_many_keeps_input_order() {
+        let sources = ["<view>{{ a }}</view>", "<text>b</text>", "<view>"];
+        let trees = super::parse_many(&sources);
+        assert_eq!(trees.len(), sources.len());
+        let errors: Vec<bool> = trees
+            .iter()
+            .map(|tree| tree.as_ref().unwrap().root_node().has_error())
+            .collect();
+        assert_eq!(errors, [false, false, true]);
+    }
+}
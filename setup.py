@@ -1,5 +1,7 @@
 from os import path
 from platform import system
+from shlex import split
+from subprocess import CalledProcessError, check_output
 from sysconfig import get_config_var
 
 from setuptools import Extension, find_packages, setup
@@ -26,6 +28,15 @@ if system() != "Windows":
 else:
     cflags = ["/std:c11", "/utf-8"]
 
+# The native parsing API links against the tree-sitter runtime, when
+# pkg-config can find one.
+try:
+    cflags += split(check_output(["pkg-config", "--cflags", "tree-sitter"], text=True))
+    ldflags = split(check_output(["pkg-config", "--libs", "tree-sitter"], text=True))
+    macros.append(("TREE_SITTER_WXML_NATIVE", None))
+except (OSError, CalledProcessError):
+    ldflags = []
+
 
 class Build(build):
     def run(self):
@@ -48,6 +59,7 @@ class EggInfo(egg_info):
         super().find_sources()
         self.filelist.recursive_include("queries", "*.scm")
         self.filelist.include("src/tree_sitter/*.h")
+        self.filelist.include("bindings/c/tree_sitter/*.h")
 
 
 setup(
@@ -63,8 +75,9 @@ setup(
             name="_binding",
             sources=sources,
             extra_compile_args=cflags,
+            extra_link_args=ldflags,
             define_macros=macros,
-            include_dirs=["src"],
+            include_dirs=["src", "bindings/c"],
             py_limited_api=limited_api,
         )
     ],
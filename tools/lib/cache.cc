@@ -0,0 +1,404 @@
+#include "cache.hpp"
+
+#include "hash.hpp"
+#include "mapped_file.hpp"
+
+#include <tree_sitter/tree-sitter-wxml.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+namespace wxml {
+
+namespace {
+
+// Bump when the encoding below, or what it records, changes.
+constexpr uint32_t kFormatVersion = 2;
+constexpr char kMagic[4] = {'W', 'X', 'S', 'M'};
+constexpr char kBlobMagic[4] = {'W', 'X', 'B', 'L'};
+
+// How long trim() leaves a temporary file alone, in case its writer is
+// still running.
+constexpr std::chrono::minutes kTemporaryGrace{10};
+
+// magic, format version, grammar fingerprint, file size.
+constexpr size_t kHeaderSize = 4 + 4 + 8 + 4;
+
+// magic, format version, grammar fingerprint, data hash.
+constexpr size_t kBlobHeaderSize = 4 + 4 + 8 + 8;
+
+class Writer {
+  public:
+    void fixed(uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            out += static_cast<char>(value >> (8 * i));
+        }
+    }
+
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            out += static_cast<char>(value | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    void string(std::string_view value) {
+        varint(value.size());
+        out += value;
+    }
+
+    void references(const std::vector<Reference> &references) {
+        varint(references.size());
+        for (const Reference &reference : references) {
+            string(reference.value);
+            varint(reference.start_byte);
+            varint(reference.end_byte - reference.start_byte);
+        }
+    }
+
+    std::string out;
+};
+
+// Reads what Writer wrote, failing (rather than reading out of bounds) on
+// truncated or corrupt input.
+class Reader {
+  public:
+    explicit Reader(std::string_view data) : data_(data) {}
+
+    bool fixed(uint64_t *value, int bytes) {
+        if (data_.size() - pos_ < static_cast<size_t>(bytes)) {
+            return false;
+        }
+        *value = 0;
+        for (int i = 0; i < bytes; i++) {
+            *value |= static_cast<uint64_t>(static_cast<unsigned char>(data_[pos_++])) << (8 * i);
+        }
+        return true;
+    }
+
+    bool varint(uint64_t *value) {
+        *value = 0;
+        for (int shift = 0; shift < 64 && pos_ < data_.size(); shift += 7) {
+            auto byte = static_cast<unsigned char>(data_[pos_++]);
+            *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (byte < 0x80) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool u32(uint32_t *value) {
+        uint64_t wide;
+        if (!varint(&wide) || wide > UINT32_MAX) {
+            return false;
+        }
+        *value = static_cast<uint32_t>(wide);
+        return true;
+    }
+
+    bool string(std::string *value) {
+        uint64_t size;
+        if (!varint(&size) || size > data_.size() - pos_) {
+            return false;
+        }
+        value->assign(data_.substr(pos_, size));
+        pos_ += size;
+        return true;
+    }
+
+    bool count(uint64_t *value) {
+        // Every element takes at least one byte, which bounds the count.
+        return varint(value) && *value <= data_.size() - pos_;
+    }
+
+    bool references(std::vector<Reference> *references) {
+        uint64_t n;
+        if (!count(&n)) {
+            return false;
+        }
+        references->resize(n);
+        for (Reference &reference : *references) {
+            uint32_t length;
+            if (!string(&reference.value) || !u32(&reference.start_byte) || !u32(&length)) {
+                return false;
+            }
+            reference.end_byte = reference.start_byte + length;
+        }
+        return true;
+    }
+
+    bool done() const { return pos_ == data_.size(); }
+
+  private:
+    std::string_view data_;
+    size_t pos_ = 0;
+};
+
+std::string encode(uint64_t fingerprint, const FileSummary &summary) {
+    Writer writer;
+    writer.out.append(kMagic, sizeof(kMagic));
+    writer.fixed(kFormatVersion, 4);
+    writer.fixed(fingerprint, 8);
+    writer.fixed(summary.size, 4);
+    writer.varint(summary.has_error);
+    writer.references(summary.imports);
+    writer.references(summary.includes);
+    writer.references(summary.templates);
+    writer.references(summary.template_uses);
+    writer.varint(summary.wxs_modules.size());
+    for (const WxsModule &module : summary.wxs_modules) {
+        writer.string(module.module);
+        writer.string(module.src);
+        writer.varint(module.start_byte);
+        writer.varint(module.end_byte - module.start_byte);
+    }
+    writer.varint(summary.component_tags.size());
+    for (const std::string &tag : summary.component_tags) {
+        writer.string(tag);
+    }
+    return std::move(writer.out);
+}
+
+bool decode(std::string_view data, uint64_t fingerprint, FileSummary *summary) {
+    if (data.size() < kHeaderSize || data.compare(0, sizeof(kMagic), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+    Reader reader(data.substr(sizeof(kMagic)));
+    uint64_t format, entry_fingerprint, size, has_error, n;
+    if (!reader.fixed(&format, 4) || format != kFormatVersion || !reader.fixed(&entry_fingerprint, 8) ||
+        entry_fingerprint != fingerprint || !reader.fixed(&size, 4) || !reader.varint(&has_error)) {
+        return false;
+    }
+    summary->size = static_cast<uint32_t>(size);
+    summary->has_error = has_error != 0;
+    if (!reader.references(&summary->imports) || !reader.references(&summary->includes) ||
+        !reader.references(&summary->templates) || !reader.references(&summary->template_uses) ||
+        !reader.count(&n)) {
+        return false;
+    }
+    summary->wxs_modules.resize(n);
+    for (WxsModule &module : summary->wxs_modules) {
+        uint32_t length;
+        if (!reader.string(&module.module) || !reader.string(&module.src) || !reader.u32(&module.start_byte) ||
+            !reader.u32(&length)) {
+            return false;
+        }
+        module.end_byte = module.start_byte + length;
+    }
+    if (!reader.count(&n)) {
+        return false;
+    }
+    summary->component_tags.resize(n);
+    for (std::string &tag : summary->component_tags) {
+        if (!reader.string(&tag)) {
+            return false;
+        }
+    }
+    return reader.done();
+}
+
+std::string encode_blob(uint64_t fingerprint, std::string_view data) {
+    Writer writer;
+    writer.out.reserve(kBlobHeaderSize + data.size());
+    writer.out.append(kBlobMagic, sizeof(kBlobMagic));
+    writer.fixed(kFormatVersion, 4);
+    writer.fixed(fingerprint, 8);
+    writer.fixed(hash_bytes(data), 8);
+    writer.out += data;
+    return std::move(writer.out);
+}
+
+bool decode_blob(std::string_view data, uint64_t fingerprint, std::string *blob) {
+    if (data.size() < kBlobHeaderSize || data.compare(0, sizeof(kBlobMagic), kBlobMagic, sizeof(kBlobMagic)) != 0) {
+        return false;
+    }
+    Reader reader(data.substr(sizeof(kBlobMagic)));
+    uint64_t format, entry_fingerprint, hash;
+    if (!reader.fixed(&format, 4) || format != kFormatVersion || !reader.fixed(&entry_fingerprint, 8) ||
+        entry_fingerprint != fingerprint || !reader.fixed(&hash, 8) ||
+        hash != hash_bytes(data.substr(kBlobHeaderSize))) {
+        return false;
+    }
+    blob->assign(data.substr(kBlobHeaderSize));
+    return true;
+}
+
+} // namespace
+
+uint64_t ParseCache::grammar_fingerprint() {
+    const TSLanguage *language = tree_sitter_wxml();
+    const TSLanguageMetadata *metadata = ts_language_metadata(language);
+    Writer writer;
+    writer.varint(kFormatVersion);
+    writer.varint(ts_language_abi_version(language));
+    writer.varint(ts_language_symbol_count(language));
+    writer.varint(ts_language_state_count(language));
+    if (metadata != nullptr) {
+        writer.varint(metadata->major_version);
+        writer.varint(metadata->minor_version);
+        writer.varint(metadata->patch_version);
+    }
+    return hash_bytes(writer.out);
+}
+
+ParseCache::ParseCache(std::string dir, uint64_t max_bytes)
+    : dir_(std::move(dir)), max_bytes_(max_bytes), fingerprint_(grammar_fingerprint()) {}
+
+uint64_t ParseCache::key(std::string_view content) const { return hash_bytes(content, fingerprint_); }
+
+std::string ParseCache::entry_path(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%02x/%014llx.sum", static_cast<unsigned>(key >> 56),
+                  static_cast<unsigned long long>(key & 0x00ffffffffffffffULL));
+    return dir_ + name;
+}
+
+uint64_t ParseCache::key(std::string_view content, uint64_t salt) const {
+    return hash_bytes(content, fingerprint_ ^ detail::finalize(salt + 1));
+}
+
+// Marks the entry at `path` as just used.
+void ParseCache::touch(const std::string &path) {
+    utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ParseCache::write_entry(uint64_t key, std::string_view data) {
+    std::string path = entry_path(key);
+    std::string temporary = path + ".tmp." + std::to_string(getpid()) + "." +
+                            std::to_string(temporaries_.fetch_add(1, std::memory_order_relaxed));
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+            out.close();
+            std::remove(temporary.c_str());
+            return;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return;
+    }
+    stores_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool ParseCache::load(uint64_t key, FileSummary *summary) {
+    std::string path = entry_path(key);
+    MappedFile file;
+    if (!file.open(path) || !decode(file.data(), fingerprint_, summary)) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    touch(path);
+    return true;
+}
+
+void ParseCache::store(uint64_t key, const FileSummary &summary) { write_entry(key, encode(fingerprint_, summary)); }
+
+bool ParseCache::load(uint64_t key, std::string *data) {
+    std::string path = entry_path(key);
+    MappedFile file;
+    if (!file.open(path) || !decode_blob(file.data(), fingerprint_, data)) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    touch(path);
+    return true;
+}
+
+void ParseCache::store(uint64_t key, std::string_view data) { write_entry(key, encode_blob(fingerprint_, data)); }
+
+void ParseCache::trim() {
+    namespace fs = std::filesystem;
+    struct Entry {
+        fs::file_time_type used;
+        uint64_t size;
+        fs::path path;
+    };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    fs::file_time_type stale = fs::file_time_type::clock::now() - kTemporaryGrace;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(dir_, ec), end; it != end; it.increment(ec)) {
+        if (ec) {
+            break;
+        }
+        bool temporary = it->path().filename().string().find(".sum.tmp.") != std::string::npos;
+        if ((!temporary && it->path().extension() != ".sum") || !it->is_regular_file(ec)) {
+            continue;
+        }
+        Entry entry{it->last_write_time(ec), it->file_size(ec), it->path()};
+        if (ec) {
+            continue;
+        }
+        if (!temporary) {
+            total += entry.size;
+            entries.push_back(std::move(entry));
+        } else if (entry.used < stale && fs::remove(entry.path, ec)) {
+            // Left behind by a writer that died between writing and renaming.
+            evicted_++;
+            evicted_bytes_ += entry.size;
+        } else {
+            // Possibly still being written; it takes space all the same.
+            total += entry.size;
+        }
+    }
+
+    entries_ = entries.size();
+    bytes_ = total;
+    if (total <= max_bytes_) {
+        return;
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.used < b.used; });
+    for (const Entry &entry : entries) {
+        if (bytes_ <= max_bytes_) {
+            break;
+        }
+        if (fs::remove(entry.path, ec)) {
+            bytes_ -= entry.size;
+            entries_--;
+            evicted_++;
+            evicted_bytes_ += entry.size;
+        }
+    }
+}
+
+std::string to_string(const CacheReport &report) {
+    uint64_t lookups = report.hits + report.misses;
+    char line[256];
+    std::snprintf(line, sizeof(line),
+                  "cache: %llu hits, %llu misses (%.1f%% hit rate), %llu stored, %llu evicted (%.1f MB), "
+                  "%llu entries (%.1f MB)",
+                  static_cast<unsigned long long>(report.hits), static_cast<unsigned long long>(report.misses),
+                  lookups > 0 ? 100.0 * static_cast<double>(report.hits) / static_cast<double>(lookups) : 0.0,
+                  static_cast<unsigned long long>(report.stores), static_cast<unsigned long long>(report.evicted),
+                  static_cast<double>(report.evicted_bytes) / 1e6, static_cast<unsigned long long>(report.entries),
+                  static_cast<double>(report.bytes) / 1e6);
+    return line;
+}
+
+CacheReport ParseCache::report() const {
+    CacheReport report;
+    report.hits = hits_.load();
+    report.misses = misses_.load();
+    report.stores = stores_.load();
+    report.evicted = evicted_;
+    report.evicted_bytes = evicted_bytes_;
+    report.entries = entries_;
+    report.bytes = bytes_;
+    return report;
+}
+
+} // namespace wxml
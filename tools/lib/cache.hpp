@@ -0,0 +1,86 @@
+#ifndef WXML_TOOLS_CACHE_HPP_
+#define WXML_TOOLS_CACHE_HPP_
+
+#include "summary.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace wxml {
+
+struct CacheReport {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stores = 0;
+    uint64_t evicted = 0;       // entries and stale temporaries removed by trim()
+    uint64_t evicted_bytes = 0;
+    uint64_t entries = 0;       // left after the last trim()
+    uint64_t bytes = 0;
+};
+
+// The report as the one line the tools print after a run, without a newline.
+std::string to_string(const CacheReport &report);
+
+// An on-disk cache of file summaries, and of other per-file results such as
+// compiled output, addressed by content. Keys hash the
+// file contents together with a fingerprint of the grammar (ABI, grammar
+// version, symbol and state counts) and of the entry format, so entries
+// written by another grammar are never found rather than being
+// misinterpreted.
+//
+// Entries live in `dir/xx/<key>.sum`, are written to a temporary file and
+// renamed into place, and are read back through a memory mapping, so
+// processes and threads can share one directory without locks. A hit
+// touches the entry's mtime, and trim() evicts the least recently used
+// entries until the cache fits in `max_bytes`, after removing temporary
+// files that writers which died before renaming left behind.
+class ParseCache {
+  public:
+    ParseCache(std::string dir, uint64_t max_bytes);
+    ParseCache(const ParseCache &) = delete;
+    ParseCache &operator=(const ParseCache &) = delete;
+
+    uint64_t key(std::string_view content) const;
+
+    // The key of another kind of result for `content`. `salt` identifies
+    // the kind and the version of whatever produces it, so that a new
+    // version misses instead of reading stale results.
+    uint64_t key(std::string_view content, uint64_t salt) const;
+
+    // Fills `summary` (except its path) from the entry for `key`. Missing,
+    // truncated or foreign entries count as misses.
+    bool load(uint64_t key, FileSummary *summary);
+
+    // Records `summary` under `key`. Failures are ignored: the cache is an
+    // optimization, never a source of truth.
+    void store(uint64_t key, const FileSummary &summary);
+
+    // Opaque entries for keys made with a salt, checked against a hash of
+    // their data on load.
+    bool load(uint64_t key, std::string *data);
+    void store(uint64_t key, std::string_view data);
+
+    // Evicts least recently used entries until the cache fits its bound.
+    void trim();
+
+    CacheReport report() const;
+
+    static uint64_t grammar_fingerprint();
+
+  private:
+    std::string entry_path(uint64_t key) const;
+    void touch(const std::string &path);
+    void write_entry(uint64_t key, std::string_view data);
+
+    std::string dir_;
+    uint64_t max_bytes_;
+    uint64_t fingerprint_;
+    std::atomic<uint64_t> hits_{0}, misses_{0}, stores_{0}, temporaries_{0};
+    uint64_t evicted_ = 0, evicted_bytes_ = 0, entries_ = 0, bytes_ = 0;
+};
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_CACHE_HPP_
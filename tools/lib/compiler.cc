@@ -0,0 +1,887 @@
+#include "compiler.hpp"
+
+#include "json.hpp"
+#include "mapped_file.hpp"
+#include "nodes.hpp"
+#include "summary.hpp"
+#include "work_stealing.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
+
+namespace wxml {
+
+namespace {
+
+bool is_ident_start(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$' ||
+           static_cast<unsigned char>(c) >= 0x80;
+}
+
+bool is_ident(char c) { return is_ident_start(c) || (c >= '0' && c <= '9'); }
+
+bool is_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+// Names that an expression may use without them being page data.
+bool is_reserved(std::string_view name) {
+    static constexpr std::string_view reserved[] = {
+        "true", "false", "null", "undefined", "NaN", "Infinity", "typeof", "instanceof", "in", "void",
+    };
+    for (std::string_view word : reserved) {
+        if (name == word) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Property names that lead from any object to Function, and so to running
+// code of an expression's own making.
+bool is_forbidden(std::string_view name) {
+    return name == "constructor" || name == "__proto__" || name == "prototype" || name == "__defineGetter__" ||
+           name == "__defineSetter__" || name == "__lookupGetter__" || name == "__lookupSetter__";
+}
+
+// Whether `name` can be spliced into the generated code as a variable or
+// property name. Only plain ASCII names are accepted, and none starting
+// with `$`, which the generated code keeps for its own variables.
+bool is_identifier(std::string_view name) {
+    static constexpr std::string_view keywords[] = {
+        "arguments", "await", "break", "case", "catch", "class", "const", "continue", "debugger", "default",
+        "delete", "do", "else", "enum", "eval", "export", "extends", "finally", "for", "function", "if",
+        "implements", "import", "interface", "let", "new", "package", "private", "protected", "public", "return",
+        "static", "super", "switch", "this", "throw", "try", "var", "while", "with", "yield",
+    };
+    if (name.empty() || (name[0] >= '0' && name[0] <= '9')) {
+        return false;
+    }
+    for (char c : name) {
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_')) {
+            return false;
+        }
+    }
+    return !is_reserved(name) && std::find(std::begin(keywords), std::end(keywords), name) == std::end(keywords);
+}
+
+bool is_directive(std::string_view name) {
+    return name == "wx:if" || name == "wx:elif" || name == "wx:else" || name == "wx:for" || name == "wx:for-items" ||
+           name == "wx:for-item" || name == "wx:for-index" || name == "wx:key";
+}
+
+void append_utf8(std::string &out, uint32_t code) {
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xc0 | code >> 6);
+        out += static_cast<char>(0x80 | (code & 0x3f));
+    } else if (code < 0x10000) {
+        out += static_cast<char>(0xe0 | code >> 12);
+        out += static_cast<char>(0x80 | (code >> 6 & 0x3f));
+        out += static_cast<char>(0x80 | (code & 0x3f));
+    } else {
+        out += static_cast<char>(0xf0 | code >> 18);
+        out += static_cast<char>(0x80 | (code >> 12 & 0x3f));
+        out += static_cast<char>(0x80 | (code >> 6 & 0x3f));
+        out += static_cast<char>(0x80 | (code & 0x3f));
+    }
+}
+
+// Appends the text an entity stands for, or the entity itself if it is not
+// one the runtime would decode either.
+void append_entity(std::string &out, std::string_view entity) {
+    std::string_view body = entity.substr(1);
+    if (!body.empty() && body.back() == ';') {
+        body.remove_suffix(1);
+    }
+    if (body.size() > 1 && body[0] == '#') {
+        bool hex = body[1] == 'x' || body[1] == 'X';
+        std::string digits(body.substr(hex ? 2 : 1));
+        char *end = nullptr;
+        unsigned long code = std::strtoul(digits.c_str(), &end, hex ? 16 : 10);
+        if (!digits.empty() && *end == '\0' && code > 0 && code <= 0x10ffff) {
+            append_utf8(out, static_cast<uint32_t>(code));
+            return;
+        }
+    }
+    static constexpr std::pair<std::string_view, uint32_t> named[] = {
+        {"amp", '&'}, {"lt", '<'}, {"gt", '>'}, {"quot", '"'}, {"apos", '\''}, {"nbsp", 0xa0},
+    };
+    for (const auto &[name, code] : named) {
+        if (body == name) {
+            append_utf8(out, code);
+            return;
+        }
+    }
+    out += entity;
+}
+
+// The tag that carries a node's attributes.
+TSNode tag_of(TSNode node) {
+    TSSymbol kind = ts_node_symbol(node);
+    if (kind == symbol::import_statement || kind == symbol::include_statement) {
+        return node;
+    }
+    return ts_node_child(node, 0);
+}
+
+// The value node of the attribute called `name`, a null node if the
+// attribute has no value, or the tag itself if there is no such attribute.
+TSNode find_attribute(TSNode tag, std::string_view source, std::string_view name, bool *found) {
+    for (uint32_t i = 0, n = ts_node_child_count(tag); i < n; i++) {
+        TSNode attribute = ts_node_child(tag, i);
+        if (ts_node_symbol(attribute) != symbol::attribute ||
+            node_text(ts_node_child(attribute, 0), source) != name) {
+            continue;
+        }
+        *found = true;
+        uint32_t count = ts_node_child_count(attribute);
+        return count > 1 ? ts_node_child(attribute, count - 1) : TSNode{};
+    }
+    *found = false;
+    return TSNode{};
+}
+
+} // namespace
+
+struct Compiler::Scope {
+    const Scope *parent = nullptr;
+    std::string_view item;
+    std::string_view index;
+
+    bool binds(std::string_view name) const {
+        for (const Scope *scope = this; scope != nullptr; scope = scope->parent) {
+            if (scope->item == name || scope->index == name) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+namespace {
+
+// A compiled child, before its siblings decide whether it is hoisted.
+struct Item {
+    std::string code;
+    bool is_static = false;
+    bool hoistable = false; // an element or block, rather than text
+};
+
+} // namespace
+
+bool Compiler::compile(TSNode root, std::string_view source, std::string &out) {
+    out.clear();
+    if (ts_node_has_error(root)) {
+        return false;
+    }
+    source_ = source;
+    templates_.clear();
+    modules_.clear();
+    hoisted_.clear();
+    definitions_.clear();
+    imports_.clear();
+    wxs_.clear();
+    warnings_.clear();
+
+    // Collect what expressions and template calls anywhere in the file may
+    // refer to before compiling any of them.
+    std::vector<TSNode> definitions;
+    for (TSNode node : Preorder<symbol::import_statement, symbol::template_element, symbol::wxs_element,
+                                symbol::self_closing_tag>(root)) {
+        TSSymbol kind = ts_node_symbol(node);
+        TSNode tag = kind == symbol::self_closing_tag || kind == symbol::import_statement ? node : tag_of(node);
+        if (kind == symbol::self_closing_tag && node_text(ts_node_named_child(tag, 0), source) != "wxs") {
+            continue;
+        }
+        if (kind == symbol::import_statement) {
+            std::string load = "$h.load(";
+            append_json_string(load, attribute_value(tag, source, "src"));
+            imports_.push_back(load + ")");
+        } else if (kind == symbol::template_element) {
+            std::string_view name = attribute_value(tag, source, "name");
+            if (!name.empty()) {
+                templates_.emplace_back(name);
+                definitions.push_back(node);
+            }
+        } else {
+            std::string_view module = attribute_value(tag, source, "module");
+            if (module.empty()) {
+                warn(node, "wxs without a module name");
+                continue;
+            }
+            if (!is_identifier(module)) {
+                warn(node, "wxs module name is not an identifier; the module is skipped");
+                continue;
+            }
+            modules_.emplace_back(module);
+            std::string init = "$m.";
+            init += module;
+            std::string_view src = attribute_value(tag, source, "src");
+            if (!src.empty()) {
+                init += " = $h.wxs(";
+                append_json_string(init, src);
+                init += ");";
+            } else {
+                TSNode code = kind == symbol::wxs_element ? ts_node_child(node, 1) : TSNode{};
+                init += " = (function () {\nvar module = {exports: {}};\nvar exports = module.exports;\n";
+                if (!ts_node_is_null(code) && ts_node_symbol(code) == symbol::raw_text) {
+                    init += node_text(code, source);
+                }
+                init += "\nreturn module.exports;\n})();";
+            }
+            wxs_.push_back(std::move(init));
+        }
+    }
+
+    for (TSNode node : definitions) {
+        define_template(node);
+    }
+    Scope scope;
+    std::string render = children(root, scope);
+
+    out += "\"use strict\";\n";
+    for (const std::string &warning : warnings_) {
+        out += "// warning: " + warning + "\n";
+    }
+    out += "module.exports = function ($h) {\n    var $m = {};\n";
+    for (const std::string &init : wxs_) {
+        out += "    " + init + "\n";
+    }
+    out += "    var $i = [";
+    for (size_t i = 0; i < imports_.size(); i++) {
+        out += (i > 0 ? ", " : "") + imports_[i];
+    }
+    out += "];\n";
+    for (size_t i = 0; i < hoisted_.size(); i++) {
+        out += "    var $s" + std::to_string(i) + " = " + hoisted_[i] + ";\n";
+    }
+    out += "    var $t = {};\n";
+    for (size_t i = 0; i + 1 < definitions_.size(); i += 2) {
+        out += "    $t[" + definitions_[i] + "] = " + definitions_[i + 1] + ";\n";
+    }
+    out += "    function $tpl(name, $d) {\n"
+           "        var f = $t[name];\n"
+           "        for (var k = 0; !f && k < $i.length; k++) f = $i[k].templates[name];\n"
+           "        return f ? f($d || {}) : null;\n"
+           "    }\n";
+    out += "    return {render: function ($d) { return " + render + "; }, templates: $t};\n};\n";
+    return true;
+}
+
+void Compiler::define_template(TSNode node) {
+    std::string name;
+    append_json_string(name, attribute_value(tag_of(node), source_, "name"));
+    Scope scope;
+    definitions_.push_back(std::move(name));
+    definitions_.push_back("function ($d) { return " + children(node, scope) + "; }");
+}
+
+// Compiles the child nodes of `parent` into an array literal, hoisting the
+// static elements among them.
+std::string Compiler::children(TSNode parent, const Scope &scope, bool *is_static) {
+    std::vector<Item> items;
+    std::string run;     // the text run being built
+    bool run_dynamic = false;
+    bool in_run = false;
+    uint32_t run_end = 0;
+    // The wx:if chain being built: conditions and branches.
+    std::vector<std::pair<std::string, std::string>> chain;
+
+    auto end_run = [&] {
+        if (in_run) {
+            run += '"';
+            // Drop the empty literals around interpolations at the ends.
+            if (run_dynamic && run.compare(0, 5, "\"\" + ") == 0) {
+                run.erase(0, 5);
+            }
+            if (run_dynamic && run.size() > 5 && run.compare(run.size() - 5, 5, " + \"\"") == 0) {
+                run.resize(run.size() - 5);
+            }
+            items.push_back({"$h.text(" + run + ")", !run_dynamic, false});
+            in_run = false;
+        }
+    };
+    auto end_chain = [&] {
+        if (chain.empty()) {
+            return;
+        }
+        std::string code;
+        for (auto &[condition, branch] : chain) {
+            if (condition.empty()) {
+                code += branch;
+                break;
+            }
+            code += condition + " ? " + branch + " : ";
+        }
+        if (!chain.back().first.empty()) {
+            code += "null";
+        }
+        items.push_back({std::move(code), false, false});
+        chain.clear();
+    };
+    // Extends the literal text run with `literal` or an interpolated value.
+    auto add_literal = [&](std::string_view literal) {
+        std::string quoted;
+        append_json_string(quoted, literal);
+        run += quoted.substr(1, quoted.size() - 2);
+    };
+    auto add_value = [&](const std::string &code) {
+        run += "\" + $h.str(" + code + ") + \"";
+        run_dynamic = true;
+    };
+
+    for (uint32_t i = 0, n = ts_node_child_count(parent); i < n; i++) {
+        TSNode child = ts_node_child(parent, i);
+        TSSymbol kind = ts_node_symbol(child);
+        if (!ts_node_is_named(child) || kind == symbol::comment || kind == symbol::start_tag ||
+            kind == symbol::end_tag || kind == symbol::template_start_tag || kind == symbol::template_end_tag ||
+            kind == symbol::slot_start_tag || kind == symbol::slot_end_tag || kind == symbol::block_start_tag ||
+            kind == symbol::block_end_tag) {
+            continue;
+        }
+
+        if (kind == symbol::text || kind == symbol::entity || kind == symbol::interpolation) {
+            end_chain();
+            if (!in_run) {
+                run = "\"";
+                run_dynamic = false;
+                in_run = true;
+            } else if (ts_node_start_byte(child) > run_end) {
+                run += ' ';
+            }
+            if (kind == symbol::text) {
+                add_literal(node_text(child, source_));
+            } else if (kind == symbol::entity) {
+                std::string decoded;
+                append_entity(decoded, node_text(child, source_));
+                add_literal(decoded);
+            } else {
+                add_value(interpolation(child, scope));
+            }
+            run_end = ts_node_end_byte(child);
+            continue;
+        }
+        end_run();
+
+        TSNode tag = tag_of(child);
+        bool has_if, has_elif, has_else, has_for, has_items;
+        TSNode if_value = find_attribute(tag, source_, "wx:if", &has_if);
+        TSNode elif_value = find_attribute(tag, source_, "wx:elif", &has_elif);
+        find_attribute(tag, source_, "wx:else", &has_else);
+        TSNode for_value = find_attribute(tag, source_, "wx:for", &has_for);
+        if (!has_for) {
+            for_value = find_attribute(tag, source_, "wx:for-items", &has_items);
+            has_for = has_items;
+        }
+
+        Scope inner{&scope, "item", "index"};
+        const Scope &body_scope = has_for ? inner : scope;
+        if (has_for) {
+            std::string_view item = attribute_value(tag, source_, "wx:for-item");
+            std::string_view index = attribute_value(tag, source_, "wx:for-index");
+            if (!item.empty() && !is_identifier(item)) {
+                warn(tag, "wx:for-item is not an identifier; using item");
+                item = {};
+            }
+            if (!index.empty() && !is_identifier(index)) {
+                warn(tag, "wx:for-index is not an identifier; using index");
+                index = {};
+            }
+            inner.item = item.empty() ? "item" : item;
+            inner.index = index.empty() ? "index" : index;
+        }
+
+        bool is_static = false;
+        std::string code = node(child, body_scope, &is_static);
+        if (code.empty()) {
+            continue;
+        }
+        bool hoistable = kind != symbol::include_statement;
+        if (is_static && hoistable && (has_if || has_elif || has_else || has_for)) {
+            // The directives make the node dynamic, but what they show is not.
+            code = hoist(std::move(code));
+        }
+
+        if (has_for) {
+            bool dummy;
+            if (has_if) {
+                code = value(if_value, body_scope, &dummy) + " ? " + code + " : null";
+            }
+            std::string key;
+            append_json_string(key, attribute_value(tag, source_, "wx:key"));
+            code = "$h.list(" + value(for_value, scope, &dummy) + ", function (" + std::string(inner.item) + ", " +
+                   std::string(inner.index) + ") { return " + code + "; }, " + key + ")";
+            end_chain();
+            items.push_back({std::move(code), false, false});
+            continue;
+        }
+
+        bool dummy;
+        if (has_if) {
+            end_chain();
+            chain.emplace_back(value(if_value, scope, &dummy), std::move(code));
+        } else if (has_elif || has_else) {
+            if (chain.empty() || chain.back().first.empty()) {
+                warn(child, has_elif ? "wx:elif without a wx:if before it" : "wx:else without a wx:if before it");
+                end_chain();
+                if (has_elif) {
+                    chain.emplace_back(value(elif_value, scope, &dummy), std::move(code));
+                } else {
+                    items.push_back({std::move(code), false, false});
+                }
+            } else {
+                chain.emplace_back(has_elif ? value(elif_value, scope, &dummy) : std::string(), std::move(code));
+            }
+        } else {
+            end_chain();
+            items.push_back({std::move(code), is_static, hoistable});
+        }
+    }
+    end_run();
+    end_chain();
+
+    bool all_static = true;
+    for (const Item &item : items) {
+        all_static = all_static && item.is_static;
+    }
+    std::string list = "[";
+    for (size_t i = 0; i < items.size(); i++) {
+        list += i > 0 ? ", " : "";
+        // A static child of a dynamic list is built once; a static list is
+        // left whole for the element it belongs to, if any, to hoist.
+        list += (!all_static || is_static == nullptr) && items[i].is_static && items[i].hoistable ? hoist(std::move(items[i].code))
+                                                                         : items[i].code;
+    }
+    list += "]";
+    if (is_static != nullptr) {
+        *is_static = all_static;
+    }
+    return list;
+}
+
+// Compiles one node, ignoring its directives. Returns an empty string for
+// nodes that render nothing where they are.
+std::string Compiler::node(TSNode node, const Scope &scope, bool *is_static) {
+    *is_static = false;
+    TSNode tag = tag_of(node);
+    switch (ts_node_symbol(node)) {
+        case symbol::element: {
+            std::string_view name = node_text(ts_node_named_child(tag, 0), source_);
+            if (ts_node_symbol(tag) == symbol::self_closing_tag) {
+                if (name == "wxs") {
+                    return {};
+                }
+                if (name == "template") {
+                    return call_template(tag, scope);
+                }
+                if (name == "slot") {
+                    std::string slot = "$h.slot(";
+                    append_json_string(slot, attribute_value(tag, source_, "name"));
+                    return slot + ", [])";
+                }
+            }
+            return element(node, tag, scope, is_static);
+        }
+        case symbol::template_element:
+            if (!attribute_value(tag, source_, "name").empty()) {
+                return {};
+            }
+            return call_template(tag, scope);
+        case symbol::slot_element: {
+            std::string slot = "$h.slot(";
+            append_json_string(slot, attribute_value(tag, source_, "name"));
+            return slot + ", " + children(node, scope) + ")";
+        }
+        case symbol::block_element: {
+            return children(node, scope, is_static);
+        }
+        case symbol::include_statement: {
+            std::string include = "$h.include(";
+            append_json_string(include, attribute_value(tag, source_, "src"));
+            return include + ", $d)";
+        }
+        default:
+            // wxs and import were handled up front.
+            return {};
+    }
+}
+
+std::string Compiler::element(TSNode node, TSNode tag, const Scope &scope, bool *is_static) {
+    bool attrs_static = true;
+    std::string code = "$h.el(";
+    append_json_string(code, node_text(ts_node_named_child(tag, 0), source_));
+    code += ", " + attributes(tag, scope, &attrs_static) + ", ";
+    if (ts_node_symbol(tag) == symbol::self_closing_tag) {
+        *is_static = attrs_static;
+        return code + "[])";
+    }
+    bool children_static = false;
+    code += children(node, scope, &children_static);
+    *is_static = attrs_static && children_static;
+    return code + ")";
+}
+
+std::string Compiler::call_template(TSNode tag, const Scope &scope) {
+    bool found, dummy;
+    TSNode is = find_attribute(tag, source_, "is", &found);
+    std::string_view name = attribute_value(tag, source_, "is");
+    std::string call;
+    if (!found || ts_node_is_null(is)) {
+        warn(tag, "template without a name or is");
+        return {};
+    }
+    if (!is_dynamic(name) && std::find(templates_.begin(), templates_.end(), name) != templates_.end()) {
+        call = "$t[";
+        append_json_string(call, name);
+        call += "](";
+    } else {
+        call = "$tpl(" + value(is, scope, &dummy) + ", ";
+    }
+
+    // data="{{a: 1, ...b}}" is the inside of an object literal.
+    TSNode data = find_attribute(tag, source_, "data", &found);
+    if (!found || ts_node_is_null(data) || ts_node_symbol(data) != symbol::quoted_attribute_value) {
+        return call + "{})";
+    }
+    TSNode inner = ts_node_named_child(data, 0);
+    if (ts_node_named_child_count(data) != 1 || ts_node_symbol(inner) != symbol::interpolation ||
+        ts_node_start_byte(inner) != ts_node_start_byte(data) + 1 || ts_node_end_byte(inner) + 1 != ts_node_end_byte(data)) {
+        warn(data, "template data is not a single {{...}}");
+        return call + "{})";
+    }
+    uint32_t start = ts_node_end_byte(ts_node_child(inner, 0));
+    uint32_t end = ts_node_start_byte(ts_node_child(inner, ts_node_child_count(inner) - 1));
+    std::string object = "{";
+    object += source_.substr(start, end - start);
+    object += "}";
+    std::string code;
+    if (!expression(object, scope, &code)) {
+        warn(data, "template data is not a valid expression; passing {}");
+        return call + "{})";
+    }
+    return call + code + ")";
+}
+
+std::string Compiler::attributes(TSNode tag, const Scope &scope, bool *is_static) {
+    *is_static = true;
+    std::string object = "{";
+    for (uint32_t i = 0, n = ts_node_child_count(tag); i < n; i++) {
+        TSNode attribute = ts_node_child(tag, i);
+        if (ts_node_symbol(attribute) != symbol::attribute) {
+            continue;
+        }
+        std::string_view name = node_text(ts_node_child(attribute, 0), source_);
+        if (is_directive(name)) {
+            continue;
+        }
+        object += object.size() > 1 ? ", " : "";
+        append_json_string(object, name);
+        object += ": ";
+        uint32_t count = ts_node_child_count(attribute);
+        bool constant = true;
+        object += value(count > 1 ? ts_node_child(attribute, count - 1) : TSNode{}, scope, &constant);
+        *is_static = *is_static && constant;
+    }
+    return object + "}";
+}
+
+// Compiles an attribute value: a lone {{...}} keeps the type of its
+// expression, anything else is a string.
+std::string Compiler::value(TSNode value, const Scope &scope, bool *is_static) {
+    *is_static = true;
+    if (ts_node_is_null(value)) {
+        return "true";
+    }
+    std::string code;
+    if (ts_node_symbol(value) != symbol::quoted_attribute_value) {
+        append_json_string(code, node_text(value, source_));
+        return code;
+    }
+    uint32_t start = ts_node_start_byte(value) + 1;
+    uint32_t end = ts_node_end_byte(value) - 1;
+    uint32_t count = ts_node_named_child_count(value);
+    if (count == 1) {
+        TSNode inner = ts_node_named_child(value, 0);
+        if (ts_node_symbol(inner) == symbol::interpolation && ts_node_start_byte(inner) == start &&
+            ts_node_end_byte(inner) == end) {
+            *is_static = false;
+            return "(" + interpolation(inner, scope) + ")";
+        }
+    }
+    std::string literal;
+    uint32_t last = start;
+    auto flush = [&] {
+        if (!literal.empty() || code.empty()) {
+            code += code.empty() ? "" : " + ";
+            append_json_string(code, literal);
+            literal.clear();
+        }
+    };
+    for (uint32_t i = 0; i < count; i++) {
+        TSNode inner = ts_node_named_child(value, i);
+        literal += source_.substr(last, ts_node_start_byte(inner) - last);
+        last = ts_node_end_byte(inner);
+        if (ts_node_symbol(inner) == symbol::entity) {
+            append_entity(literal, node_text(inner, source_));
+        } else if (ts_node_symbol(inner) == symbol::interpolation) {
+            flush();
+            code += " + $h.str(" + interpolation(inner, scope) + ")";
+            *is_static = false;
+        }
+    }
+    literal += source_.substr(last, end - last);
+    flush();
+    return code;
+}
+
+std::string Compiler::interpolation(TSNode node, const Scope &scope) {
+    uint32_t count = ts_node_child_count(node);
+    uint32_t start = ts_node_end_byte(ts_node_child(node, 0));
+    uint32_t end = count > 1 ? ts_node_start_byte(ts_node_child(node, count - 1)) : start;
+    std::string code;
+    if (!expression(source_.substr(start, end - start), scope, &code)) {
+        warn(node, "expression is unbalanced or uses something it may not; using undefined");
+        return "undefined";
+    }
+    size_t first = code.find_first_not_of(" \t\r\n");
+    return first == std::string::npos ? "undefined" : code;
+}
+
+// Rewrites the free names of a WXML expression into reads of page data or
+// wxs modules. Names after a `.`, object keys, literals and wx:for variables
+// are kept, and {a} shorthand becomes {a: d.a}.
+//
+// Returns false for an expression that could reach out of the slot it is
+// spliced into, or run code of its own: unbalanced brackets, a `,` or `;`
+// outside of them, comments, template literals, assignments and arrows,
+// and the names that lead from any object to Function.
+bool Compiler::expression(std::string_view code, const Scope &scope, std::string *out) {
+    out->clear();
+    char previous = 0;       // the last character written that is not whitespace
+    std::string brackets;    // the open (, [ and {
+    for (size_t i = 0; i < code.size();) {
+        char c = code[i];
+        char next = i + 1 < code.size() ? code[i + 1] : 0;
+        if (c == '"' || c == '\'') {
+            size_t j = i + 1;
+            while (j < code.size() && code[j] != c) {
+                j += code[j] == '\\' ? 2 : 1;
+            }
+            if (j >= code.size()) {
+                return false;
+            }
+            std::string_view text = code.substr(i + 1, j - i - 1);
+            if (previous == '[' && (is_forbidden(text) || text.find('\\') != std::string_view::npos)) {
+                return false;
+            }
+            *out += code.substr(i, j + 1 - i);
+            previous = c;
+            i = j + 1;
+        } else if ((c >= '0' && c <= '9') || (c == '.' && next >= '0' && next <= '9' && previous != '.')) {
+            size_t j = i;
+            while (j < code.size() && (is_ident(code[j]) || code[j] == '.')) {
+                j++;
+            }
+            *out += code.substr(i, j - i);
+            previous = '0';
+            i = j;
+        } else if (is_ident_start(c)) {
+            size_t j = i;
+            while (j < code.size() && is_ident(code[j])) {
+                j++;
+            }
+            std::string_view name = code.substr(i, j - i);
+            if (is_forbidden(name)) {
+                return false;
+            }
+            size_t after = j;
+            while (after < code.size() && is_space(code[after])) {
+                after++;
+            }
+            char following = after < code.size() ? code[after] : 0;
+            bool spread = out->size() >= 3 && out->compare(out->size() - 3, 3, "...") == 0;
+            bool member = previous == '.' && !spread;
+            bool in_object = !brackets.empty() && brackets.back() == '{' && (previous == '{' || previous == ',');
+            std::string rewritten;
+            if (is_reserved(name) || scope.binds(name)) {
+                rewritten = name;
+            } else if (std::find(modules_.begin(), modules_.end(), name) != modules_.end()) {
+                rewritten = "$m." + std::string(name);
+            } else {
+                rewritten = "$d." + std::string(name);
+            }
+            if (member || (in_object && following == ':')) {
+                *out += name;
+            } else if (in_object && (following == ',' || following == '}')) {
+                *out += std::string(name) + ": " + rewritten;
+            } else {
+                *out += rewritten;
+            }
+            previous = 'a';
+            i = j;
+        } else {
+            if (c == '(' || c == '[' || c == '{') {
+                brackets += c;
+            } else if (c == ')' || c == ']' || c == '}') {
+                char open = c == ')' ? '(' : c == ']' ? '[' : '{';
+                if (brackets.empty() || brackets.back() != open) {
+                    return false;
+                }
+                brackets.pop_back();
+            } else if ((c == ',' && brackets.empty()) || c == ';' || c == '`' || c == '\\' ||
+                       (c == '/' && (next == '/' || next == '*')) || ((c == '+' || c == '-') && next == c)) {
+                return false;
+            } else if (c == '=' && next != '=') {
+                // Only the = of a comparison: ==, ===, !=, !==, <= and >=,
+                // but not <<= or >>=.
+                char before = i > 0 ? code[i - 1] : 0;
+                char twice = i > 1 ? code[i - 2] : 0;
+                if (!(before == '=' || before == '!' || ((before == '<' || before == '>') && twice != before))) {
+                    return false;
+                }
+            }
+            *out += c;
+            if (!is_space(c)) {
+                previous = c;
+            }
+            i++;
+        }
+    }
+    return brackets.empty();
+}
+
+// Moves `code` out of the render functions, sharing it with any identical
+// subtree hoisted before.
+std::string Compiler::hoist(std::string code) {
+    auto found = std::find(hoisted_.begin(), hoisted_.end(), code);
+    size_t index = static_cast<size_t>(found - hoisted_.begin());
+    if (found == hoisted_.end()) {
+        hoisted_.push_back(std::move(code));
+    }
+    return "$s" + std::to_string(index);
+}
+
+void Compiler::warn(TSNode node, std::string_view message) {
+    TSPoint point = ts_node_start_point(node);
+    warnings_.push_back(std::to_string(point.row + 1) + ":" + std::to_string(point.column + 1) + ": " +
+                        std::string(message));
+}
+
+namespace {
+
+bool write_file(const std::string &path, std::string_view data) {
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    while (!data.empty()) {
+        ssize_t written = ::write(fd, data.data(), data.size());
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            int saved = errno;
+            ::close(fd);
+            errno = saved;
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(written));
+    }
+    return ::close(fd) == 0;
+}
+
+// Cached modules are stored after a line with the number of subtrees
+// hoisted out of them. Warnings need no room of their own: they are the
+// "// warning: " lines at the top of the module.
+std::string cache_entry(size_t hoisted, std::string_view module) {
+    std::string entry = std::to_string(hoisted) + "\n";
+    entry += module;
+    return entry;
+}
+
+// Splits a cached entry into its module and the counts compilation left in
+// `result`. Returns false for entries not written by cache_entry().
+bool read_cache_entry(std::string_view entry, std::string_view *module, CompileResult *result) {
+    size_t newline = entry.find('\n');
+    if (newline == 0 || newline == std::string_view::npos ||
+        entry.find_first_not_of("0123456789") != newline) {
+        return false;
+    }
+    result->hoisted = std::strtoull(std::string(entry.substr(0, newline)).c_str(), nullptr, 10);
+    *module = entry.substr(newline + 1);
+
+    constexpr std::string_view prefix = "// warning: ";
+    size_t line = module->find('\n');
+    result->warnings.clear();
+    while (line != std::string_view::npos && module->compare(line + 1, prefix.size(), prefix) == 0) {
+        size_t start = line + 1 + prefix.size();
+        line = module->find('\n', start);
+        result->warnings.emplace_back(module->substr(start, line - start));
+    }
+    return true;
+}
+
+} // namespace
+
+std::vector<CompileResult> compile_files(const std::vector<std::string> &inputs,
+                                         const std::vector<std::string> &outputs, unsigned threads,
+                                         ParseCache *cache) {
+    if (threads == 0) {
+        threads = default_concurrency();
+    }
+    std::vector<CompileResult> results(inputs.size());
+    std::vector<Parser> parsers(threads);
+    std::vector<Compiler> compilers(threads);
+    std::vector<std::string> modules(threads);
+    parallel_for(inputs.size(), threads, [&](unsigned worker, size_t i) {
+        CompileResult &result = results[i];
+        MappedFile file;
+        if (!file.open(inputs[i])) {
+            result.failed = true;
+            result.error = errno;
+            return;
+        }
+        std::string_view source = file.data();
+        std::string &compiled = modules[worker];
+        std::string_view module;
+        uint64_t key = cache != nullptr ? cache->key(source, Compiler::version) : 0;
+        result.cached = cache != nullptr && cache->load(key, &compiled) && read_cache_entry(compiled, &module, &result);
+        if (!result.cached) {
+            Compiler &compiler = compilers[worker];
+            Tree tree = parsers[worker].parse(source);
+            result.has_error = !tree || !compiler.compile(tree.root(), source, compiled);
+            if (result.has_error) {
+                // An output left from an earlier run would look up to date.
+                if (!outputs.empty() && ::unlink(outputs[i].c_str()) != 0 && errno != ENOENT) {
+                    result.failed = true;
+                    result.error = errno;
+                }
+                return;
+            }
+            module = compiled;
+            result.hoisted = compiler.hoisted();
+            result.warnings = compiler.warnings();
+            if (cache != nullptr) {
+                cache->store(key, cache_entry(result.hoisted, module));
+            }
+        }
+        if (!outputs.empty() && !write_file(outputs[i], module)) {
+            result.failed = true;
+            result.error = errno;
+        }
+    });
+    return results;
+}
+
+} // namespace wxml
@@ -0,0 +1,113 @@
+#ifndef WXML_TOOLS_COMPILER_HPP_
+#define WXML_TOOLS_COMPILER_HPP_
+
+#include "cache.hpp"
+
+#include <tree_sitter/tree-sitter-wxml.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wxml {
+
+// Compiles a WXML file ahead of time into a CommonJS module of render
+// functions, so that nothing is interpreted at runtime:
+//
+//     module.exports = function (h) {
+//         ...
+//         return {render: function (d) { ... }, templates: {...}};
+//     };
+//
+// The module is called once with the runtime `h` and returns render(d),
+// which maps page data to an array of nodes, and the templates the file
+// defines, which imports of the file can call. Arrays nested in a child
+// list and null children are to be flattened away by the runtime:
+//
+//     h.el(tag, attrs, children)   an element
+//     h.text(string)               a text node
+//     h.str(value)                 the text of an interpolated value
+//     h.list(items, fn, key)       fn(item, index) for each item, keyed by
+//                                  the wx:key property ("*this" for the item)
+//     h.slot(name, fallback)       a component slot
+//     h.load(src)                  the module of an imported .wxml file
+//     h.include(src, d)            the nodes of an included .wxml file
+//     h.wxs(src)                   the exports of an external wxs module
+//
+// Interpolated expressions become plain JS that reads page data from `d`,
+// wx:for variables from function parameters and wxs modules from the
+// module, so no `with` or expression parser is needed at runtime. An
+// expression that would not stay inside its own slot of the generated code,
+// such as `a), (b` or one with a comment or assignment, or that names
+// `constructor` or `__proto__`, compiles to undefined with a warning.
+// That keeps a typo from changing the code around it; it is not a sandbox.
+// Templates are trusted like any other source of the app: keys computed
+// at runtime are not checked, and wxs module bodies are copied as written.
+// wx:if/wx:elif/wx:else chains become conditional expressions, and
+// maximal subtrees that depend on no data are built once, when the module
+// is instantiated, and shared by every render.
+class Compiler {
+  public:
+    // Changes whenever the generated code does; part of the cache key.
+    static constexpr uint64_t version = 2;
+
+    // Compiles the file whose syntax tree is rooted at `root` into `out`.
+    // Returns false, leaving `out` empty, if the tree has errors.
+    bool compile(TSNode root, std::string_view source, std::string &out);
+
+    // Problems found in the last file that did not stop compilation, such
+    // as a wx:else without a wx:if, as "line:column: message".
+    const std::vector<std::string> &warnings() const { return warnings_; }
+
+    // The number of subtrees hoisted out of the render functions in the
+    // last file.
+    size_t hoisted() const { return hoisted_.size(); }
+
+  private:
+    struct Scope;
+
+    std::string children(TSNode parent, const Scope &scope, bool *is_static = nullptr);
+    std::string node(TSNode node, const Scope &scope, bool *is_static);
+    std::string element(TSNode node, TSNode tag, const Scope &scope, bool *is_static);
+    std::string call_template(TSNode tag, const Scope &scope);
+    std::string attributes(TSNode tag, const Scope &scope, bool *is_static);
+    std::string value(TSNode value, const Scope &scope, bool *is_static);
+    std::string interpolation(TSNode node, const Scope &scope);
+    bool expression(std::string_view code, const Scope &scope, std::string *out);
+    std::string hoist(std::string code);
+    void define_template(TSNode node);
+    void warn(TSNode node, std::string_view message);
+
+    std::string_view source_;
+    std::vector<std::string> templates_;   // local template names
+    std::vector<std::string> modules_;     // wxs module names
+    std::vector<std::string> hoisted_;     // static subtrees
+    std::vector<std::string> definitions_; // "name", function pairs
+    std::vector<std::string> imports_;
+    std::vector<std::string> wxs_;         // module initializers
+    std::vector<std::string> warnings_;
+};
+
+struct CompileResult {
+    bool failed = false;    // could not be read or written; see `error`
+    bool has_error = false; // had syntax errors; its output was removed
+    bool cached = false;
+    size_t hoisted = 0;
+    std::vector<std::string> warnings;
+    int error = 0;
+};
+
+// Compiles `inputs` on a work-stealing pool, with one parser and compiler
+// per worker, writing each module to the same entry of `outputs`, or only
+// compiling if `outputs` is empty. The output of a file with syntax errors
+// is removed, so that one from an earlier run is not taken for its module.
+// With a cache, files whose contents were compiled before are not parsed at
+// all. Results are returned in the order of `inputs`.
+std::vector<CompileResult> compile_files(const std::vector<std::string> &inputs,
+                                         const std::vector<std::string> &outputs, unsigned threads = 0,
+                                         ParseCache *cache = nullptr);
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_COMPILER_HPP_
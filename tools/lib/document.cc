@@ -0,0 +1,360 @@
+#include "document.hpp"
+
+#include "linter.hpp"
+#include "nodes.hpp"
+#include "summary.hpp"
+
+#include <cstdlib>
+
+namespace wxml {
+
+namespace {
+
+// The number of UTF-16 code units in the UTF-8 sequence led by `lead`.
+uint32_t utf16_units(unsigned char lead) { return lead >= 0xf0 ? 2 : 1; }
+
+bool is_continuation(unsigned char byte) { return (byte & 0xc0) == 0x80; }
+
+Span span_of(TSNode node) { return Span{ts_node_start_byte(node), ts_node_end_byte(node)}; }
+
+// Sorts `ranges` and merges the ones that touch.
+std::vector<Span> normalize(std::vector<Span> ranges) {
+    std::sort(ranges.begin(), ranges.end(),
+              [](const Span &a, const Span &b) { return a.start_byte < b.start_byte; });
+    std::vector<Span> merged;
+    for (const Span &range : ranges) {
+        if (!merged.empty() && range.start_byte <= merged.back().end_byte) {
+            merged.back().end_byte = std::max(merged.back().end_byte, range.end_byte);
+        } else {
+            merged.push_back(range);
+        }
+    }
+    return merged;
+}
+
+// Collects diagnostics, symbols and tokens from the nodes that overlap
+// `ranges`, skipping every subtree that does not.
+class Analyzer {
+  public:
+    Analyzer(std::string_view text, const std::vector<Span> &ranges) : text_(text), ranges_(ranges) {}
+
+    void run(TSNode root) {
+        TSTreeCursor cursor = ts_tree_cursor_new(root);
+        for (;;) {
+            TSNode node = ts_tree_cursor_current_node(&cursor);
+            bool inside = overlaps(ranges_, span_of(node));
+            if (inside) {
+                visit(node);
+            }
+            if (inside && ts_tree_cursor_goto_first_child(&cursor)) {
+                continue;
+            }
+            while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+                if (!ts_tree_cursor_goto_parent(&cursor)) {
+                    ts_tree_cursor_delete(&cursor);
+                    return;
+                }
+            }
+        }
+    }
+
+    std::vector<Diagnostic> diagnostics;
+    std::vector<DocumentSymbol> symbols;
+    std::vector<SemanticToken> tokens;
+
+  private:
+    void token(Span span, TokenType type) {
+        if (span.end_byte > span.start_byte) {
+            tokens.push_back(SemanticToken{span, type});
+        }
+    }
+
+    void symbol(TSNode node, TSNode selection, SymbolKind kind, std::string_view name, std::string_view detail) {
+        if (name.empty()) {
+            return;
+        }
+        DocumentSymbol symbol;
+        static_cast<Span &>(symbol) = span_of(node);
+        symbol.selection = ts_node_is_null(selection) ? span_of(node) : span_of(selection);
+        symbol.kind = kind;
+        symbol.name = std::string(name);
+        symbol.detail = std::string(detail);
+        symbols.push_back(std::move(symbol));
+    }
+
+    void tag_symbols(TSNode node, TSNode tag) {
+        std::string_view name = node_text(child_of_kind(tag, symbol::tag_name), text_);
+        if (name == "template") {
+            symbol(node, tag, SymbolKind::function, attribute_value(tag, text_, "name"), "template");
+        } else if (name == "wxs") {
+            symbol(node, tag, SymbolKind::module, attribute_value(tag, text_, "module"), "wxs");
+        } else if (std::string_view id = attribute_value(tag, text_, "id"); !id.empty()) {
+            symbol(node, tag, SymbolKind::key, id, name);
+        }
+    }
+
+    void visit(TSNode node) {
+        if (ts_node_is_error(node)) {
+            Diagnostic diagnostic;
+            static_cast<Span &>(diagnostic) = span_of(node);
+            std::string_view snippet = node_text(node, text_).substr(0, 40);
+            snippet = snippet.substr(0, snippet.find('\n'));
+            diagnostic.message = snippet.empty() ? "Syntax error" : "Syntax error near `" + std::string(snippet) + "`";
+            diagnostics.push_back(std::move(diagnostic));
+        } else if (ts_node_is_missing(node)) {
+            Diagnostic diagnostic;
+            static_cast<Span &>(diagnostic) = span_of(node);
+            diagnostic.missing = true;
+            diagnostic.message = std::string("Missing `") + ts_node_type(node) + "`";
+            diagnostics.push_back(std::move(diagnostic));
+        }
+
+        switch (ts_node_symbol(node)) {
+            case symbol::tag_name:
+                token(span_of(node), TokenType::type);
+                break;
+            case symbol::attribute_name: {
+                std::string_view name = node_text(node, text_);
+                bool directive = name.compare(0, 3, "wx:") == 0;
+                bool event = name.compare(0, 4, "bind") == 0 || name.compare(0, 5, "catch") == 0 ||
+                             name.compare(0, 8, "capture-") == 0 || name.compare(0, 4, "mut-") == 0;
+                token(span_of(node), directive ? TokenType::keyword : event ? TokenType::event : TokenType::property);
+                break;
+            }
+            case symbol::attribute_value:
+                token(span_of(node), TokenType::string);
+                break;
+            case symbol::quoted_attribute_value: {
+                // The string is the text between the entities and
+                // interpolations inside the quotes.
+                uint32_t start = ts_node_start_byte(node);
+                for (uint32_t i = 0, n = ts_node_named_child_count(node); i < n; i++) {
+                    TSNode child = ts_node_named_child(node, i);
+                    token(Span{start, ts_node_start_byte(child)}, TokenType::string);
+                    start = ts_node_end_byte(child);
+                }
+                token(Span{start, ts_node_end_byte(node)}, TokenType::string);
+                break;
+            }
+            case symbol::interpolation_start:
+            case symbol::interpolation_end:
+                token(span_of(node), TokenType::operator_);
+                break;
+            case symbol::entity:
+                token(span_of(node), TokenType::macro);
+                break;
+            case symbol::comment:
+                token(span_of(node), TokenType::comment);
+                break;
+            case symbol::import_statement:
+            case symbol::include_statement:
+                symbol(node, TSNode{}, SymbolKind::file, attribute_value(node, text_, "src"),
+                       ts_node_symbol(node) == symbol::import_statement ? "import" : "include");
+                break;
+            case symbol::template_element: {
+                TSNode tag = child_of_kind(node, symbol::template_start_tag);
+                symbol(node, tag, SymbolKind::function, attribute_value(tag, text_, "name"), "template");
+                break;
+            }
+            case symbol::wxs_element: {
+                TSNode tag = child_of_kind(node, symbol::wxs_start_tag);
+                symbol(node, tag, SymbolKind::module, attribute_value(tag, text_, "module"), "wxs");
+                break;
+            }
+            case symbol::element: {
+                TSNode tag = ts_node_named_child(node, 0);
+                TSSymbol kind = ts_node_symbol(tag);
+                if (kind == symbol::start_tag || kind == symbol::self_closing_tag) {
+                    tag_symbols(node, tag);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    std::string_view text_;
+    const std::vector<Span> &ranges_;
+};
+
+} // namespace
+
+const std::vector<std::string_view> &semantic_token_types() {
+    static const std::vector<std::string_view> types = {"type",   "property", "keyword", "event",
+                                                         "string", "operator", "comment", "macro"};
+    return types;
+}
+
+bool overlaps(const std::vector<Span> &ranges, Span span) {
+    auto it = std::lower_bound(ranges.begin(), ranges.end(), span.start_byte,
+                               [](const Span &range, uint32_t byte) { return range.end_byte < byte; });
+    return it != ranges.end() && it->start_byte <= span.end_byte;
+}
+
+void LineIndex::reset(std::string_view text) {
+    starts_.assign(1, 0);
+    for (size_t i = text.find('\n'); i != std::string_view::npos; i = text.find('\n', i + 1)) {
+        starts_.push_back(static_cast<uint32_t>(i + 1));
+    }
+}
+
+void LineIndex::edit(uint32_t start, uint32_t old_end, std::string_view inserted) {
+    auto first = std::upper_bound(starts_.begin(), starts_.end(), start);
+    auto last = std::upper_bound(first, starts_.end(), old_end);
+    int64_t delta = static_cast<int64_t>(inserted.size()) - (static_cast<int64_t>(old_end) - start);
+    for (auto it = last; it != starts_.end(); ++it) {
+        *it = static_cast<uint32_t>(*it + delta);
+    }
+    std::vector<uint32_t> added;
+    for (size_t i = inserted.find('\n'); i != std::string_view::npos; i = inserted.find('\n', i + 1)) {
+        added.push_back(static_cast<uint32_t>(start + i + 1));
+    }
+    auto position = starts_.erase(first, last);
+    starts_.insert(position, added.begin(), added.end());
+}
+
+TSPoint LineIndex::point(uint32_t byte) const {
+    auto it = std::upper_bound(starts_.begin(), starts_.end(), byte) - 1;
+    return TSPoint{static_cast<uint32_t>(it - starts_.begin()), byte - *it};
+}
+
+Position LineIndex::position(std::string_view text, uint32_t byte, PositionEncoding encoding) const {
+    byte = std::min(byte, static_cast<uint32_t>(text.size()));
+    TSPoint point = this->point(byte);
+    if (encoding == PositionEncoding::utf8) {
+        return Position{point.row, point.column};
+    }
+    uint32_t units = 0;
+    for (uint32_t i = starts_[point.row]; i < byte; i++) {
+        auto c = static_cast<unsigned char>(text[i]);
+        if (!is_continuation(c)) {
+            units += utf16_units(c);
+        }
+    }
+    return Position{point.row, units};
+}
+
+uint32_t LineIndex::byte(std::string_view text, Position position, PositionEncoding encoding) const {
+    if (position.line >= starts_.size()) {
+        return static_cast<uint32_t>(text.size());
+    }
+    uint32_t start = starts_[position.line];
+    uint32_t end = position.line + 1 < starts_.size() ? starts_[position.line + 1] - 1 : static_cast<uint32_t>(text.size());
+    if (encoding == PositionEncoding::utf8) {
+        return std::min(start + position.character, end);
+    }
+    uint32_t byte = start, units = 0;
+    while (byte < end && units < position.character) {
+        units += utf16_units(static_cast<unsigned char>(text[byte]));
+        byte++;
+        while (byte < end && is_continuation(static_cast<unsigned char>(text[byte]))) {
+            byte++;
+        }
+    }
+    return byte;
+}
+
+Document::Document(std::string text, Parser &parser, const RuleSet *rules) : text_(std::move(text)) {
+    if (rules != nullptr) {
+        linter_ = std::make_unique<Linter>(*rules);
+    }
+    lines_.reset(text_);
+    stale_ = true;
+    reparse(parser);
+}
+
+Document::Document(Document &&) noexcept = default;
+Document &Document::operator=(Document &&) noexcept = default;
+Document::~Document() = default;
+
+const std::vector<LintDiagnostic> &Document::lint() const {
+    static const std::vector<LintDiagnostic> none;
+    return linter_ != nullptr ? linter_->diagnostics() : none;
+}
+
+void Document::edit(Position start, Position end, std::string_view text, PositionEncoding encoding) {
+    uint32_t start_byte = lines_.byte(text_, start, encoding);
+    uint32_t end_byte = std::max(start_byte, lines_.byte(text_, end, encoding));
+    edit_bytes(start_byte, end_byte, text);
+}
+
+void Document::replace(std::string text) {
+    text_ = std::move(text);
+    lines_.reset(text_);
+    tree_ = Tree();
+    edited_.clear();
+    stale_ = true;
+}
+
+void Document::edit_bytes(uint32_t start, uint32_t old_end, std::string_view text) {
+    TSInputEdit edit;
+    edit.start_byte = start;
+    edit.old_end_byte = old_end;
+    edit.new_end_byte = start + static_cast<uint32_t>(text.size());
+    edit.start_point = lines_.point(start);
+    edit.old_end_point = lines_.point(old_end);
+    text_.replace(start, old_end - start, text);
+    lines_.edit(start, old_end, text);
+    edit.new_end_point = lines_.point(edit.new_end_byte);
+
+    if (tree_) {
+        tree_.edit(edit);
+    }
+    diagnostics_.edit(start, old_end, edit.new_end_byte);
+    symbols_.edit(start, old_end, edit.new_end_byte);
+    tokens_.edit(start, old_end, edit.new_end_byte);
+    if (linter_ != nullptr) {
+        linter_->edit(start, old_end, edit.new_end_byte);
+    }
+    for (Span &span : edited_) {
+        edit_span(span, start, old_end, edit.new_end_byte);
+    }
+    edited_.push_back(Span{start, edit.new_end_byte});
+    stale_ = true;
+}
+
+std::vector<Span> Document::reparse(Parser &parser) {
+    if (!stale_) {
+        return {};
+    }
+    Tree tree = parser.parse(text_, tree_ ? &tree_ : nullptr);
+    if (!tree) {
+        return {};
+    }
+    stale_ = false;
+
+    std::vector<Span> ranges;
+    if (!tree_) {
+        ranges.push_back(Span{0, UINT32_MAX});
+        diagnostics_.clear();
+        symbols_.clear();
+        tokens_.clear();
+    } else {
+        uint32_t count = 0;
+        TSRange *changed = ts_tree_get_changed_ranges(tree_.get(), tree.get(), &count);
+        for (uint32_t i = 0; i < count; i++) {
+            ranges.push_back(Span{changed[i].start_byte, changed[i].end_byte});
+        }
+        std::free(changed);
+        ranges.insert(ranges.end(), edited_.begin(), edited_.end());
+        ranges = normalize(std::move(ranges));
+    }
+    edited_.clear();
+    tree_ = std::move(tree);
+    analyze(ranges);
+    return ranges;
+}
+
+void Document::analyze(const std::vector<Span> &ranges) {
+    Analyzer analyzer(text_, ranges);
+    analyzer.run(tree_.root());
+    diagnostics_.replace(ranges, std::move(analyzer.diagnostics));
+    symbols_.replace(ranges, std::move(analyzer.symbols));
+    tokens_.replace(ranges, std::move(analyzer.tokens));
+    if (linter_ != nullptr) {
+        linter_->relint(tree_.root(), text_, ranges);
+    }
+}
+
+} // namespace wxml
@@ -0,0 +1,220 @@
+#ifndef WXML_TOOLS_DOCUMENT_HPP_
+#define WXML_TOOLS_DOCUMENT_HPP_
+
+#include <tree_sitter/tree-sitter-wxml.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wxml {
+
+class Linter;
+class RuleSet;
+struct LintDiagnostic;
+
+// How a client counts characters within a line.
+enum class PositionEncoding : uint8_t {
+    utf8,
+    utf16,
+};
+
+struct Position {
+    uint32_t line = 0;
+    uint32_t character = 0;
+};
+
+// A byte range in the current text. Ranges touch, and so overlap, when one
+// ends where the other starts.
+struct Span {
+    uint32_t start_byte = 0;
+    uint32_t end_byte = 0;
+};
+
+// The start byte of every line, kept up to date across edits without
+// rescanning the text outside the edit.
+class LineIndex {
+  public:
+    void reset(std::string_view text);
+
+    // Records that [start, old_end) was replaced by `inserted`.
+    void edit(uint32_t start, uint32_t old_end, std::string_view inserted);
+
+    TSPoint point(uint32_t byte) const;
+    Position position(std::string_view text, uint32_t byte, PositionEncoding encoding) const;
+    uint32_t byte(std::string_view text, Position position, PositionEncoding encoding) const;
+    uint32_t line_start(uint32_t line) const { return starts_[line]; }
+    uint32_t line_count() const { return static_cast<uint32_t>(starts_.size()); }
+
+  private:
+    std::vector<uint32_t> starts_{0};
+};
+
+struct Diagnostic : Span {
+    bool missing = false; // a MISSING node rather than an ERROR
+    std::string message;
+};
+
+// LSP SymbolKind values used for WXML.
+enum class SymbolKind : uint8_t {
+    file = 1,
+    module = 2,
+    function = 12,
+    key = 20,
+};
+
+struct DocumentSymbol : Span {
+    Span selection;
+    SymbolKind kind;
+    std::string name;
+    std::string detail;
+};
+
+// Indices into semantic_token_types().
+enum class TokenType : uint8_t {
+    type,
+    property,
+    keyword,
+    event,
+    string,
+    operator_,
+    comment,
+    macro,
+};
+
+struct SemanticToken : Span {
+    TokenType type;
+};
+
+// The LSP names of the token types, in TokenType order.
+const std::vector<std::string_view> &semantic_token_types();
+
+// Where `byte` ends up after [start, old_end) is replaced by text ending at
+// `new_end`. Bytes inside the replaced text move to its end.
+inline uint32_t moved_byte(uint32_t byte, uint32_t start, uint32_t old_end, uint32_t new_end) {
+    if (byte <= start) {
+        return byte;
+    }
+    return byte >= old_end ? byte - old_end + new_end : new_end;
+}
+
+// Moves the byte ranges of an item through an edit. Items that hold more
+// than their own range overload this to move the rest too.
+inline void edit_span(Span &span, uint32_t start, uint32_t old_end, uint32_t new_end) {
+    span.start_byte = moved_byte(span.start_byte, start, old_end, new_end);
+    span.end_byte = moved_byte(span.end_byte, start, old_end, new_end);
+}
+
+inline void edit_span(DocumentSymbol &symbol, uint32_t start, uint32_t old_end, uint32_t new_end) {
+    edit_span(static_cast<Span &>(symbol), start, old_end, new_end);
+    edit_span(symbol.selection, start, old_end, new_end);
+}
+
+// Items with byte ranges, sorted by start, that follow edits the way
+// ts_tree_edit moves nodes: items after an edit shift, and items that
+// overlap one stretch to cover what replaced it.
+template <typename T> class SpanList {
+  public:
+    const std::vector<T> &items() const { return items_; }
+
+    void clear() { items_.clear(); }
+
+    void edit(uint32_t start, uint32_t old_end, uint32_t new_end) {
+        for (T &item : items_) {
+            edit_span(item, start, old_end, new_end);
+        }
+    }
+
+    // Replaces the items that overlap one of the sorted, disjoint `ranges`
+    // with those of `fresh` that do.
+    void replace(const std::vector<Span> &ranges, std::vector<T> fresh);
+
+  private:
+    std::vector<T> items_;
+};
+
+// Whether `span` overlaps one of the sorted, disjoint `ranges`.
+bool overlaps(const std::vector<Span> &ranges, Span span);
+
+// An open document: its text, its current tree, and the diagnostics,
+// symbols, semantic tokens and lint findings derived from that tree.
+//
+// Edits are applied to the text, the line index, the tree and the derived
+// items immediately; reparse() then parses incrementally and re-derives
+// items only inside the ranges that ts_tree_get_changed_ranges reports or
+// that were edited, keeping the rest.
+class Document {
+  public:
+    // Lints with `rules`, if given, which must outlive the document.
+    Document(std::string text, Parser &parser, const RuleSet *rules = nullptr);
+    Document(Document &&) noexcept;
+    Document &operator=(Document &&) noexcept;
+    ~Document();
+
+    const std::string &text() const { return text_; }
+    const LineIndex &lines() const { return lines_; }
+    const Tree &tree() const { return tree_; }
+
+    // Replaces the text between two positions.
+    void edit(Position start, Position end, std::string_view text, PositionEncoding encoding);
+
+    // Replaces the whole text.
+    void replace(std::string text);
+
+    // Brings the tree and derived items up to date with the edits so far.
+    // Returns the ranges that were re-derived.
+    std::vector<Span> reparse(Parser &parser);
+
+    const std::vector<Diagnostic> &diagnostics() const { return diagnostics_.items(); }
+    const std::vector<DocumentSymbol> &symbols() const { return symbols_.items(); }
+    const std::vector<SemanticToken> &tokens() const { return tokens_.items(); }
+
+    // Empty unless the document was opened with rules.
+    const std::vector<LintDiagnostic> &lint() const;
+
+  private:
+    void edit_bytes(uint32_t start, uint32_t old_end, std::string_view text);
+    void analyze(const std::vector<Span> &ranges);
+
+    std::string text_;
+    LineIndex lines_;
+    Tree tree_;
+    bool stale_ = false;
+    std::vector<Span> edited_; // since the last reparse, in current coordinates
+    SpanList<Diagnostic> diagnostics_;
+    SpanList<DocumentSymbol> symbols_;
+    SpanList<SemanticToken> tokens_;
+    std::unique_ptr<Linter> linter_;
+};
+
+template <typename T> void SpanList<T>::replace(const std::vector<Span> &ranges, std::vector<T> fresh) {
+    auto by_start = [](const T &a, const T &b) {
+        return a.start_byte < b.start_byte || (a.start_byte == b.start_byte && a.end_byte < b.end_byte);
+    };
+    fresh.erase(std::remove_if(fresh.begin(), fresh.end(), [&](const T &item) { return !overlaps(ranges, item); }),
+                fresh.end());
+    std::sort(fresh.begin(), fresh.end(), by_start);
+    std::vector<T> merged;
+    merged.reserve(items_.size() + fresh.size());
+    auto next = fresh.begin();
+    for (T &item : items_) {
+        if (overlaps(ranges, item)) {
+            continue;
+        }
+        for (; next != fresh.end() && by_start(*next, item); ++next) {
+            merged.push_back(std::move(*next));
+        }
+        merged.push_back(std::move(item));
+    }
+    for (; next != fresh.end(); ++next) {
+        merged.push_back(std::move(*next));
+    }
+    items_ = std::move(merged);
+}
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_DOCUMENT_HPP_
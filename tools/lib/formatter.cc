@@ -0,0 +1,294 @@
+#include "formatter.hpp"
+
+#include "nodes.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace wxml {
+
+namespace {
+
+bool is_space(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v'; }
+
+} // namespace
+
+Formatter::Formatter(FormatOptions options) : options_(options) { buffer_.reserve(chunk_size); }
+
+bool Formatter::format(TSNode root, std::string_view source, const FormatSink &sink) {
+    if (ts_node_has_error(root)) {
+        return false;
+    }
+    source_ = source;
+    sink_ = &sink;
+    written_ = false;
+    ok_ = true;
+    buffer_.clear();
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    scratch_ = ts_tree_cursor_new(root);
+    if (walk(&cursor)) {
+        write("\n");
+    }
+    flush();
+    ts_tree_cursor_delete(&scratch_);
+    ts_tree_cursor_delete(&cursor);
+    sink_ = nullptr;
+    return ok_;
+}
+
+bool Formatter::format(TSNode root, std::string_view source, std::string &out) {
+    out.clear();
+    FormatSink append = [&out](std::string_view bytes) {
+        out.append(bytes);
+        return true;
+    };
+    return format(root, source, append);
+}
+
+// Writes the document from the cursor at its root. An element's children
+// are written with a frame pushed for them and the cursor moved down, and
+// its closing tag once the frame is popped. Returns whether the document
+// had any children.
+bool Formatter::walk(TSTreeCursor *cursor) {
+    stack_.clear();
+    Frame root;
+    root.start = 0;
+    root.end = static_cast<uint32_t>(source_.size());
+    root.depth = 0;
+    root.block = true;
+    root.entered = ts_tree_cursor_goto_first_child(cursor);
+    root.last = 0;
+    stack_.push_back(root);
+    bool more = root.entered;
+    for (;;) {
+        if (more) {
+            // child() may push a frame, so the reference does not outlive it.
+            more = child(cursor, stack_.back());
+            continue;
+        }
+        Frame frame = stack_.back();
+        stack_.pop_back();
+        if (frame.entered) {
+            ts_tree_cursor_goto_parent(cursor);
+        }
+        finish(frame);
+        if (stack_.empty()) {
+            return !frame.first;
+        }
+        more = ts_tree_cursor_goto_next_sibling(cursor);
+    }
+}
+
+// Writes the cursor's node as a child of `frame`, pushing a frame for its
+// children if it is an element with content to format. Returns whether the
+// cursor is on a node to write next, in whichever frame is now on top.
+//
+// In a block every run of siblings that shared a line in the source gets a
+// line of its own at the frame's depth, with at most one blank line between
+// runs; otherwise the whitespace around the children is copied.
+bool Formatter::child(TSTreeCursor *cursor, Frame &frame) {
+    TSNode node = ts_tree_cursor_current_node(cursor);
+    uint32_t node_start = ts_node_start_byte(node);
+    if (node_start < frame.start) {
+        return ts_tree_cursor_goto_next_sibling(cursor);
+    }
+    if (node_start >= frame.end || !ok_) {
+        return false;
+    }
+    uint32_t depth = frame.depth;
+    uint32_t lines = count_lines(frame.last, node_start);
+    if (frame.block && frame.first) {
+        newline(depth);
+    } else if (frame.block && lines > 0) {
+        if (lines > 1) {
+            write("\n");
+        }
+        newline(depth);
+    } else {
+        copy(frame.last, node_start);
+    }
+    frame.last = ts_node_end_byte(node);
+    frame.first = false;
+
+    TSSymbol kind = ts_node_symbol(node);
+    if (kind == symbol::import_statement || kind == symbol::include_statement) {
+        tag(node, depth);
+    } else if (kind == symbol::text) {
+        text(node, depth);
+    } else if (!is_container(kind)) {
+        // Comments, interpolations and entities.
+        copy(node_start, frame.last);
+    } else {
+        TSNode open = ts_node_child(node, 0);
+        tag(open, depth);
+        if (ts_node_symbol(open) != symbol::self_closing_tag) {
+            TSNode close = ts_node_child(node, ts_node_child_count(node) - 1);
+            uint32_t start = ts_node_end_byte(open);
+            uint32_t end = ts_node_start_byte(close);
+            if (kind != symbol::wxs_element && !is_text_element(open, source_)) {
+                Frame children;
+                children.start = start;
+                children.end = end;
+                children.depth = depth + 1;
+                children.block = count_lines(start, end) > 0;
+                children.entered = ts_tree_cursor_goto_first_child(cursor);
+                children.last = start;
+                children.close = close;
+                stack_.push_back(children);
+                return children.entered;
+            }
+            // Whitespace is significant in wxs code and in <text>.
+            copy(start, end);
+            tag(close, depth);
+        }
+    }
+    return ts_tree_cursor_goto_next_sibling(cursor);
+}
+
+// Ends the children of `frame` and closes its element.
+void Formatter::finish(const Frame &frame) {
+    if (ts_node_is_null(frame.close)) {
+        return;
+    }
+    if (frame.block) {
+        newline(frame.depth - 1);
+    } else {
+        copy(frame.last, frame.end);
+    }
+    tag(frame.close, frame.depth - 1);
+}
+
+void Formatter::tag(TSNode node, uint32_t depth) {
+    ts_tree_cursor_reset(&scratch_, node);
+    if (!ts_tree_cursor_goto_first_child(&scratch_)) {
+        return;
+    }
+    bool wrap = count_lines(ts_node_start_byte(node), ts_node_end_byte(node)) > 0;
+    bool items = false;
+    std::string_view closer;
+    do {
+        TSNode child = ts_tree_cursor_current_node(&scratch_);
+        TSSymbol kind = ts_node_symbol(child);
+        if (!ts_node_is_named(child)) {
+            std::string_view token = ts_node_type(child);
+            if (token == "<" || token == "</") {
+                write(token);
+            } else {
+                closer = token;
+            }
+        } else if (kind == symbol::tag_name) {
+            copy(ts_node_start_byte(child), ts_node_end_byte(child));
+        } else {
+            if (wrap) {
+                newline(depth + 1);
+            } else {
+                write(" ");
+            }
+            if (kind == symbol::attribute) {
+                attribute(child);
+            } else {
+                copy(ts_node_start_byte(child), ts_node_end_byte(child));
+            }
+            items = true;
+        }
+    } while (ts_tree_cursor_goto_next_sibling(&scratch_));
+    if (items && wrap) {
+        newline(depth);
+    } else if (closer == "/>") {
+        write(" ");
+    }
+    write(closer);
+}
+
+void Formatter::attribute(TSNode node) {
+    uint32_t count = ts_node_child_count(node);
+    TSNode name = ts_node_child(node, 0);
+    if (count == 3 && ts_node_symbol(name) == symbol::attribute_name) {
+        TSNode value = ts_node_child(node, 2);
+        copy(ts_node_start_byte(name), ts_node_end_byte(name));
+        write("=");
+        copy(ts_node_start_byte(value), ts_node_end_byte(value));
+    } else {
+        copy(ts_node_start_byte(node), ts_node_end_byte(node));
+    }
+}
+
+// Re-indents the continuation lines of a text node, keeping at most one
+// blank line between them.
+void Formatter::text(TSNode node, uint32_t depth) {
+    uint32_t start = ts_node_start_byte(node);
+    uint32_t end = ts_node_end_byte(node);
+    for (;;) {
+        const char *eol = static_cast<const char *>(std::memchr(source_.data() + start, '\n', end - start));
+        if (eol == nullptr) {
+            copy(start, end);
+            return;
+        }
+        uint32_t stop = static_cast<uint32_t>(eol - source_.data());
+        uint32_t next = stop;
+        while (stop > start && is_space(source_[stop - 1])) {
+            stop--;
+        }
+        while (next < end && (is_space(source_[next]) || source_[next] == '\n')) {
+            next++;
+        }
+        copy(start, stop);
+        if (count_lines(stop, next) > 1) {
+            write("\n");
+        }
+        newline(depth);
+        start = next;
+    }
+}
+
+void Formatter::newline(uint32_t depth) {
+    if (!written_) {
+        // Nothing before the first line of the output.
+        return;
+    }
+    static constexpr std::string_view spaces = "                                                                ";
+    static constexpr std::string_view tabs = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+    std::string_view fill = options_.tabs ? tabs : spaces;
+    size_t width = options_.tabs ? depth : static_cast<size_t>(depth) * options_.indent_width;
+    write("\n");
+    while (width > 0) {
+        size_t n = std::min(width, fill.size());
+        write(fill.substr(0, n));
+        width -= n;
+    }
+}
+
+uint32_t Formatter::count_lines(uint32_t start, uint32_t end) const {
+    uint32_t lines = 0;
+    const char *p = source_.data() + start;
+    const char *stop = source_.data() + end;
+    while ((p = static_cast<const char *>(std::memchr(p, '\n', static_cast<size_t>(stop - p)))) != nullptr) {
+        lines++;
+        p++;
+    }
+    return lines;
+}
+
+void Formatter::write(std::string_view bytes) {
+    if (bytes.empty()) {
+        return;
+    }
+    written_ = true;
+    if (buffer_.size() + bytes.size() > chunk_size) {
+        flush();
+        if (bytes.size() > chunk_size) {
+            ok_ = ok_ && (*sink_)(bytes);
+            return;
+        }
+    }
+    buffer_.append(bytes);
+}
+
+void Formatter::flush() {
+    if (!buffer_.empty()) {
+        ok_ = ok_ && (*sink_)(buffer_);
+        buffer_.clear();
+    }
+}
+
+} // namespace wxml
@@ -0,0 +1,92 @@
+#ifndef WXML_TOOLS_FORMATTER_HPP_
+#define WXML_TOOLS_FORMATTER_HPP_
+
+#include <tree_sitter/tree-sitter-wxml.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wxml {
+
+struct FormatOptions {
+    uint32_t indent_width = 2;
+    bool tabs = false;
+};
+
+// Receives formatted output in order. Returning false stops formatting.
+using FormatSink = std::function<bool(std::string_view)>;
+
+// A whitespace-only WXML formatter.
+//
+// Lines are re-indented by nesting depth, the content of an element that
+// spans lines starts and ends on lines of its own, runs of blank lines
+// shrink to one, and tags are rewritten with single spaces between
+// attributes, or with one attribute per line if the tag already spanned
+// lines. Everything else is copied byte for byte: siblings that share a
+// line keep the whitespace between them, and comments, interpolations,
+// entities, attribute values, wxs raw text and the content of <text>
+// elements are never touched.
+//
+// The tree is walked once with a cursor, keeping the open elements on a
+// heap-allocated stack rather than recursing, so deeply nested documents
+// cannot overflow the call stack. Output goes through a buffer of
+// chunk_size bytes that is reused across calls, and slices of the source
+// larger than the buffer are passed to the sink directly, so memory stays
+// bounded by the buffer and one stack frame per open element whatever the
+// size of the file.
+class Formatter {
+  public:
+    static constexpr size_t chunk_size = 64 * 1024;
+
+    explicit Formatter(FormatOptions options = {});
+
+    // Formats `source`, whose syntax tree is rooted at `root`. Returns
+    // false without writing anything if the tree has errors, or as soon as
+    // the sink does.
+    bool format(TSNode root, std::string_view source, const FormatSink &sink);
+
+    // Formats into `out`, replacing its contents.
+    bool format(TSNode root, std::string_view source, std::string &out);
+
+  private:
+    // The children of an open element, or of the document, being written.
+    struct Frame {
+        uint32_t start;  // children that start before are skipped
+        uint32_t end;    // and those that start here or after end the run
+        uint32_t depth;  // of the children
+        bool block;      // whether each run of children gets its own line
+        bool entered;    // whether the cursor moved down to the children
+        bool first = true;
+        uint32_t last;   // end of the previous child
+        TSNode close{};  // the element's closing tag; null for the document
+    };
+
+    bool walk(TSTreeCursor *cursor);
+    bool child(TSTreeCursor *cursor, Frame &frame);
+    void finish(const Frame &frame);
+    void tag(TSNode node, uint32_t depth);
+    void attribute(TSNode node);
+    void text(TSNode node, uint32_t depth);
+    void newline(uint32_t depth);
+    uint32_t count_lines(uint32_t start, uint32_t end) const;
+    void copy(uint32_t start, uint32_t end) { write(source_.substr(start, end - start)); }
+    void write(std::string_view bytes);
+    void flush();
+
+    FormatOptions options_;
+    std::string buffer_;
+    std::string_view source_;
+    const FormatSink *sink_ = nullptr;
+    TSTreeCursor scratch_{}; // walks the children of one tag at a time
+    std::vector<Frame> stack_;
+    bool written_ = false;
+    bool ok_ = true;
+};
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_FORMATTER_HPP_
@@ -0,0 +1,135 @@
+#include "graph.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+namespace wxml {
+
+namespace {
+
+// The distinct targets of `edges`, sorted.
+std::vector<uint32_t> targets(const std::vector<Edge> &edges) {
+    std::vector<uint32_t> result;
+    result.reserve(edges.size());
+    for (const Edge &edge : edges) {
+        result.push_back(edge.target);
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+} // namespace
+
+DependencyGraph::DependencyGraph(std::string root) : root_(std::move(root)) {}
+
+std::string DependencyGraph::normalize(std::string_view path) const {
+    std::string result = std::filesystem::path(path).lexically_normal().generic_string();
+    return result.empty() ? "." : result;
+}
+
+std::string DependencyGraph::resolve(std::string_view from, std::string_view src) const {
+    namespace fs = std::filesystem;
+    if (src.empty() || is_dynamic(src) || src.find("://") != std::string_view::npos) {
+        return {};
+    }
+    fs::path target;
+    if (src.front() == '/') {
+        target = fs::path(root_) / fs::path(src.substr(1));
+    } else {
+        target = fs::path(from).parent_path() / fs::path(src);
+    }
+    if (!target.has_extension()) {
+        target += ".wxml";
+    }
+    return normalize(target.string());
+}
+
+uint32_t DependencyGraph::intern(std::string_view path) {
+    std::string key = normalize(path);
+    auto [it, inserted] = ids_.try_emplace(std::move(key), static_cast<uint32_t>(paths_.size()));
+    if (inserted) {
+        paths_.push_back(it->first);
+        forward_.emplace_back();
+        reverse_.emplace_back();
+        visited_.push_back(0);
+    }
+    return it->second;
+}
+
+uint32_t DependencyGraph::find(std::string_view path) const {
+    auto it = ids_.find(normalize(path));
+    return it == ids_.end() ? npos : it->second;
+}
+
+bool DependencyGraph::update(const FileSummary &summary) {
+    uint32_t id = intern(summary.path);
+    std::vector<Edge> edges;
+    edges.reserve(summary.imports.size() + summary.includes.size());
+    auto add = [&](const std::vector<Reference> &references, EdgeKind kind) {
+        for (const Reference &reference : references) {
+            std::string target = resolve(paths_[id], reference.value);
+            if (!target.empty()) {
+                edges.push_back(Edge{intern(target), kind, reference.start_byte});
+            }
+        }
+    };
+    add(summary.imports, EdgeKind::import);
+    add(summary.includes, EdgeKind::include);
+    std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b) { return a.start_byte < b.start_byte; });
+
+    std::vector<uint32_t> before = targets(forward_[id]), after = targets(edges);
+    forward_[id] = std::move(edges);
+    if (before == after) {
+        return false;
+    }
+
+    std::vector<uint32_t> lost, gained;
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(lost));
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(gained));
+    for (uint32_t target : lost) {
+        std::vector<uint32_t> &sources = reverse_[target];
+        sources.erase(std::lower_bound(sources.begin(), sources.end(), id));
+    }
+    for (uint32_t target : gained) {
+        std::vector<uint32_t> &sources = reverse_[target];
+        sources.insert(std::lower_bound(sources.begin(), sources.end(), id), id);
+    }
+    return true;
+}
+
+void DependencyGraph::remove(std::string_view path) {
+    uint32_t id = find(path);
+    if (id == npos) {
+        return;
+    }
+    FileSummary empty;
+    empty.path = paths_[id];
+    update(empty);
+}
+
+std::vector<uint32_t> DependencyGraph::affected(const std::vector<std::string> &changed) {
+    if (++generation_ == 0) {
+        std::fill(visited_.begin(), visited_.end(), 0);
+        generation_ = 1;
+    }
+    std::vector<uint32_t> order;
+    for (const std::string &path : changed) {
+        uint32_t id = find(path);
+        if (id != npos && visited_[id] != generation_) {
+            visited_[id] = generation_;
+            order.push_back(id);
+        }
+    }
+    for (size_t i = 0; i < order.size(); i++) {
+        for (uint32_t source : reverse_[order[i]]) {
+            if (visited_[source] != generation_) {
+                visited_[source] = generation_;
+                order.push_back(source);
+            }
+        }
+    }
+    return order;
+}
+
+} // namespace wxml
@@ -0,0 +1,81 @@
+#ifndef WXML_TOOLS_GRAPH_HPP_
+#define WXML_TOOLS_GRAPH_HPP_
+
+#include "summary.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace wxml {
+
+enum class EdgeKind : uint8_t {
+    import,
+    include,
+};
+
+struct Edge {
+    uint32_t target;
+    EdgeKind kind;
+    uint32_t start_byte; // of the statement in the source file
+};
+
+// The import/include graph of a project. Files are identified by dense ids
+// handed out on first sight, including files that are referenced but have
+// not been summarized (yet). Each file keeps its outgoing edges in source
+// order and the distinct files that depend on it, so both directions are
+// answered without scanning the graph.
+class DependencyGraph {
+  public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    // `root` is the mini-program root that absolute srcs such as
+    // "/common/head.wxml" are resolved against.
+    explicit DependencyGraph(std::string root = ".");
+
+    // The normalized path `src` refers to when written in `from`, or an empty
+    // string if it cannot be resolved statically (empty, interpolated or
+    // remote). A missing extension is taken to be .wxml.
+    std::string resolve(std::string_view from, std::string_view src) const;
+
+    uint32_t intern(std::string_view path);
+    uint32_t find(std::string_view path) const;
+    const std::string &path(uint32_t id) const { return paths_[id]; }
+    size_t size() const { return paths_.size(); }
+
+    // Replaces the outgoing edges of `summary.path`. Only the reverse lists
+    // of files that gained or lost a dependent are touched. Returns whether
+    // the set of dependencies changed.
+    bool update(const FileSummary &summary);
+
+    // Drops the outgoing edges of a deleted file. Files that still refer to it
+    // keep their edges, so it reappears as their dependency if re-created.
+    void remove(std::string_view path);
+
+    const std::vector<Edge> &dependencies(uint32_t id) const { return forward_[id]; }
+    const std::vector<uint32_t> &dependents(uint32_t id) const { return reverse_[id]; }
+
+    // Whether nothing imports or includes `id`, which is what pages are.
+    bool is_root(uint32_t id) const { return reverse_[id].empty(); }
+
+    // `changed` and every file that transitively depends on one of them, in
+    // breadth-first order. Unknown paths are ignored.
+    std::vector<uint32_t> affected(const std::vector<std::string> &changed);
+
+  private:
+    std::string normalize(std::string_view path) const;
+
+    std::string root_;
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::vector<std::string> paths_;
+    std::vector<std::vector<Edge>> forward_;
+    std::vector<std::vector<uint32_t>> reverse_; // sorted
+    std::vector<uint32_t> visited_;              // generation stamps for affected()
+    uint32_t generation_ = 0;
+};
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_GRAPH_HPP_
@@ -0,0 +1,50 @@
+#ifndef WXML_TOOLS_HASH_HPP_
+#define WXML_TOOLS_HASH_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace wxml {
+
+namespace detail {
+
+inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t mix_word(uint64_t w) { return rotl(w * 0x87c37b91114253d5ULL, 31) * 0x4cf5ad432745937fULL; }
+
+inline uint64_t finalize(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace detail
+
+// A fast non-cryptographic 64-bit hash of `data`, consuming a word at a
+// time with MurmurHash3's mixing steps. It is used to address cached
+// results by content, not to defend against adversarial input.
+inline uint64_t hash_bytes(std::string_view data, uint64_t seed = 0) {
+    const char *p = data.data();
+    size_t n = data.size();
+    uint64_t h = seed ^ (n * 0x9e3779b97f4a7c15ULL);
+    for (; n >= 8; p += 8, n -= 8) {
+        uint64_t w;
+        std::memcpy(&w, p, 8);
+        h ^= detail::mix_word(w);
+        h = detail::rotl(h, 27) * 5 + 0x52dce729;
+    }
+    if (n > 0) {
+        uint64_t w = 0;
+        std::memcpy(&w, p, n);
+        h ^= detail::mix_word(w);
+    }
+    return detail::finalize(h);
+}
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_HASH_HPP_
@@ -0,0 +1,94 @@
+#include "indexer.hpp"
+
+#include "mapped_file.hpp"
+#include "work_stealing.hpp"
+
+#include <tree_sitter/tree-sitter-wxml.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <system_error>
+
+namespace wxml {
+
+std::vector<std::string> find_wxml_files(const std::string &root) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> paths;
+    std::error_code ec;
+    if (fs::is_regular_file(root, ec)) {
+        paths.push_back(root);
+        return paths;
+    }
+    for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end;
+         it != end; it.increment(ec)) {
+        if (ec) {
+            break;
+        }
+        std::string name = it->path().filename().string();
+        if (it->is_directory(ec)) {
+            if (name == "node_modules" || (name.size() > 1 && name[0] == '.')) {
+                it.disable_recursion_pending();
+            }
+        } else if (it->path().extension() == ".wxml" && it->is_regular_file(ec)) {
+            paths.push_back(it->path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+std::vector<FileSummary> index_files(const std::vector<std::string> &paths, unsigned threads, IndexStats *stats,
+                                     ParseCache *cache) {
+    if (threads == 0) {
+        threads = default_concurrency();
+    }
+    std::vector<FileSummary> summaries(paths.size());
+    std::vector<Parser> parsers(threads);
+    std::atomic<size_t> failed{0}, with_errors{0};
+    std::atomic<uint64_t> bytes{0};
+
+    auto start = std::chrono::steady_clock::now();
+    parallel_for(paths.size(), threads, [&](unsigned worker, size_t i) {
+        MappedFile file;
+        if (!file.open(paths[i]) || file.size() > std::numeric_limits<uint32_t>::max()) {
+            summaries[i].path = paths[i];
+            failed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        uint64_t key = cache != nullptr ? cache->key(file.data()) : 0;
+        if (cache != nullptr && cache->load(key, &summaries[i])) {
+            summaries[i].path = paths[i];
+        } else {
+            Tree tree = parsers[worker].parse(file.data());
+            if (!tree) {
+                summaries[i] = FileSummary{};
+                summaries[i].path = paths[i];
+                failed.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            summaries[i] = summarize(paths[i], file.data(), tree.root());
+            if (cache != nullptr) {
+                cache->store(key, summaries[i]);
+            }
+        }
+        bytes.fetch_add(file.size(), std::memory_order_relaxed);
+        if (summaries[i].has_error) {
+            with_errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    if (stats != nullptr) {
+        stats->files = paths.size();
+        stats->failed = failed.load();
+        stats->with_errors = with_errors.load();
+        stats->bytes = bytes.load();
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stats->threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(paths.size(), 1)));
+    }
+    return summaries;
+}
+
+} // namespace wxml
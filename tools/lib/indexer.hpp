@@ -0,0 +1,35 @@
+#ifndef WXML_TOOLS_INDEXER_HPP_
+#define WXML_TOOLS_INDEXER_HPP_
+
+#include "cache.hpp"
+#include "summary.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace wxml {
+
+struct IndexStats {
+    size_t files = 0;
+    size_t failed = 0; // files that could not be read
+    size_t with_errors = 0;
+    uint64_t bytes = 0;
+    double seconds = 0;
+    unsigned threads = 0;
+};
+
+// The .wxml files under `root`, sorted, skipping hidden directories and
+// node_modules.
+std::vector<std::string> find_wxml_files(const std::string &root);
+
+// Parses and summarizes `paths` on a work-stealing pool, with one reused
+// parser per worker. Summaries are returned in the order of `paths`; files
+// that cannot be read get a summary with only the path set. With a cache,
+// files whose contents were summarized before are not parsed at all.
+std::vector<FileSummary> index_files(const std::vector<std::string> &paths, unsigned threads = 0,
+                                     IndexStats *stats = nullptr, ParseCache *cache = nullptr);
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_INDEXER_HPP_
@@ -0,0 +1,307 @@
+#include "json.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace wxml {
+
+class JsonParser {
+  public:
+    explicit JsonParser(std::string_view text) : text_(text) {}
+
+    bool document(Json *out) {
+        if (!value(out, 0)) {
+            return false;
+        }
+        skip_space();
+        return pos_ == text_.size();
+    }
+
+  private:
+    // Deeper documents are rejected rather than risking the stack.
+    static constexpr int kMaxDepth = 256;
+
+    void skip_space() {
+        while (pos_ < text_.size() &&
+               (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r')) {
+            pos_++;
+        }
+    }
+
+    bool literal(std::string_view word) {
+        if (text_.substr(pos_, word.size()) != word) {
+            return false;
+        }
+        pos_ += word.size();
+        return true;
+    }
+
+    bool value(Json *out, int depth) {
+        skip_space();
+        if (pos_ >= text_.size() || depth > kMaxDepth) {
+            return false;
+        }
+        switch (text_[pos_]) {
+            case 'n':
+                out->type_ = Json::Type::null;
+                return literal("null");
+            case 't':
+                out->type_ = Json::Type::boolean;
+                out->boolean_ = true;
+                return literal("true");
+            case 'f':
+                out->type_ = Json::Type::boolean;
+                out->boolean_ = false;
+                return literal("false");
+            case '"':
+                out->type_ = Json::Type::string;
+                return string(&out->string_);
+            case '[':
+                out->type_ = Json::Type::array;
+                return array(out, depth);
+            case '{':
+                out->type_ = Json::Type::object;
+                return object(out, depth);
+            default:
+                out->type_ = Json::Type::number;
+                return number(&out->number_);
+        }
+    }
+
+    bool number(double *out) {
+        size_t start = pos_;
+        while (pos_ < text_.size() && (std::strchr("+-.eE", text_[pos_]) != nullptr ||
+                                       (text_[pos_] >= '0' && text_[pos_] <= '9'))) {
+            pos_++;
+        }
+        if (pos_ == start) {
+            return false;
+        }
+        std::string digits(text_.substr(start, pos_ - start));
+        char *end;
+        *out = std::strtod(digits.c_str(), &end);
+        return *end == '\0' && std::isfinite(*out);
+    }
+
+    bool hex4(uint32_t *out) {
+        if (text_.size() - pos_ < 4) {
+            return false;
+        }
+        *out = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = text_[pos_++];
+            *out <<= 4;
+            if (c >= '0' && c <= '9') {
+                *out |= static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                *out |= static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                *out |= static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void append_utf8(std::string &out, uint32_t code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xc0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3f));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xe0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            out += static_cast<char>(0x80 | (code & 0x3f));
+        } else {
+            out += static_cast<char>(0xf0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            out += static_cast<char>(0x80 | (code & 0x3f));
+        }
+    }
+
+    bool string(std::string *out) {
+        pos_++; // opening quote
+        for (;;) {
+            size_t run = pos_;
+            while (pos_ < text_.size() && text_[pos_] != '"' && text_[pos_] != '\\') {
+                pos_++;
+            }
+            out->append(text_.substr(run, pos_ - run));
+            if (pos_ >= text_.size()) {
+                return false;
+            }
+            if (text_[pos_++] == '"') {
+                return true;
+            }
+            if (pos_ >= text_.size()) {
+                return false;
+            }
+            char escape = text_[pos_++];
+            switch (escape) {
+                case '"':
+                case '\\':
+                case '/':
+                    *out += escape;
+                    break;
+                case 'b':
+                    *out += '\b';
+                    break;
+                case 'f':
+                    *out += '\f';
+                    break;
+                case 'n':
+                    *out += '\n';
+                    break;
+                case 'r':
+                    *out += '\r';
+                    break;
+                case 't':
+                    *out += '\t';
+                    break;
+                case 'u': {
+                    uint32_t code;
+                    if (!hex4(&code)) {
+                        return false;
+                    }
+                    if (code >= 0xd800 && code < 0xdc00 && literal("\\u")) {
+                        uint32_t low;
+                        if (!hex4(&low) || low < 0xdc00 || low >= 0xe000) {
+                            return false;
+                        }
+                        code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+                    }
+                    append_utf8(*out, code);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+    }
+
+    bool array(Json *out, int depth) {
+        pos_++;
+        skip_space();
+        if (pos_ < text_.size() && text_[pos_] == ']') {
+            pos_++;
+            return true;
+        }
+        for (;;) {
+            out->array_.emplace_back();
+            if (!value(&out->array_.back(), depth + 1)) {
+                return false;
+            }
+            skip_space();
+            if (pos_ >= text_.size()) {
+                return false;
+            }
+            char c = text_[pos_++];
+            if (c == ']') {
+                return true;
+            }
+            if (c != ',') {
+                return false;
+            }
+        }
+    }
+
+    bool object(Json *out, int depth) {
+        pos_++;
+        skip_space();
+        if (pos_ < text_.size() && text_[pos_] == '}') {
+            pos_++;
+            return true;
+        }
+        for (;;) {
+            skip_space();
+            if (pos_ >= text_.size() || text_[pos_] != '"') {
+                return false;
+            }
+            out->object_.emplace_back();
+            if (!string(&out->object_.back().first)) {
+                return false;
+            }
+            skip_space();
+            if (pos_ >= text_.size() || text_[pos_++] != ':' || !value(&out->object_.back().second, depth + 1)) {
+                return false;
+            }
+            skip_space();
+            if (pos_ >= text_.size()) {
+                return false;
+            }
+            char c = text_[pos_++];
+            if (c == '}') {
+                return true;
+            }
+            if (c != ',') {
+                return false;
+            }
+        }
+    }
+
+    std::string_view text_;
+    size_t pos_ = 0;
+};
+
+const Json &Json::operator[](std::string_view key) const {
+    static const Json null;
+    for (const auto &member : object_) {
+        if (member.first == key) {
+            return member.second;
+        }
+    }
+    return null;
+}
+
+void Json::write(std::string &out) const {
+    switch (type_) {
+        case Type::null:
+            out += "null";
+            break;
+        case Type::boolean:
+            out += boolean_ ? "true" : "false";
+            break;
+        case Type::number: {
+            char buffer[32];
+            if (number_ == std::floor(number_) && std::fabs(number_) < 1e15) {
+                std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(number_));
+            } else {
+                std::snprintf(buffer, sizeof(buffer), "%.17g", number_);
+            }
+            out += buffer;
+            break;
+        }
+        case Type::string:
+            append_json_string(out, string_);
+            break;
+        case Type::array:
+            out += '[';
+            for (size_t i = 0; i < array_.size(); i++) {
+                out += i > 0 ? "," : "";
+                array_[i].write(out);
+            }
+            out += ']';
+            break;
+        case Type::object:
+            out += '{';
+            for (size_t i = 0; i < object_.size(); i++) {
+                out += i > 0 ? "," : "";
+                append_json_string(out, object_[i].first);
+                out += ':';
+                object_[i].second.write(out);
+            }
+            out += '}';
+            break;
+    }
+}
+
+bool Json::parse(std::string_view text, Json *out) {
+    *out = Json();
+    return JsonParser(text).document(out);
+}
+
+} // namespace wxml
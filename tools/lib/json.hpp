@@ -0,0 +1,88 @@
+#ifndef WXML_TOOLS_JSON_HPP_
+#define WXML_TOOLS_JSON_HPP_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace wxml {
+
+// Appends `value` to `out` as a JSON string literal.
+inline void append_json_string(std::string &out, std::string_view value) {
+    out += '"';
+    for (unsigned char c : value) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (c < 0x20) {
+                    char escape[7];
+                    std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+                    out += escape;
+                } else {
+                    out += static_cast<char>(c);
+                }
+        }
+    }
+    out += '"';
+}
+
+// A parsed JSON document, as exchanged with language clients. Objects keep
+// their members in order; lookups are linear, which suits the small
+// objects of the protocol.
+class Json {
+  public:
+    enum class Type : uint8_t { null, boolean, number, string, array, object };
+
+    Json() = default;
+
+    Type type() const { return type_; }
+    bool is_null() const { return type_ == Type::null; }
+    bool is_string() const { return type_ == Type::string; }
+    bool is_number() const { return type_ == Type::number; }
+
+    bool as_bool(bool fallback = false) const { return type_ == Type::boolean ? boolean_ : fallback; }
+    double as_number(double fallback = 0) const { return type_ == Type::number ? number_ : fallback; }
+    const std::string &as_string() const { return string_; }
+    const std::vector<Json> &items() const { return array_; }
+    const std::vector<std::pair<std::string, Json>> &members() const { return object_; }
+
+    // The member called `key`, or a null value if there is none.
+    const Json &operator[](std::string_view key) const;
+
+    // Appends this value to `out` as JSON text.
+    void write(std::string &out) const;
+
+    // Parses `text`, returning false on malformed input.
+    static bool parse(std::string_view text, Json *out);
+
+  private:
+    friend class JsonParser;
+
+    Type type_ = Type::null;
+    bool boolean_ = false;
+    double number_ = 0;
+    std::string string_;
+    std::vector<Json> array_;
+    std::vector<std::pair<std::string, Json>> object_;
+};
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_JSON_HPP_
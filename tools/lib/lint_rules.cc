@@ -0,0 +1,244 @@
+// The built-in lint rules. Each registers for the node kinds it needs and
+// is called by the linter's single traversal; none walks the tree itself.
+
+#include "linter.hpp"
+
+#include <string>
+
+namespace wxml {
+
+namespace {
+
+constexpr uint64_t tag_kinds =
+    kinds<symbol::start_tag, symbol::self_closing_tag, symbol::template_start_tag, symbol::slot_start_tag,
+          symbol::block_start_tag, symbol::wxs_start_tag, symbol::import_statement, symbol::include_statement>;
+
+// The nodes that can carry wx:if, wx:elif or wx:else.
+constexpr uint64_t branch_kinds =
+    kinds<symbol::element, symbol::template_element, symbol::slot_element, symbol::block_element>;
+
+// The value of an attribute without its quotes, or an empty string.
+std::string_view value_of(TSNode attribute, const LintContext &context) {
+    uint32_t count = ts_node_child_count(attribute);
+    if (count < 3) {
+        return {};
+    }
+    TSNode value = ts_node_child(attribute, count - 1);
+    std::string_view text = context.text(value);
+    if (ts_node_symbol(value) == symbol::quoted_attribute_value && text.size() >= 2) {
+        text = text.substr(1, text.size() - 2);
+    }
+    return text;
+}
+
+std::string_view tag_name(TSNode tag, const LintContext &context) {
+    TSNode name = ts_node_named_child(tag, 0);
+    return ts_node_is_null(name) || ts_node_symbol(name) != symbol::tag_name ? std::string_view() : context.text(name);
+}
+
+class ForWithoutKey : public Rule {
+  public:
+    std::string_view name() const override { return "for-without-key"; }
+    uint64_t kinds() const override { return tag_kinds; }
+
+    void check(TSNode tag, LintContext &context) const override {
+        const Attributes &attributes = context.attributes(tag);
+        TSNode loop = attributes.find("wx:for");
+        if (ts_node_is_null(loop)) {
+            loop = attributes.find("wx:for-items");
+        }
+        if (!ts_node_is_null(loop) && !attributes.has("wx:key")) {
+            context.report(loop, "wx:for without wx:key re-renders every item when the list changes");
+        }
+    }
+};
+
+class IfWithFor : public Rule {
+  public:
+    std::string_view name() const override { return "if-with-for"; }
+    uint64_t kinds() const override { return tag_kinds; }
+
+    void check(TSNode tag, LintContext &context) const override {
+        const Attributes &attributes = context.attributes(tag);
+        TSNode condition = attributes.find("wx:if");
+        if (!ts_node_is_null(condition) && (attributes.has("wx:for") || attributes.has("wx:for-items"))) {
+            context.report(condition, "wx:if is evaluated for each item of wx:for on the same tag; "
+                                      "wrap the loop in a <block wx:if> to test it once");
+        }
+    }
+};
+
+class DuplicateAttribute : public Rule {
+  public:
+    std::string_view name() const override { return "duplicate-attribute"; }
+    Severity severity() const override { return Severity::error; }
+    uint64_t kinds() const override { return tag_kinds; }
+
+    void check(TSNode tag, LintContext &context) const override {
+        const Attributes &attributes = context.attributes(tag);
+        for (size_t i = 1; i < attributes.names.size(); i++) {
+            for (size_t j = 0; j < i; j++) {
+                if (attributes.names[i] == attributes.names[j]) {
+                    report(attributes.nodes[i], attributes.names[i], context);
+                    break;
+                }
+            }
+        }
+    }
+
+  private:
+    static void report(TSNode attribute, std::string_view name, LintContext &context) {
+        context.report(attribute, "duplicate attribute `" + std::string(name) + "`");
+    }
+};
+
+// wx:elif and wx:else must follow a sibling with wx:if or wx:elif. The rule
+// reads only that sibling, so that an edit rechecks the nodes next to it
+// rather than every child of the container.
+class OrphanElse : public Rule {
+  public:
+    std::string_view name() const override { return "orphan-else"; }
+    Severity severity() const override { return Severity::error; }
+    uint64_t kinds() const override { return branch_kinds; }
+    bool reads_previous() const override { return true; }
+
+    void check(TSNode node, LintContext &context) const override {
+        const Attributes &attributes = context.attributes(ts_node_child(node, 0));
+        TSNode branch = attributes.find("wx:elif");
+        if (ts_node_is_null(branch)) {
+            branch = attributes.find("wx:else");
+        }
+        if (ts_node_is_null(branch)) {
+            return;
+        }
+        TSNode previous = context.previous();
+        TSSymbol kind = ts_node_is_null(previous) ? 0 : ts_node_symbol(previous);
+        if (kind < 64 && (branch_kinds & TS_WXML_KIND_BIT(kind))) {
+            const Attributes &before = context.attributes(ts_node_child(previous, 0));
+            if (before.has("wx:if") || (before.has("wx:elif") && !before.has("wx:else"))) {
+                return;
+            }
+        }
+        context.report(branch, std::string(context.text(ts_node_child(branch, 0))) +
+                                   " without a wx:if or wx:elif on the sibling before it");
+    }
+};
+
+// wx:if="false" is the non-empty string "false", which is truthy.
+class DirectiveWithoutInterpolation : public Rule {
+  public:
+    std::string_view name() const override { return "directive-without-interpolation"; }
+    uint64_t kinds() const override { return wxml::kinds<symbol::attribute>; }
+
+    void check(TSNode attribute, LintContext &context) const override {
+        std::string_view name = context.text(ts_node_child(attribute, 0));
+        if (name != "wx:if" && name != "wx:elif" && name != "wx:for" && name != "hidden") {
+            return;
+        }
+        std::string_view value = value_of(attribute, context);
+        if (!value.empty() && value.find("{{") == std::string_view::npos) {
+            context.report(attribute, std::string(name) + " takes the string \"" + std::string(value) +
+                                          "\"; use {{...}} for a value");
+        }
+    }
+};
+
+class DeprecatedForItems : public Rule {
+  public:
+    std::string_view name() const override { return "deprecated-for-items"; }
+    Severity severity() const override { return Severity::hint; }
+    uint64_t kinds() const override { return wxml::kinds<symbol::attribute_name>; }
+
+    void check(TSNode name, LintContext &context) const override {
+        if (context.text(name) == "wx:for-items") {
+            context.report(name, "wx:for-items is deprecated; use wx:for");
+        }
+    }
+};
+
+class EmptyInterpolation : public Rule {
+  public:
+    std::string_view name() const override { return "empty-interpolation"; }
+    uint64_t kinds() const override { return wxml::kinds<symbol::interpolation>; }
+
+    void check(TSNode node, LintContext &context) const override {
+        uint32_t count = ts_node_child_count(node);
+        uint32_t start = ts_node_end_byte(ts_node_child(node, 0));
+        uint32_t end = count > 1 ? ts_node_start_byte(ts_node_child(node, count - 1)) : start;
+        std::string_view inside = context.source().substr(start, end - start);
+        if (inside.find_first_not_of(" \t\r\n") == std::string_view::npos) {
+            context.report(node, "empty interpolation");
+        }
+    }
+};
+
+class MissingSrc : public Rule {
+  public:
+    std::string_view name() const override { return "missing-src"; }
+    Severity severity() const override { return Severity::error; }
+    uint64_t kinds() const override { return wxml::kinds<symbol::import_statement, symbol::include_statement>; }
+
+    void check(TSNode node, LintContext &context) const override {
+        const Attributes &attributes = context.attributes(node);
+        TSNode src = attributes.find("src");
+        if (ts_node_is_null(src) || value_of(src, context).empty()) {
+            context.report(node, "<" + std::string(tag_name(node, context)) + "> without a src");
+        }
+    }
+};
+
+class TemplateName : public Rule {
+  public:
+    std::string_view name() const override { return "template-name"; }
+    Severity severity() const override { return Severity::error; }
+    uint64_t kinds() const override { return wxml::kinds<symbol::template_start_tag, symbol::self_closing_tag>; }
+
+    void check(TSNode tag, LintContext &context) const override {
+        if (tag_name(tag, context) != "template") {
+            return;
+        }
+        const Attributes &attributes = context.attributes(tag);
+        bool defines = attributes.has("name");
+        bool calls = attributes.has("is");
+        if (!defines && !calls) {
+            context.report(tag, "<template> needs a name to define it or is to use one");
+        } else if (defines && calls) {
+            context.report(attributes.find("is"), "<template> with both name and is; is is ignored");
+        }
+    }
+};
+
+class WxsModule : public Rule {
+  public:
+    std::string_view name() const override { return "wxs-module"; }
+    Severity severity() const override { return Severity::error; }
+    uint64_t kinds() const override { return wxml::kinds<symbol::wxs_start_tag, symbol::self_closing_tag>; }
+
+    void check(TSNode tag, LintContext &context) const override {
+        if (tag_name(tag, context) != "wxs") {
+            return;
+        }
+        const Attributes &attributes = context.attributes(tag);
+        TSNode module = attributes.find("module");
+        if (ts_node_is_null(module) || value_of(module, context).empty()) {
+            context.report(tag, "<wxs> without a module name cannot be used");
+        }
+    }
+};
+
+} // namespace
+
+void add_builtin_rules(RuleSet &rules) {
+    rules.add(std::make_unique<ForWithoutKey>());
+    rules.add(std::make_unique<IfWithFor>());
+    rules.add(std::make_unique<DuplicateAttribute>());
+    rules.add(std::make_unique<OrphanElse>());
+    rules.add(std::make_unique<DirectiveWithoutInterpolation>());
+    rules.add(std::make_unique<DeprecatedForItems>());
+    rules.add(std::make_unique<EmptyInterpolation>());
+    rules.add(std::make_unique<MissingSrc>());
+    rules.add(std::make_unique<TemplateName>());
+    rules.add(std::make_unique<WxsModule>());
+}
+
+} // namespace wxml
@@ -0,0 +1,267 @@
+#include "linter.hpp"
+
+#include "nodes.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace wxml {
+
+const char *severity_name(Severity severity) {
+    switch (severity) {
+        case Severity::error:
+            return "error";
+        case Severity::warning:
+            return "warning";
+        case Severity::information:
+            return "info";
+        case Severity::hint:
+            return "hint";
+    }
+    return "warning";
+}
+
+std::string_view Arena::copy(std::string_view bytes) {
+    if (bytes.empty()) {
+        return {};
+    }
+    if (bytes.size() > left_) {
+        size_t size = std::max(block_size, bytes.size());
+        blocks_.push_back(Block{std::make_unique<char[]>(size), size});
+        next_ = blocks_.back().data.get();
+        left_ = size;
+    }
+    char *at = next_;
+    std::memcpy(at, bytes.data(), bytes.size());
+    next_ += bytes.size();
+    left_ -= bytes.size();
+    used_ += bytes.size();
+    return std::string_view(at, bytes.size());
+}
+
+void Arena::clear() {
+    // Keep one block so that linting file after file does not allocate.
+    if (blocks_.size() > 1) {
+        blocks_.resize(1);
+    }
+    next_ = blocks_.empty() ? nullptr : blocks_[0].data.get();
+    left_ = blocks_.empty() ? 0 : blocks_[0].size;
+    used_ = 0;
+}
+
+void RuleSet::add(std::unique_ptr<Rule> rule) {
+    rules_.push_back(std::move(rule));
+    disabled_.push_back(false);
+    rebuild();
+}
+
+bool RuleSet::disable(std::string_view name) {
+    for (size_t i = 0; i < rules_.size(); i++) {
+        if (rules_[i]->name() == name) {
+            disabled_[i] = true;
+            rebuild();
+            return true;
+        }
+    }
+    return false;
+}
+
+void RuleSet::rebuild() {
+    for (std::vector<uint16_t> &rules : dispatch_) {
+        rules.clear();
+    }
+    wanted_ = 0;
+    for (size_t i = 0; i < rules_.size(); i++) {
+        if (disabled_[i]) {
+            continue;
+        }
+        uint64_t kinds = rules_[i]->kinds();
+        wanted_ |= kinds;
+        for (TSSymbol kind = 0; kind < 64; kind++) {
+            if (kinds & TS_WXML_KIND_BIT(kind)) {
+                dispatch_[kind].push_back(static_cast<uint16_t>(i));
+            }
+        }
+    }
+}
+
+TSNode Attributes::find(std::string_view name) const {
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i] == name) {
+            return nodes[i];
+        }
+    }
+    return TSNode{};
+}
+
+LintContext::LintContext(std::string_view source, std::vector<LintDiagnostic> &out, Arena &arena,
+                         Attributes &attributes)
+    : source_(source), out_(out), arena_(arena), attributes_(attributes) {
+    attributes_.nodes.clear();
+    attributes_.names.clear();
+}
+
+LintContext::~LintContext() {
+    if (has_cursor_) {
+        ts_tree_cursor_delete(&cursor_);
+    }
+}
+
+std::string_view LintContext::text(TSNode node) const { return node_text(node, source_); }
+
+const Attributes &LintContext::attributes(TSNode tag) {
+    if (ts_node_eq(tag, tag_)) {
+        return attributes_;
+    }
+    tag_ = tag;
+    attributes_.nodes.clear();
+    attributes_.names.clear();
+    if (ts_node_is_null(tag)) {
+        return attributes_;
+    }
+    if (has_cursor_) {
+        ts_tree_cursor_reset(&cursor_, tag);
+    } else {
+        cursor_ = ts_tree_cursor_new(tag);
+        has_cursor_ = true;
+    }
+    if (!ts_tree_cursor_goto_first_child(&cursor_)) {
+        return attributes_;
+    }
+    do {
+        TSNode child = ts_tree_cursor_current_node(&cursor_);
+        if (ts_node_symbol(child) == symbol::attribute) {
+            attributes_.nodes.push_back(child);
+            attributes_.names.push_back(text(ts_node_child(child, 0)));
+        }
+    } while (ts_tree_cursor_goto_next_sibling(&cursor_));
+    return attributes_;
+}
+
+void LintContext::report(Span span, std::string_view message) {
+    LintDiagnostic diagnostic;
+    static_cast<Span &>(diagnostic) = span;
+    diagnostic.owner = owner_;
+    diagnostic.rule = rule_;
+    diagnostic.severity = severity_;
+    diagnostic.message = arena_.copy(message);
+    out_.push_back(diagnostic);
+}
+
+void LintContext::report(TSNode node, std::string_view message) {
+    report(Span{ts_node_start_byte(node), ts_node_end_byte(node)}, message);
+}
+
+void Linter::lint(TSNode root, std::string_view source) {
+    diagnostics_.clear();
+    arena_.clear();
+    run(root, source, nullptr);
+    diagnostics_.swap(fresh_);
+}
+
+void Linter::edit(uint32_t start, uint32_t old_end, uint32_t new_end) {
+    for (LintDiagnostic &diagnostic : diagnostics_) {
+        edit_span(diagnostic, start, old_end, new_end);
+        edit_span(diagnostic.owner, start, old_end, new_end);
+    }
+}
+
+void Linter::relint(TSNode root, std::string_view source, const std::vector<Span> &ranges) {
+    run(root, source, &ranges);
+    // Both lists are in preorder, so a merge by owner start keeps that.
+    std::vector<LintDiagnostic> merged;
+    merged.reserve(diagnostics_.size() + fresh_.size());
+    auto next = fresh_.begin();
+    for (const LintDiagnostic &diagnostic : diagnostics_) {
+        if (overlaps(ranges, diagnostic.owner)) {
+            continue;
+        }
+        for (; next != fresh_.end() && next->owner.start_byte < diagnostic.owner.start_byte; ++next) {
+            merged.push_back(*next);
+        }
+        merged.push_back(diagnostic);
+    }
+    merged.insert(merged.end(), next, fresh_.end());
+    diagnostics_ = std::move(merged);
+    compact();
+}
+
+// One preorder walk that runs the rules dispatched for each node's kind,
+// descending only into subtrees that may contain a wanted kind and, when
+// relinting, that overlap `ranges`. A rule that reads the sibling before a
+// node also runs when only that sibling overlaps them.
+void Linter::run(TSNode root, std::string_view source, const std::vector<Span> *ranges) {
+    fresh_.clear();
+    checks_ = 0;
+    uint64_t wanted = rules_->wanted();
+    if (wanted == 0) {
+        return;
+    }
+    LintContext context(source, fresh_, arena_, attributes_);
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    TSNode previous{};
+    for (;;) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        Span span{ts_node_start_byte(node), ts_node_end_byte(node)};
+        bool inside = ranges == nullptr || overlaps(*ranges, span);
+        TSSymbol kind = ts_node_symbol(node);
+        if (kind < 64 && (wanted & TS_WXML_KIND_BIT(kind))) {
+            Span joint{ts_node_is_null(previous) ? span.start_byte : ts_node_start_byte(previous), span.end_byte};
+            bool joint_inside = inside || (ranges != nullptr && overlaps(*ranges, joint));
+            context.previous_ = previous;
+            for (uint16_t rule : rules_->dispatch(kind)) {
+                const Rule &checker = *rules_->rules()[rule];
+                bool reads_previous = checker.reads_previous();
+                if (!(reads_previous ? joint_inside : inside)) {
+                    continue;
+                }
+                context.owner_ = reads_previous ? joint : span;
+                context.rule_ = rule;
+                context.severity_ = checker.severity();
+                checker.check(node, context);
+                checks_++;
+            }
+        }
+        bool descend = inside && ((wxml_descendant_kinds(kind) & wanted) != 0 || ts_node_has_error(node));
+        if (descend && ts_tree_cursor_goto_first_child(&cursor)) {
+            previous = TSNode{};
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                ts_tree_cursor_delete(&cursor);
+                // Joint owners start before the nodes checked before them.
+                auto by_owner = [](const LintDiagnostic &a, const LintDiagnostic &b) {
+                    return a.owner.start_byte < b.owner.start_byte;
+                };
+                if (!std::is_sorted(fresh_.begin(), fresh_.end(), by_owner)) {
+                    std::stable_sort(fresh_.begin(), fresh_.end(), by_owner);
+                }
+                return;
+            }
+            node = ts_tree_cursor_current_node(&cursor);
+        }
+        if (!ts_node_is_extra(node)) {
+            previous = node;
+        }
+    }
+}
+
+// Copies the live messages into a fresh arena once replaced ones take up
+// most of it.
+void Linter::compact() {
+    size_t live = 0;
+    for (const LintDiagnostic &diagnostic : diagnostics_) {
+        live += diagnostic.message.size();
+    }
+    if (arena_.bytes() < 2 * live + 4096) {
+        return;
+    }
+    Arena arena;
+    for (LintDiagnostic &diagnostic : diagnostics_) {
+        diagnostic.message = arena.copy(diagnostic.message);
+    }
+    arena_ = std::move(arena);
+}
+
+} // namespace wxml
@@ -0,0 +1,204 @@
+#ifndef WXML_TOOLS_LINTER_HPP_
+#define WXML_TOOLS_LINTER_HPP_
+
+#include "document.hpp"
+
+#include <tree_sitter/tree-sitter-wxml.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wxml {
+
+// LSP DiagnosticSeverity values.
+enum class Severity : uint8_t {
+    error = 1,
+    warning = 2,
+    information = 3,
+    hint = 4,
+};
+
+const char *severity_name(Severity severity);
+
+struct LintDiagnostic : Span {
+    Span owner;               // the node whose check reported it, see Rule::reads_previous()
+    uint16_t rule = 0;        // index into RuleSet::rules()
+    Severity severity = Severity::warning;
+    std::string_view message; // owned by the Linter's arena
+};
+
+// Bump allocation for diagnostic messages, so that linting a file costs a
+// few block allocations however many diagnostics it reports.
+class Arena {
+  public:
+    std::string_view copy(std::string_view bytes);
+    void clear();
+    size_t bytes() const { return used_; }
+
+  private:
+    static constexpr size_t block_size = 64 * 1024;
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    char *next_ = nullptr;
+    size_t left_ = 0; // free bytes after next_ in the last block
+    size_t used_ = 0;
+};
+
+class LintContext;
+
+// A check run on every node of the kinds it registers for.
+//
+// For relinting to be exact, what a rule reports for a node must depend
+// only on that node's subtree, and on the sibling before it if the rule
+// reads_previous(). A rule that looks at other siblings registers for their
+// parent's kind instead, so that a change to any of them rechecks it.
+class Rule {
+  public:
+    virtual ~Rule() = default;
+
+    virtual std::string_view name() const = 0;
+    virtual Severity severity() const { return Severity::warning; }
+
+    // The TS_WXML_KIND_BIT(id) set of kinds to check, all with ids below 64.
+    virtual uint64_t kinds() const = 0;
+
+    // Whether the rule reads LintContext::previous(). What it reports is
+    // then owned by the span from that sibling to the node, so that editing
+    // either rechecks the node.
+    virtual bool reads_previous() const { return false; }
+
+    virtual void check(TSNode node, LintContext &context) const = 0;
+};
+
+// Rules with a dispatch table from each node kind to the rules that check
+// it, shared by any number of linters.
+class RuleSet {
+  public:
+    void add(std::unique_ptr<Rule> rule);
+
+    // Stops running the rule called `name`. Returns false if there is none.
+    bool disable(std::string_view name);
+
+    const std::vector<std::unique_ptr<Rule>> &rules() const { return rules_; }
+
+    // The kinds that some enabled rule checks.
+    uint64_t wanted() const { return wanted_; }
+
+    // The enabled rules that check `kind`, as indices into rules().
+    const std::vector<uint16_t> &dispatch(TSSymbol kind) const { return dispatch_[kind]; }
+
+  private:
+    void rebuild();
+
+    std::vector<std::unique_ptr<Rule>> rules_;
+    std::vector<bool> disabled_;
+    std::array<std::vector<uint16_t>, 64> dispatch_;
+    uint64_t wanted_ = 0;
+};
+
+// Adds the built-in rules to `rules`.
+void add_builtin_rules(RuleSet &rules);
+
+// The attributes of a tag in source order, with their names.
+struct Attributes {
+    std::vector<TSNode> nodes;
+    std::vector<std::string_view> names;
+
+    // The first attribute called `name`, or a null node.
+    TSNode find(std::string_view name) const;
+    bool has(std::string_view name) const { return !ts_node_is_null(find(name)); }
+};
+
+// What a rule reports to: findings go into the running linter's arena.
+class LintContext {
+  public:
+    LintContext(const LintContext &) = delete;
+    LintContext &operator=(const LintContext &) = delete;
+    ~LintContext();
+
+    std::string_view source() const { return source_; }
+    // The source of `node`, or an empty string for a null node.
+    std::string_view text(TSNode node) const;
+
+    // The attributes of `tag`, collected in one cursor pass and kept until
+    // another tag's are asked for, so that the rules checking a tag share
+    // them.
+    const Attributes &attributes(TSNode tag);
+
+    // The sibling before the node being checked, not counting extras such
+    // as comments, or a null node for the first child.
+    TSNode previous() const { return previous_; }
+
+    void report(Span span, std::string_view message);
+    void report(TSNode node, std::string_view message);
+
+  private:
+    friend class Linter;
+
+    LintContext(std::string_view source, std::vector<LintDiagnostic> &out, Arena &arena, Attributes &attributes);
+
+    std::string_view source_;
+    std::vector<LintDiagnostic> &out_;
+    Arena &arena_;
+    Attributes &attributes_; // of tag_
+    TSNode tag_{};
+    TSTreeCursor cursor_{};
+    bool has_cursor_ = false;
+    Span owner_;
+    TSNode previous_{};
+    uint16_t rule_ = 0;
+    Severity severity_ = Severity::warning;
+};
+
+// Runs a rule set over a tree in one cursor traversal, calling only the
+// rules registered for each node's kind and skipping subtrees that cannot
+// contain a kind any rule checks.
+//
+// Diagnostics follow edits like SpanList does, and relint() rechecks only
+// the nodes that overlap the changed ranges, replacing the diagnostics
+// that those nodes reported before and keeping the rest.
+class Linter {
+  public:
+    explicit Linter(const RuleSet &rules) : rules_(&rules) {}
+
+    // Lints the whole tree.
+    void lint(TSNode root, std::string_view source);
+
+    // Records that [start, old_end) was replaced by text ending at `new_end`.
+    void edit(uint32_t start, uint32_t old_end, uint32_t new_end);
+
+    // Relints the nodes that overlap one of the sorted, disjoint `ranges`.
+    void relint(TSNode root, std::string_view source, const std::vector<Span> &ranges);
+
+    // Sorted by the start of their owner.
+    const std::vector<LintDiagnostic> &diagnostics() const { return diagnostics_; }
+
+    const RuleSet &rules() const { return *rules_; }
+
+    // The number of rule checks run by the last lint() or relint().
+    uint64_t checks() const { return checks_; }
+
+  private:
+    void run(TSNode root, std::string_view source, const std::vector<Span> *ranges);
+    void compact();
+
+    const RuleSet *rules_;
+    std::vector<LintDiagnostic> diagnostics_;
+    std::vector<LintDiagnostic> fresh_;
+    Arena arena_;
+    Attributes attributes_; // kept so that its storage is reused
+    uint64_t checks_ = 0;
+};
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_LINTER_HPP_
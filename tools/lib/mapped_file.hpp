@@ -0,0 +1,33 @@
+#ifndef WXML_TOOLS_MAPPED_FILE_HPP_
+#define WXML_TOOLS_MAPPED_FILE_HPP_
+
+#include <string>
+#include <string_view>
+
+namespace wxml {
+
+// A read-only memory mapping of a whole file. Empty files map to an empty
+// view without calling mmap.
+class MappedFile {
+  public:
+    MappedFile() noexcept = default;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile();
+
+    // Map `path`, returning false and setting errno on failure.
+    bool open(const std::string &path);
+
+    std::string_view data() const noexcept { return {data_, size_}; }
+    size_t size() const noexcept { return size_; }
+
+  private:
+    const char *data_ = "";
+    size_t size_ = 0;
+};
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_MAPPED_FILE_HPP_
@@ -0,0 +1,325 @@
+#include "minifier.hpp"
+
+#include "mapped_file.hpp"
+#include "nodes.hpp"
+#include "work_stealing.hpp"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <filesystem>
+
+namespace wxml {
+
+namespace {
+
+#ifdef IOV_MAX
+constexpr size_t max_iov = IOV_MAX;
+#else
+constexpr size_t max_iov = 1024;
+#endif
+
+bool is_inline(TSSymbol kind) {
+    return kind == symbol::text || kind == symbol::interpolation || kind == symbol::entity;
+}
+
+// Writes `count` slices with as few writev calls as the kernel allows,
+// resuming after partial writes.
+bool write_slices(int fd, const std::string_view *slices, size_t count) {
+    iovec iov[64];
+    size_t next = 0;
+    size_t offset = 0; // into slices[next]
+    while (next < count) {
+        size_t n = 0;
+        for (size_t i = next; i < count && n < std::min<size_t>(64, max_iov); i++, n++) {
+            size_t skip = i == next ? offset : 0;
+            iov[n].iov_base = const_cast<char *>(slices[i].data() + skip);
+            iov[n].iov_len = slices[i].size() - skip;
+        }
+        ssize_t written = writev(fd, iov, static_cast<int>(n));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        size_t left = static_cast<size_t>(written);
+        while (next < count && left >= slices[next].size() - offset) {
+            left -= slices[next].size() - offset;
+            offset = 0;
+            next++;
+        }
+        offset += left;
+    }
+    return true;
+}
+
+} // namespace
+
+bool Minifier::minify(TSNode root, std::string_view source) {
+    slices_.clear();
+    size_ = 0;
+    if (ts_node_has_error(root)) {
+        return false;
+    }
+    source_ = source;
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    scratch_ = ts_tree_cursor_new(root);
+
+    // An element's children are kept with a frame pushed for them and the
+    // cursor moved down, and its closing tag once the frame is popped.
+    stack_.clear();
+    Frame document;
+    document.start = 0;
+    document.end = static_cast<uint32_t>(source.size());
+    document.entered = ts_tree_cursor_goto_first_child(&cursor);
+    document.last = 0;
+    stack_.push_back(document);
+    bool more = document.entered;
+    for (;;) {
+        if (more) {
+            // child() may push a frame, so the reference does not outlive it.
+            more = child(&cursor, stack_.back());
+            continue;
+        }
+        Frame frame = stack_.back();
+        stack_.pop_back();
+        if (frame.entered) {
+            ts_tree_cursor_goto_parent(&cursor);
+        }
+        finish(frame);
+        if (stack_.empty()) {
+            break;
+        }
+        more = ts_tree_cursor_goto_next_sibling(&cursor);
+    }
+    ts_tree_cursor_delete(&scratch_);
+    ts_tree_cursor_delete(&cursor);
+    return true;
+}
+
+bool Minifier::write(int fd) const { return write_slices(fd, slices_.data(), slices_.size()); }
+
+std::string Minifier::str() const {
+    std::string out;
+    out.reserve(size_);
+    for (std::string_view slice : slices_) {
+        out.append(slice);
+    }
+    return out;
+}
+
+// Keeps the cursor's node, a child of `frame`, unless it is a comment,
+// pushing a frame for its children if it is an element with content to
+// minify. The whitespace between children is all the grammar leaves out of
+// the tree, so a gap between two of them is whitespace. Returns whether the
+// cursor is on a node to keep next, in whichever frame is now on top.
+bool Minifier::child(TSTreeCursor *cursor, Frame &frame) {
+    TSNode node = ts_tree_cursor_current_node(cursor);
+    uint32_t node_start = ts_node_start_byte(node);
+    if (node_start < frame.start) {
+        return ts_tree_cursor_goto_next_sibling(cursor);
+    }
+    if (node_start >= frame.end) {
+        return false;
+    }
+    if (frame.last < node_start) {
+        frame.gap = frame.last;
+    }
+    frame.last = ts_node_end_byte(node);
+    TSSymbol kind = ts_node_symbol(node);
+    if (kind == symbol::comment) {
+        return ts_tree_cursor_goto_next_sibling(cursor);
+    }
+    if (frame.gap != UINT32_MAX && (frame.after_inline || is_inline(kind))) {
+        space(frame.gap);
+    }
+    frame.after_inline = is_inline(kind);
+    frame.gap = UINT32_MAX;
+
+    if (kind == symbol::import_statement || kind == symbol::include_statement) {
+        tag(node);
+    } else if (!is_container(kind)) {
+        keep(node_start, frame.last);
+    } else {
+        TSNode open = ts_node_child(node, 0);
+        tag(open);
+        if (ts_node_symbol(open) != symbol::self_closing_tag) {
+            TSNode close = ts_node_child(node, ts_node_child_count(node) - 1);
+            uint32_t start = ts_node_end_byte(open);
+            uint32_t end = ts_node_start_byte(close);
+            if (kind == symbol::wxs_element) {
+                // The whitespace before the code is not part of raw_text.
+                TSNode code = ts_node_child(node, 1);
+                if (ts_node_symbol(code) == symbol::raw_text) {
+                    keep(ts_node_start_byte(code), ts_node_end_byte(code));
+                }
+            } else if (is_text_element(open, source_)) {
+                text_content(cursor, start, end);
+            } else {
+                Frame children;
+                children.start = start;
+                children.end = end;
+                children.entered = ts_tree_cursor_goto_first_child(cursor);
+                children.last = start;
+                children.close = close;
+                stack_.push_back(children);
+                return children.entered;
+            }
+            tag(close);
+        }
+    }
+    return ts_tree_cursor_goto_next_sibling(cursor);
+}
+
+// Ends the children of `frame` and closes its element.
+void Minifier::finish(const Frame &frame) {
+    uint32_t gap = frame.last < frame.end ? frame.last : frame.gap;
+    if (gap != UINT32_MAX && frame.after_inline) {
+        space(gap);
+    }
+    if (!ts_node_is_null(frame.close)) {
+        tag(frame.close);
+    }
+}
+
+// Keeps [start, end) of the <text> element at the cursor except its
+// comments, since whitespace is significant in <text>.
+void Minifier::text_content(TSTreeCursor *cursor, uint32_t start, uint32_t end) {
+    uint32_t last = start;
+    ts_tree_cursor_goto_first_child(cursor);
+    do {
+        TSNode child = ts_tree_cursor_current_node(cursor);
+        if (ts_node_symbol(child) == symbol::comment && ts_node_start_byte(child) >= start &&
+            ts_node_start_byte(child) < end) {
+            keep(last, ts_node_start_byte(child));
+            last = ts_node_end_byte(child);
+        }
+    } while (ts_tree_cursor_goto_next_sibling(cursor));
+    ts_tree_cursor_goto_parent(cursor);
+    keep(last, end);
+}
+
+void Minifier::tag(TSNode node) {
+    ts_tree_cursor_reset(&scratch_, node);
+    if (!ts_tree_cursor_goto_first_child(&scratch_)) {
+        return;
+    }
+    uint32_t last = 0;
+    bool unquoted = false; // whether the last attribute ends in an unquoted value
+    do {
+        TSNode child = ts_tree_cursor_current_node(&scratch_);
+        TSSymbol kind = ts_node_symbol(child);
+        uint32_t start = ts_node_start_byte(child);
+        uint32_t end = ts_node_end_byte(child);
+        if (kind == symbol::comment) {
+            continue;
+        }
+        if (kind == symbol::attribute) {
+            if (last < start) {
+                // Only where the source separates them; `x="1"y="2"` stays.
+                space(last);
+            }
+            uint32_t count = ts_node_child_count(child);
+            if (count == 3) {
+                TSNode name = ts_node_child(child, 0);
+                TSNode equals = ts_node_child(child, 1);
+                TSNode value = ts_node_child(child, 2);
+                keep(start, ts_node_end_byte(name));
+                keep(ts_node_start_byte(equals), ts_node_end_byte(equals));
+                keep(ts_node_start_byte(value), end);
+                unquoted = ts_node_symbol(value) == symbol::attribute_value;
+            } else {
+                keep(start, end);
+                unquoted = false;
+            }
+        } else {
+            if (unquoted && ts_node_type(child) == std::string_view("/>")) {
+                // `a=b/>` would read the slash as part of the value.
+                space(last);
+            }
+            keep(start, end);
+        }
+        last = end;
+    } while (ts_tree_cursor_goto_next_sibling(&scratch_));
+}
+
+void Minifier::keep(uint32_t start, uint32_t end) {
+    if (start < end) {
+        append(source_.substr(start, end - start));
+    }
+}
+
+// Writes one space for the whitespace that starts at `gap`, reusing the
+// source byte when it is a space so the slice can merge with its
+// neighbours.
+void Minifier::space(uint32_t gap) {
+    if (gap < source_.size() && source_[gap] == ' ') {
+        keep(gap, gap + 1);
+    } else {
+        append(" ");
+    }
+}
+
+void Minifier::append(std::string_view bytes) {
+    size_ += bytes.size();
+    if (!slices_.empty()) {
+        std::string_view &back = slices_.back();
+        const char *source_end = source_.data() + source_.size();
+        if (back.data() + back.size() == bytes.data() && bytes.data() >= source_.data() && bytes.data() <= source_end) {
+            back = std::string_view(back.data(), back.size() + bytes.size());
+            return;
+        }
+    }
+    slices_.push_back(bytes);
+}
+
+std::vector<MinifyResult> minify_files(const std::vector<std::string> &inputs, const std::vector<std::string> &outputs,
+                                       unsigned threads) {
+    if (threads == 0) {
+        threads = default_concurrency();
+    }
+    std::vector<MinifyResult> results(inputs.size());
+    std::vector<Parser> parsers(threads);
+    std::vector<Minifier> minifiers(threads);
+    parallel_for(inputs.size(), threads, [&](unsigned worker, size_t i) {
+        MinifyResult &result = results[i];
+        MappedFile file;
+        if (!file.open(inputs[i])) {
+            result.failed = true;
+            result.error = errno;
+            return;
+        }
+        std::string_view source = file.data();
+        Minifier &minifier = minifiers[worker];
+        Tree tree = parsers[worker].parse(source);
+        result.bytes = source.size();
+        result.has_error = !tree || !minifier.minify(tree.root(), source);
+        result.minified = result.has_error ? source.size() : minifier.size();
+        if (outputs.empty()) {
+            return;
+        }
+        std::error_code ec;
+        std::filesystem::path parent = std::filesystem::path(outputs[i]).parent_path();
+        if (!parent.empty()) {
+            std::filesystem::create_directories(parent, ec);
+        }
+        int fd = ::open(outputs[i].c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        bool ok = fd >= 0 && (result.has_error ? write_slices(fd, &source, 1) : minifier.write(fd));
+        if (!ok) {
+            result.failed = true;
+            result.error = errno;
+        }
+        if (fd >= 0 && ::close(fd) != 0 && ok) {
+            result.failed = true;
+            result.error = errno;
+        }
+    });
+    return results;
+}
+
+} // namespace wxml
@@ -0,0 +1,89 @@
+#ifndef WXML_TOOLS_MINIFIER_HPP_
+#define WXML_TOOLS_MINIFIER_HPP_
+
+#include <tree_sitter/tree-sitter-wxml.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wxml {
+
+// Removes comments and insignificant whitespace from WXML.
+//
+// Whitespace between two tags is dropped, whitespace next to text,
+// interpolations or entities shrinks to one space, and whitespace before an
+// attribute shrinks to one space. Text, raw text, interpolations, entities and
+// attribute values are kept as they are, as is everything inside <text>
+// except comments.
+//
+// The output is a gather list of slices that point into the source, or
+// into static strings, with slices that are adjacent in the source merged.
+// Nothing is copied and nothing is allocated per node; the list is reused
+// from one call to the next, as is the stack of open elements that the
+// walk keeps instead of recursing.
+class Minifier {
+  public:
+    // Builds the gather list for `source`, whose syntax tree is rooted at
+    // `root`. Returns false, leaving the list empty, if the tree has errors.
+    bool minify(TSNode root, std::string_view source);
+
+    const std::vector<std::string_view> &slices() const { return slices_; }
+
+    // The length of the output.
+    size_t size() const { return size_; }
+
+    // Writes the output with writev, returning false and setting errno on
+    // failure.
+    bool write(int fd) const;
+
+    // The output as one string.
+    std::string str() const;
+
+  private:
+    // The children of an open element, or of the document, being kept.
+    struct Frame {
+        uint32_t start; // children that start before are skipped
+        uint32_t end;   // and those that start here or after end the run
+        bool entered;   // whether the cursor moved down to the children
+        bool after_inline = false;
+        uint32_t last;  // end of the previous child
+        // Where whitespace was last skipped since the last kept child.
+        uint32_t gap = UINT32_MAX;
+        TSNode close{}; // the element's closing tag; null for the document
+    };
+
+    bool child(TSTreeCursor *cursor, Frame &frame);
+    void finish(const Frame &frame);
+    void text_content(TSTreeCursor *cursor, uint32_t start, uint32_t end);
+    void tag(TSNode node);
+    void keep(uint32_t start, uint32_t end);
+    void space(uint32_t gap);
+    void append(std::string_view bytes);
+
+    std::vector<std::string_view> slices_;
+    std::string_view source_;
+    TSTreeCursor scratch_{};
+    std::vector<Frame> stack_;
+    size_t size_ = 0;
+};
+
+struct MinifyResult {
+    uint64_t bytes = 0;
+    uint64_t minified = 0; // equal to bytes for files that were copied as is
+    bool failed = false;   // could not be read or written; see `error`
+    bool has_error = false; // had syntax errors, so was copied as is
+    int error = 0;
+};
+
+// Minifies `inputs` on a work-stealing pool, with one parser and minifier
+// per worker, writing each to the same entry of `outputs` unless `outputs`
+// is empty. Missing output directories are created. Results are returned
+// in the order of `inputs`.
+std::vector<MinifyResult> minify_files(const std::vector<std::string> &inputs, const std::vector<std::string> &outputs,
+                                       unsigned threads = 0);
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_MINIFIER_HPP_
@@ -0,0 +1,46 @@
+#ifndef WXML_TOOLS_NODES_HPP_
+#define WXML_TOOLS_NODES_HPP_
+
+#include <tree_sitter/tree-sitter-wxml.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+namespace wxml {
+
+// The source text of `node`, or an empty view for a null node.
+inline std::string_view node_text(TSNode node, std::string_view source) {
+    if (ts_node_is_null(node)) {
+        return {};
+    }
+    uint32_t start = ts_node_start_byte(node);
+    return source.substr(start, ts_node_end_byte(node) - start);
+}
+
+// The first child of `node` of the given kind, or a null node.
+inline TSNode child_of_kind(TSNode node, TSSymbol kind) {
+    for (uint32_t i = 0, n = ts_node_child_count(node); i < n; i++) {
+        TSNode child = ts_node_child(node, i);
+        if (ts_node_symbol(child) == kind) {
+            return child;
+        }
+    }
+    return TSNode{};
+}
+
+// Whether nodes of `kind` are elements: an opening tag, content, and a
+// closing tag unless the opening tag closes itself.
+inline bool is_container(TSSymbol kind) {
+    return kind == symbol::element || kind == symbol::template_element || kind == symbol::slot_element ||
+           kind == symbol::block_element || kind == symbol::wxs_element;
+}
+
+// Whether the element opened by `open` is a <text>, inside which
+// whitespace is significant.
+inline bool is_text_element(TSNode open, std::string_view source) {
+    return node_text(ts_node_named_child(open, 0), source) == "text";
+}
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_NODES_HPP_
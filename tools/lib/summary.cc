@@ -0,0 +1,125 @@
+#include "summary.hpp"
+
+#include "nodes.hpp"
+
+#include <tree_sitter/tree-sitter-wxml.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace wxml {
+
+namespace {
+
+Reference reference(TSNode node, std::string_view value) {
+    return Reference{std::string(value), ts_node_start_byte(node), ts_node_end_byte(node)};
+}
+
+// The built-in components of the mini program framework, sorted. Any other
+// tag is a custom component that the page or component must declare.
+constexpr std::string_view builtin_tags[] = {
+    "ad", "ad-custom", "audio", "block", "button", "camera", "canvas", "channel-live", "channel-video", "checkbox",
+    "checkbox-group", "cover-image", "cover-view", "editor", "form", "functional-page-navigator", "grid-view",
+    "icon", "image", "input", "keyboard-accessory", "label", "list-view", "live-player", "live-pusher", "map",
+    "match-media", "movable-area", "movable-view", "navigation-bar", "navigator", "official-account", "open-data",
+    "page-container", "page-meta", "picker", "picker-view", "picker-view-column", "progress", "radio",
+    "radio-group", "rich-text", "root-portal", "scroll-view", "share-element", "slider", "slot", "sticky-header",
+    "sticky-section", "swiper", "swiper-item", "switch", "text", "textarea", "video", "view", "voip-room",
+    "web-view",
+};
+
+bool is_builtin(std::string_view tag) {
+    return std::binary_search(std::begin(builtin_tags), std::end(builtin_tags), tag);
+}
+
+} // namespace
+
+std::string_view attribute_value(TSNode tag, std::string_view source, std::string_view name) {
+    if (ts_node_is_null(tag)) {
+        return {};
+    }
+    for (uint32_t i = 0, n = ts_node_child_count(tag); i < n; i++) {
+        TSNode attribute = ts_node_child(tag, i);
+        if (ts_node_symbol(attribute) != symbol::attribute) {
+            continue;
+        }
+        uint32_t count = ts_node_child_count(attribute);
+        if (count == 0 || node_text(ts_node_child(attribute, 0), source) != name) {
+            continue;
+        }
+        TSNode value = ts_node_child(attribute, count - 1);
+        switch (ts_node_symbol(value)) {
+            case symbol::attribute_value:
+                return node_text(value, source);
+            case symbol::quoted_attribute_value: {
+                std::string_view quoted = node_text(value, source);
+                return quoted.size() >= 2 ? quoted.substr(1, quoted.size() - 2) : std::string_view();
+            }
+            default:
+                return {};
+        }
+    }
+    return {};
+}
+
+FileSummary summarize(std::string_view path, std::string_view source, TSNode root) {
+    FileSummary summary;
+    summary.path = std::string(path);
+    summary.size = static_cast<uint32_t>(source.size());
+    summary.has_error = ts_node_has_error(root);
+
+    Preorder<symbol::import_statement, symbol::include_statement, symbol::template_element, symbol::wxs_element,
+             symbol::start_tag, symbol::self_closing_tag>
+        preorder(root);
+    for (TSNode node : preorder) {
+        switch (ts_node_symbol(node)) {
+            case symbol::import_statement:
+                summary.imports.push_back(reference(node, attribute_value(node, source, "src")));
+                break;
+            case symbol::include_statement:
+                summary.includes.push_back(reference(node, attribute_value(node, source, "src")));
+                break;
+            case symbol::template_element: {
+                TSNode tag = child_of_kind(node, symbol::template_start_tag);
+                if (std::string_view name = attribute_value(tag, source, "name"); !name.empty()) {
+                    summary.templates.push_back(reference(node, name));
+                } else if (std::string_view is = attribute_value(tag, source, "is"); !is.empty()) {
+                    summary.template_uses.push_back(reference(node, is));
+                }
+                break;
+            }
+            case symbol::wxs_element: {
+                TSNode tag = child_of_kind(node, symbol::wxs_start_tag);
+                summary.wxs_modules.push_back(WxsModule{std::string(attribute_value(tag, source, "module")),
+                                                        std::string(attribute_value(tag, source, "src")),
+                                                        ts_node_start_byte(node), ts_node_end_byte(node)});
+                break;
+            }
+            default: {
+                std::string_view name = node_text(child_of_kind(node, symbol::tag_name), source);
+                bool self_closing = ts_node_symbol(node) == symbol::self_closing_tag;
+                if (self_closing && name == "template") {
+                    if (std::string_view is = attribute_value(node, source, "is"); !is.empty()) {
+                        summary.template_uses.push_back(reference(node, is));
+                    } else if (std::string_view def = attribute_value(node, source, "name"); !def.empty()) {
+                        summary.templates.push_back(reference(node, def));
+                    }
+                } else if (self_closing && name == "wxs") {
+                    summary.wxs_modules.push_back(WxsModule{std::string(attribute_value(node, source, "module")),
+                                                            std::string(attribute_value(node, source, "src")),
+                                                            ts_node_start_byte(node), ts_node_end_byte(node)});
+                } else if (!name.empty() && !is_builtin(name)) {
+                    summary.component_tags.emplace_back(name);
+                }
+                break;
+            }
+        }
+    }
+
+    std::sort(summary.component_tags.begin(), summary.component_tags.end());
+    summary.component_tags.erase(std::unique(summary.component_tags.begin(), summary.component_tags.end()),
+                                 summary.component_tags.end());
+    return summary;
+}
+
+} // namespace wxml
@@ -0,0 +1,53 @@
+#ifndef WXML_TOOLS_SUMMARY_HPP_
+#define WXML_TOOLS_SUMMARY_HPP_
+
+#include <tree_sitter/api.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wxml {
+
+// A named reference made by a node in a file, such as the `src` of an
+// import or the `name` of a template, with the byte range of that node.
+struct Reference {
+    std::string value;
+    uint32_t start_byte = 0;
+    uint32_t end_byte = 0;
+};
+
+struct WxsModule {
+    std::string module;
+    std::string src; // empty for inline modules
+    uint32_t start_byte = 0;
+    uint32_t end_byte = 0;
+};
+
+// What the project-level indexes need to know about one file.
+struct FileSummary {
+    std::string path;
+    uint32_t size = 0;
+    bool has_error = false;
+    std::vector<Reference> imports;        // <import src>
+    std::vector<Reference> includes;       // <include src>
+    std::vector<Reference> templates;      // <template name>
+    std::vector<Reference> template_uses;  // <template is>
+    std::vector<WxsModule> wxs_modules;    // <wxs module>
+    std::vector<std::string> component_tags; // custom components: distinct, sorted
+};
+
+// Builds the summary of a parsed file. `path` is copied into the result.
+FileSummary summarize(std::string_view path, std::string_view source, TSNode root);
+
+// The unquoted value of the attribute called `name` on a tag node, or an
+// empty view if it is absent.
+std::string_view attribute_value(TSNode tag, std::string_view source, std::string_view name);
+
+// Whether `value` is computed at runtime, as in is="{{ name }}".
+inline bool is_dynamic(std::string_view value) { return value.find("{{") != std::string_view::npos; }
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_SUMMARY_HPP_
@@ -0,0 +1,107 @@
+#include "templates.hpp"
+
+#include <algorithm>
+
+namespace wxml {
+
+namespace {
+
+bool same_names(const std::vector<Reference> &a, const std::vector<Reference> &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].value != b[i].value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TemplateIndex::FileTemplates &TemplateIndex::at(uint32_t file) {
+    if (file >= files_.size()) {
+        files_.resize(graph_.size());
+    }
+    return files_[file];
+}
+
+void TemplateIndex::update(const FileSummary &summary) {
+    uint32_t id = graph_.intern(summary.path);
+    FileTemplates &entry = at(id);
+    bool definitions_changed = !same_names(entry.definitions, summary.templates);
+    entry.definitions = summary.templates;
+    entry.uses = summary.template_uses;
+    rebuild(id);
+    if (!definitions_changed) {
+        return;
+    }
+    for (uint32_t source : graph_.dependents(id)) {
+        for (const Edge &edge : graph_.dependencies(source)) {
+            if (edge.target == id && edge.kind == EdgeKind::import) {
+                rebuild(source);
+                break;
+            }
+        }
+    }
+}
+
+void TemplateIndex::remove(std::string_view path) {
+    uint32_t id = graph_.find(path);
+    if (id == DependencyGraph::npos) {
+        return;
+    }
+    FileSummary empty;
+    empty.path = graph_.path(id);
+    update(empty);
+}
+
+void TemplateIndex::rebuild(uint32_t file) {
+    // Size the table for every file the graph knows, so that looking up the
+    // imported files below cannot reallocate it under `entry`.
+    files_.resize(std::max(files_.size(), graph_.size()));
+    FileTemplates &entry = files_[file];
+    entry.visible.clear();
+    auto add = [&](uint32_t owner, const std::vector<Reference> &definitions) {
+        for (uint32_t i = 0; i < definitions.size(); i++) {
+            entry.visible.try_emplace(definitions[i].value, Visible{owner, i});
+        }
+    };
+    add(file, entry.definitions);
+    for (const Edge &edge : graph_.dependencies(file)) {
+        if (edge.kind == EdgeKind::import && edge.target != file) {
+            add(edge.target, files_[edge.target].definitions);
+        }
+    }
+}
+
+std::optional<TemplateDefinition> TemplateIndex::lookup(uint32_t file, std::string_view name) const {
+    if (file >= files_.size()) {
+        return std::nullopt;
+    }
+    const auto &visible = files_[file].visible;
+    auto it = visible.find(std::string(name));
+    if (it == visible.end()) {
+        return std::nullopt;
+    }
+    const Reference &definition = files_[it->second.owner].definitions[it->second.index];
+    return TemplateDefinition{it->second.owner, definition.start_byte, definition.end_byte};
+}
+
+const std::vector<Reference> &TemplateIndex::uses(uint32_t file) const {
+    static const std::vector<Reference> none;
+    return file < files_.size() ? files_[file].uses : none;
+}
+
+std::vector<Reference> TemplateIndex::unresolved(uint32_t file) const {
+    std::vector<Reference> result;
+    for (const Reference &use : uses(file)) {
+        if (!is_dynamic(use.value) && !lookup(file, use.value)) {
+            result.push_back(use);
+        }
+    }
+    return result;
+}
+
+} // namespace wxml
@@ -0,0 +1,75 @@
+#ifndef WXML_TOOLS_TEMPLATES_HPP_
+#define WXML_TOOLS_TEMPLATES_HPP_
+
+#include "graph.hpp"
+#include "summary.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace wxml {
+
+struct TemplateDefinition {
+    uint32_t file;
+    uint32_t start_byte;
+    uint32_t end_byte;
+};
+
+// Resolves <template is="..."> against <template name="..."> the way WXML
+// does: a file sees the templates it defines and those defined by the files
+// it imports directly, but not what those files import in turn, and nothing
+// from files it includes. A local definition shadows an imported one, and
+// an earlier import shadows a later one.
+//
+// Every file keeps a table of the names visible in it, so lookups are a
+// single hash probe. The tables are rebuilt eagerly, and only for the file
+// that changed plus, when the names it defines changed, the files importing
+// it. The tables name definitions by position, so an edit that only moves
+// them needs no rebuild of the importers.
+class TemplateIndex {
+  public:
+    explicit TemplateIndex(DependencyGraph &graph) : graph_(graph) {}
+
+    // Records the templates of a file. The graph must already have been
+    // updated with the same summary.
+    void update(const FileSummary &summary);
+
+    // Forgets the templates of a deleted file; call after graph.remove().
+    void remove(std::string_view path);
+
+    // The definition `name` refers to when used in `file`, if any.
+    std::optional<TemplateDefinition> lookup(uint32_t file, std::string_view name) const;
+
+    // The static template uses of `file` that resolve to no definition.
+    std::vector<Reference> unresolved(uint32_t file) const;
+
+    const std::vector<Reference> &uses(uint32_t file) const;
+
+  private:
+    // A definition by position rather than by offsets, so that the tables of
+    // importers stay valid while a file's definitions only move.
+    struct Visible {
+        uint32_t owner;
+        uint32_t index; // into the owner's definitions
+    };
+
+    struct FileTemplates {
+        std::vector<Reference> definitions;
+        std::vector<Reference> uses;
+        std::unordered_map<std::string, Visible> visible;
+    };
+
+    FileTemplates &at(uint32_t file);
+    void rebuild(uint32_t file);
+
+    DependencyGraph &graph_;
+    std::vector<FileTemplates> files_;
+};
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_TEMPLATES_HPP_
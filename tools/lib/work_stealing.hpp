@@ -0,0 +1,85 @@
+#ifndef WXML_TOOLS_WORK_STEALING_HPP_
+#define WXML_TOOLS_WORK_STEALING_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wxml {
+
+// The number of workers to use when the caller asks for zero.
+inline unsigned default_concurrency() { return std::max(1u, std::thread::hardware_concurrency()); }
+
+// Runs fn(worker, item) for every item in [0, count) on `threads` workers.
+//
+// Each worker starts with a contiguous block of items and takes work from
+// the back of its own queue. A worker that runs dry steals from the front
+// of the other queues, so uneven item costs (one huge file in a block of
+// small ones) do not leave cores idle. No items are added once the run has
+// started, so a worker that finds every queue empty is done.
+template <typename Fn> void parallel_for(size_t count, unsigned threads, Fn &&fn) {
+    if (threads == 0) {
+        threads = default_concurrency();
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(count, 1)));
+
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<size_t> items;
+    };
+    std::vector<Queue> queues(threads);
+    for (unsigned w = 0; w < threads; w++) {
+        for (size_t i = count * w / threads, end = count * (w + 1) / threads; i < end; i++) {
+            queues[w].items.push_back(i);
+        }
+    }
+
+    auto pop = [&](unsigned w, size_t &item) {
+        std::lock_guard<std::mutex> lock(queues[w].mutex);
+        if (queues[w].items.empty()) {
+            return false;
+        }
+        item = queues[w].items.back();
+        queues[w].items.pop_back();
+        return true;
+    };
+    auto steal = [&](unsigned victim, size_t &item) {
+        std::lock_guard<std::mutex> lock(queues[victim].mutex);
+        if (queues[victim].items.empty()) {
+            return false;
+        }
+        item = queues[victim].items.front();
+        queues[victim].items.pop_front();
+        return true;
+    };
+    auto work = [&](unsigned w) {
+        size_t item;
+        for (;;) {
+            bool found = pop(w, item);
+            for (unsigned k = 1; !found && k < threads; k++) {
+                found = steal((w + k) % threads, item);
+            }
+            if (!found) {
+                return;
+            }
+            fn(w, item);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned w = 1; w < threads; w++) {
+        workers.emplace_back(work, w);
+    }
+    work(0);
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace wxml
+
+#endif // WXML_TOOLS_WORK_STEALING_HPP_
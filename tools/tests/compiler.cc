@@ -0,0 +1,137 @@
+// Compiles every example in the corpus, then checks the code generated for
+// directives, template calls, expressions and hoisting against cases whose
+// output is known. Then compiles files twice through a cache, and once more
+// after a syntax error, in a temporary directory.
+//
+//   compiler-test test/corpus
+
+#include "corpus.hpp"
+#include "lib/cache.hpp"
+#include "lib/compiler.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Case {
+    const char *source;
+    const char *expected; // must appear in the module
+    size_t hoisted;
+    size_t warnings;
+};
+
+const Case cases[] = {
+    {"<view><text>hi</text></view><view>{{a}}</view>",
+     "return [$s0, $h.el(\"view\", {}, [$h.text($h.str($d.a))])];", 1, 0},
+    {"<view wx:if=\"{{a}}\"/><view wx:elif=\"{{b}}\"/><view wx:else/>", "($d.a) ? $s0 : ($d.b) ? $s0 : $s0", 1, 0},
+    {"<view wx:for=\"{{list}}\" wx:for-item=\"x\" wx:key=\"id\" wx:if=\"{{x.on}}\">{{x.name}} {{n}}</view>",
+     "$h.list(($d.list), function (x, index) { return (x.on) ? $h.el(\"view\", {}, "
+     "[$h.text($h.str(x.name) + \" \" + $h.str($d.n))]) : null; }, \"id\")",
+     0, 0},
+    {"<template name=\"t\"><text>{{x}}</text></template><template is=\"t\" data=\"{{...item, x, y: 1}}\"/>",
+     "$t[\"t\"]({...$d.item, x: $d.x, y: 1})", 0, 0},
+    {"<template is=\"{{kind}}\"/>", "$tpl(($d.kind), {})", 0, 0},
+    {"<wxs module=\"m\">module.exports = {f: function (v) { return v; }};</wxs><view class=\"a {{m.f(b ? 'c' : d)}}\"/>",
+     "{\"class\": \"a \" + $h.str($m.m.f($d.b ? 'c' : $d.d))}", 0, 0},
+    {"<view hidden data-x=a>&lt;&#x41;&amp;</view>",
+     "$s0 = $h.el(\"view\", {\"hidden\": true, \"data-x\": \"a\"}, [$h.text(\"<A&\")])", 1, 0},
+    {"<view wx:else>x</view>", "return [$s0]", 1, 1},
+    {"<view>{{a >= b && c !== d[\"k\"]}}</view>", "$h.str($d.a >= $d.b && $d.c !== $d.d[\"k\"])", 0, 0},
+    {"<view>{{ a), (0, 1 }}</view>", "$h.el(\"view\", {}, [$h.text($h.str(undefined))])", 0, 1},
+    {"<view>{{a.constructor.constructor('x')()}}</view>", "[$h.text($h.str(undefined))]", 0, 1},
+    {"<view>{{a[\"__proto__\"]}} {{a = 1}} {{a // }}</view>", "$h.str(undefined) + \" \" + $h.str(undefined)", 0, 3},
+    {"<template is=\"t\" data=\"{{a: 1), (b}}\"/>", "$tpl(\"t\", {})", 0, 1},
+    // Names that are not identifiers are quoted, or the node skipped.
+    {"<template name=\"my-item\"><text>{{x}}</text></template><template is=\"my-item\"/>",
+     "$t[\"my-item\"] = function ($d) { return [$h.el(\"text\", {}, [$h.text($h.str($d.x))])]; };", 0, 0},
+    {"<template name='a\"b'></template><template is='a\"b'/>", "$t[\"a\\\"b\"]({})", 0, 0},
+    {"<wxs module=\"my-mod\">module.exports = 1;</wxs><view>{{my}}</view>", "$h.str($d.my)", 0, 1},
+    {"<wxs module=\"new\" src=\"./a.wxs\"/><view>{{new}}</view>", "$h.str($d.new)", 0, 1},
+};
+
+// Compiles a file with a warning and a hoisted subtree through a cache, and
+// again once it is cached, then once more after a syntax error.
+int check_files() {
+    char pattern[] = "/tmp/compiler-test-XXXXXX";
+    if (::mkdtemp(pattern) == nullptr) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+    std::filesystem::path dir = pattern;
+    std::vector<std::string> inputs = {(dir / "page.wxml").string()};
+    std::vector<std::string> outputs = {(dir / "out" / "page.wxml.js").string()};
+    std::ofstream(inputs[0]) << "<view wx:else>x</view><view>{{a}}</view>";
+
+    int failures = 0;
+    wxml::ParseCache cache((dir / "cache").string(), 1 << 20);
+    for (bool cached : {false, true}) {
+        wxml::CompileResult result = wxml::compile_files(inputs, outputs, 1, &cache)[0];
+        if (result.failed || result.has_error || result.cached != cached || result.hoisted != 1 ||
+            result.warnings.size() != 1 || result.warnings[0] != "1:1: wx:else without a wx:if before it" ||
+            !std::filesystem::exists(outputs[0])) {
+            std::fprintf(stderr, "FAIL %s compile: cached %d, %zu hoisted, %zu warnings\n",
+                         cached ? "cached" : "first", result.cached, result.hoisted, result.warnings.size());
+            failures++;
+        }
+    }
+
+    std::ofstream(inputs[0]) << "<view>";
+    wxml::CompileResult result = wxml::compile_files(inputs, outputs, 1, &cache)[0];
+    if (result.failed || !result.has_error || std::filesystem::exists(outputs[0])) {
+        std::fprintf(stderr, "FAIL syntax error: the output of the last run is %s\n",
+                     std::filesystem::exists(outputs[0]) ? "left" : "gone, but the result is wrong");
+        failures++;
+    }
+    std::filesystem::remove_all(dir);
+    return failures;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::vector<corpus::Example> examples;
+    if (!corpus::read_args(argc, argv, "compiler-test", &examples)) {
+        return 2;
+    }
+
+    wxml::Parser parser;
+    wxml::Compiler compiler;
+    std::string module;
+    int failures = 0;
+    size_t compiled = 0;
+    for (const corpus::Example &example : examples) {
+        wxml::Tree tree = parser.parse(example.source);
+        if (!tree || ts_node_has_error(tree.root())) {
+            continue;
+        }
+        if (!compiler.compile(tree.root(), example.source, module) || module.empty()) {
+            std::fprintf(stderr, "FAIL %s: does not compile\n", example.name.c_str());
+            failures++;
+        }
+        compiled++;
+    }
+
+    for (const Case &test : cases) {
+        std::string source = test.source;
+        wxml::Tree tree = parser.parse(source);
+        if (!tree || !compiler.compile(tree.root(), source, module)) {
+            std::fprintf(stderr, "FAIL %s: does not compile\n", test.source);
+            failures++;
+        } else if (module.find(test.expected) == std::string::npos || compiler.hoisted() != test.hoisted ||
+                   compiler.warnings().size() != test.warnings) {
+            std::fprintf(stderr, "FAIL %s: expected %s with %zu hoisted and %zu warnings, got:\n%s\n", test.source,
+                         test.expected, test.hoisted, test.warnings, module.c_str());
+            failures++;
+        }
+    }
+
+    failures += check_files();
+
+    std::printf("%zu examples, %zu cases, %d failures\n", compiled, sizeof cases / sizeof cases[0], failures);
+    return failures > 0 ? 1 : 0;
+}
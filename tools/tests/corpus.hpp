@@ -0,0 +1,113 @@
+#ifndef WXML_TOOLS_TESTS_CORPUS_HPP_
+#define WXML_TOOLS_TESTS_CORPUS_HPP_
+
+#include <tree_sitter/tree-sitter-wxml.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace corpus {
+
+struct Example {
+    std::string name; // "file.txt: title"
+    std::string source;
+};
+
+inline bool is_rule(const std::string &line, char c) {
+    return line.size() >= 3 && line.find_first_not_of(c) == std::string::npos;
+}
+
+// The examples of the tree-sitter corpus files in `dir`, in file order. Each
+// example is a title between two lines of '=', then the source up to a line
+// of '-', then the expected tree, which is skipped.
+inline std::vector<Example> read(const std::filesystem::path &dir) {
+    std::vector<std::filesystem::path> files;
+    for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+        if (entry.path().extension() == ".txt") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<Example> examples;
+    for (const auto &path : files) {
+        std::ifstream in(path);
+        std::string line;
+        enum { before, title, source, expected } state = before;
+        while (std::getline(in, line)) {
+            if (is_rule(line, '=')) {
+                if (state == title) {
+                    state = source;
+                } else {
+                    examples.push_back({path.filename().string(), {}});
+                    state = title;
+                }
+            } else if (state == title) {
+                examples.back().name += ": " + line;
+            } else if (state == source && is_rule(line, '-')) {
+                state = expected;
+            } else if (state == source) {
+                examples.back().source += line + "\n";
+            }
+        }
+    }
+    return examples;
+}
+
+// Reads the corpus directory that is the only argument of `program`, or
+// prints its usage and returns false.
+inline bool read_args(int argc, char **argv, const char *program, std::vector<Example> *examples) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s CORPUS-DIR\n", program);
+        return false;
+    }
+    *examples = read(argv[1]);
+    return true;
+}
+
+// The S-expression of `tree`, without its comments unless `comments`.
+inline std::string sexp(const wxml::Tree &tree, bool comments = true) {
+    char *text = ts_node_string(tree.root());
+    std::string result = text != nullptr ? text : "";
+    std::free(text);
+    for (size_t at; !comments && (at = result.find(" (comment)")) != std::string::npos;) {
+        result.erase(at, 10);
+    }
+    return result;
+}
+
+// The text of every node of the given kinds, in preorder, for checking that
+// a rewrite kept those bytes as they were.
+template <TSSymbol... Kinds> std::vector<std::string_view> verbatim(const wxml::Tree &tree, std::string_view source) {
+    std::vector<std::string_view> slices;
+    for (TSNode node : wxml::Preorder<Kinds...>(tree.root())) {
+        uint32_t start = ts_node_start_byte(node);
+        slices.push_back(source.substr(start, ts_node_end_byte(node) - start));
+    }
+    return slices;
+}
+
+// Runs `check` on the source of every example and returns how many failed.
+// `check` returns an empty string if the example passes, or what went
+// wrong, which is printed with the example's name.
+template <typename Check> int check_all(const std::vector<Example> &examples, Check check) {
+    int failures = 0;
+    for (const Example &example : examples) {
+        std::string error = check(example.source);
+        if (!error.empty()) {
+            std::fprintf(stderr, "FAIL %s: %s\n", example.name.c_str(), error.c_str());
+            failures++;
+        }
+    }
+    return failures;
+}
+
+} // namespace corpus
+
+#endif // WXML_TOOLS_TESTS_CORPUS_HPP_
@@ -0,0 +1,109 @@
+// Checks that a Document's symbols follow an edit above them, then edits
+// every example in the corpus at random and checks after each reparse that
+// the derived items match those of a document opened on the new text.
+//
+//   document-test test/corpus
+
+#include "corpus.hpp"
+#include "lib/document.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+using SymbolKey = std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, std::string>;
+using SpanKey = std::tuple<uint32_t, uint32_t, int>;
+
+std::vector<SymbolKey> keys(const wxml::Document &document) {
+    std::vector<SymbolKey> result;
+    for (const wxml::DocumentSymbol &symbol : document.symbols()) {
+        result.emplace_back(symbol.start_byte, symbol.end_byte, symbol.selection.start_byte,
+                            symbol.selection.end_byte, symbol.name);
+    }
+    return result;
+}
+
+std::vector<SpanKey> spans(const wxml::Document &document) {
+    std::vector<SpanKey> result;
+    for (const wxml::Diagnostic &diagnostic : document.diagnostics()) {
+        result.emplace_back(diagnostic.start_byte, diagnostic.end_byte, -1);
+    }
+    for (const wxml::SemanticToken &token : document.tokens()) {
+        result.emplace_back(token.start_byte, token.end_byte, static_cast<int>(token.type));
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::vector<corpus::Example> examples;
+    if (!corpus::read_args(argc, argv, "document-test", &examples)) {
+        return 2;
+    }
+    wxml::Parser parser;
+    int failures = 0;
+
+    // Text inserted above a template moves both of its ranges.
+    {
+        std::string source = "<view id=\"a\"/>\n<template name=\"t\"><text>x</text></template>\n";
+        wxml::Document document(source, parser);
+        std::vector<SymbolKey> before = keys(document);
+        std::string inserted = "<!-- c -->\n";
+        document.edit(wxml::Position{1, 0}, wxml::Position{1, 0}, inserted, wxml::PositionEncoding::utf16);
+        document.reparse(parser);
+        std::vector<SymbolKey> after = keys(document);
+        uint32_t shift = static_cast<uint32_t>(inserted.size());
+        bool moved = before.size() == 2 && after.size() == 2 && after[0] == before[0] &&
+                     std::get<0>(after[1]) == std::get<0>(before[1]) + shift &&
+                     std::get<2>(after[1]) == std::get<2>(before[1]) + shift;
+        if (!moved || after != keys(wxml::Document(document.text(), parser))) {
+            std::fputs("FAIL symbol ranges after an edit above them\n", stderr);
+            failures++;
+        }
+
+        // Positions past the end of the text are clamped to it.
+        const std::string &text = document.text();
+        uint32_t end = static_cast<uint32_t>(text.size());
+        wxml::Position last = document.lines().position(text, end, wxml::PositionEncoding::utf16);
+        wxml::Position past = document.lines().position(text, end + 10, wxml::PositionEncoding::utf16);
+        if (past.line != last.line || past.character != last.character) {
+            std::fputs("FAIL position past the end of the text\n", stderr);
+            failures++;
+        }
+    }
+
+    std::mt19937 random(1);
+    const char *inserts[] = {"", "x", "<", ">", "\"", "{{", "}}", " id=\"k\"", "<template name=\"n\"/>", "\n"};
+    size_t edits = 0;
+    for (const corpus::Example &example : examples) {
+        wxml::Document document(example.source, parser);
+        for (int i = 0; i < 40; i++) {
+            uint32_t size = static_cast<uint32_t>(document.text().size());
+            uint32_t start = static_cast<uint32_t>(random() % (size + 1));
+            uint32_t end = std::min<uint32_t>(size, start + static_cast<uint32_t>(random() % 4));
+            const char *insert = inserts[random() % (sizeof inserts / sizeof inserts[0])];
+            auto position = [&](uint32_t byte) {
+                return document.lines().position(document.text(), byte, wxml::PositionEncoding::utf8);
+            };
+            document.edit(position(start), position(end), insert, wxml::PositionEncoding::utf8);
+            document.reparse(parser);
+            edits++;
+
+            wxml::Document fresh(document.text(), parser);
+            if (keys(document) != keys(fresh) || spans(document) != spans(fresh)) {
+                std::fprintf(stderr, "FAIL %s: items after edit %d differ from a fresh document:\n%s\n",
+                             example.name.c_str(), i, document.text().c_str());
+                failures++;
+                break;
+            }
+        }
+    }
+
+    std::printf("%zu examples, %zu edits, %d failures\n", examples.size(), edits, failures);
+    return failures > 0 ? 1 : 0;
+}
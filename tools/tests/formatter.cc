@@ -0,0 +1,87 @@
+// Formats every example in the corpus and checks that the output parses to
+// the same tree, keeps comments, raw text, interpolations, entities and
+// attribute values byte for byte, and is left unchanged when formatted
+// again. All examples are then joined, after a wxs module larger than an
+// output chunk, into one document that streams through several chunks and
+// is checked the same way.
+//
+//   formatter-test test/corpus
+
+#include "corpus.hpp"
+#include "lib/formatter.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Returns an empty string if `source` survives formatting, or what went wrong.
+std::string check(wxml::Parser &parser, wxml::Formatter &formatter, const std::string &source) {
+    wxml::Tree tree = parser.parse(source);
+    if (!tree || ts_node_has_error(tree.root())) {
+        return "does not parse";
+    }
+    std::string once;
+    if (!formatter.format(tree.root(), source, once)) {
+        return "formatting failed";
+    }
+    wxml::Tree reparsed = parser.parse(once);
+    if (!reparsed || ts_node_has_error(reparsed.root())) {
+        return "formatted output does not parse:\n" + once;
+    }
+    if (corpus::sexp(reparsed) != corpus::sexp(tree)) {
+        return "formatted output parses differently:\n" + once;
+    }
+    using namespace wxml::symbol;
+    auto kept = corpus::verbatim<comment, raw_text, interpolation, entity, attribute_value, quoted_attribute_value>;
+    if (kept(reparsed, once) != kept(tree, source)) {
+        return "formatting changed bytes that must be kept:\n" + once;
+    }
+    std::string twice;
+    formatter.format(reparsed.root(), once, twice);
+    if (twice != once) {
+        return "formatting is not idempotent:\n" + once + "---\n" + twice;
+    }
+    return {};
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::vector<corpus::Example> examples;
+    if (!corpus::read_args(argc, argv, "formatter-test", &examples)) {
+        return 2;
+    }
+
+    wxml::Parser parser;
+    wxml::Formatter formatter;
+    wxml::Formatter tabs({0, true});
+    int failures =
+        corpus::check_all(examples, [&](const std::string &source) { return check(parser, formatter, source); });
+    failures += corpus::check_all(examples, [&](const std::string &source) {
+        std::string error = check(parser, tabs, source);
+        return error.empty() ? error : "with tabs: " + error;
+    });
+    std::string joined;
+    for (const corpus::Example &example : examples) {
+        joined += example.source + "\n";
+    }
+
+    std::string large = "<wxs module=\"big\">\n";
+    while (large.size() < 2 * wxml::Formatter::chunk_size) {
+        large += "  var x = [1,   2];\n";
+    }
+    large += "</wxs>\n";
+    while (large.size() < 6 * wxml::Formatter::chunk_size) {
+        large += joined;
+    }
+    std::string error = check(parser, formatter, large);
+    if (!error.empty()) {
+        std::fprintf(stderr, "FAIL joined corpus (%zu bytes): %.2000s\n", large.size(), error.c_str());
+        failures++;
+    }
+
+    std::printf("%zu examples, %d failures\n", examples.size(), failures);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+// Checks the built-in rules against cases whose findings are known, then
+// edits every example in the corpus at random through a Document and
+// checks after each reparse that relinting the changed ranges found
+// exactly what linting the whole new text finds.
+//
+//   linter-test test/corpus
+
+#include "corpus.hpp"
+#include "lib/linter.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+struct Case {
+    const char *source;
+    std::vector<std::string> rules; // in source order
+};
+
+const std::vector<Case> cases = {
+    {"<view wx:for=\"{{list}}\">{{item}}</view>", {"for-without-key"}},
+    {"<view wx:for=\"{{list}}\" wx:key=\"id\" wx:if=\"{{item.on}}\"/>", {"if-with-for"}},
+    {"<view class=\"a\" id=\"x\" class=\"b\"/>", {"duplicate-attribute"}},
+    {"<view a0 a1 a2 a3 a4 a5 a6 a7 a8 a9 a10 a11 a12 a13 a14 a15 a16 "
+     "a17 a18 a19 a20 a21 a22 a23 a24 a25 a26 a27 a28 a29 a30 a31 a32 a33 a1/>", {"duplicate-attribute"}},
+    {"<view wx:if=\"{{a}}\"/><view wx:elif=\"{{b}}\"/><view wx:else/><view wx:else/>", {"orphan-else"}},
+    {"<view>text</view><view wx:elif=\"{{b}}\"/>", {"orphan-else"}},
+    {"<block wx:if=\"{{a}}\"><view/></block><!-- c --><block wx:else><view wx:if=\"false\"/></block>",
+     {"directive-without-interpolation"}},
+    {"<view wx:for-items=\"{{list}}\" wx:key=\"*this\"/>", {"deprecated-for-items"}},
+    {"<text>{{ }}</text>", {"empty-interpolation"}},
+    {"<import src=\"\"/><include src=\"a.wxml\"/>", {"missing-src"}},
+    {"<template><view/></template><template name=\"t\" is=\"t\"/>", {"template-name", "template-name"}},
+    {"<wxs src=\"./a.wxs\"/>", {"wxs-module"}},
+};
+
+using Key = std::tuple<uint32_t, uint32_t, uint16_t, std::string>;
+
+std::vector<Key> keys(const std::vector<wxml::LintDiagnostic> &diagnostics) {
+    std::vector<Key> result;
+    for (const wxml::LintDiagnostic &diagnostic : diagnostics) {
+        result.emplace_back(diagnostic.start_byte, diagnostic.end_byte, diagnostic.rule, std::string(diagnostic.message));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::vector<corpus::Example> examples;
+    if (!corpus::read_args(argc, argv, "linter-test", &examples)) {
+        return 2;
+    }
+    wxml::RuleSet rules;
+    wxml::add_builtin_rules(rules);
+    wxml::Parser parser;
+    wxml::Linter linter(rules);
+    int failures = 0;
+
+    for (const Case &test : cases) {
+        std::string source = test.source;
+        wxml::Tree tree = parser.parse(source);
+        linter.lint(tree.root(), source);
+        std::vector<wxml::LintDiagnostic> found = linter.diagnostics();
+        std::stable_sort(found.begin(), found.end(), [](const wxml::LintDiagnostic &a, const wxml::LintDiagnostic &b) {
+            return a.start_byte < b.start_byte;
+        });
+        std::vector<std::string> names;
+        for (const wxml::LintDiagnostic &diagnostic : found) {
+            names.emplace_back(rules.rules()[diagnostic.rule]->name());
+        }
+        if (names != test.rules) {
+            std::fprintf(stderr, "FAIL %s: got", test.source);
+            for (const std::string &name : names) {
+                std::fprintf(stderr, " %s", name.c_str());
+            }
+            std::fputc('\n', stderr);
+            failures++;
+        }
+    }
+
+    // Editing only the sibling before a wx:else rechecks it, past comments
+    // and far from the start of the document.
+    {
+        std::string source;
+        for (int i = 0; i < 100; i++) {
+            source += "<view/>";
+        }
+        size_t at = source.size();
+        source += "<view wx:if=\"{{a}}\"/><!-- c --><view wx:else/>";
+        wxml::Document document(source, parser, &rules);
+        auto position = [&](size_t byte) {
+            uint32_t offset = static_cast<uint32_t>(byte);
+            return document.lines().position(document.text(), offset, wxml::PositionEncoding::utf8);
+        };
+        // Removes ` wx:if="{{a}}"`.
+        document.edit(position(at + 5), position(at + 19), "", wxml::PositionEncoding::utf8);
+        document.reparse(parser);
+        if (document.lint().size() != 1 || rules.rules()[document.lint()[0].rule]->name() != "orphan-else") {
+            std::fprintf(stderr, "FAIL removing wx:if: %zu diagnostics\n", document.lint().size());
+            failures++;
+        }
+    }
+
+    // The cases too, so that edits hit every rule.
+    for (const Case &test : cases) {
+        examples.push_back(corpus::Example{"case", test.source});
+    }
+    std::mt19937 random(1);
+    const char *inserts[] = {"", "x", "<", ">", "\"", "{{", "}}", " wx:else", " wx:if=\"{{a}}\"", "<view/>", "\n"};
+    size_t edits = 0;
+    for (const corpus::Example &example : examples) {
+        wxml::Document document(example.source, parser, &rules);
+        for (int i = 0; i < 40; i++) {
+            uint32_t size = static_cast<uint32_t>(document.text().size());
+            uint32_t start = static_cast<uint32_t>(random() % (size + 1));
+            uint32_t end = std::min<uint32_t>(size, start + static_cast<uint32_t>(random() % 4));
+            const char *insert = inserts[random() % (sizeof inserts / sizeof inserts[0])];
+            auto position = [&](uint32_t byte) {
+                return document.lines().position(document.text(), byte, wxml::PositionEncoding::utf8);
+            };
+            document.edit(position(start), position(end), insert, wxml::PositionEncoding::utf8);
+            document.reparse(parser);
+            edits++;
+
+            wxml::Tree fresh = parser.parse(document.text());
+            linter.lint(fresh.root(), document.text());
+            if (keys(document.lint()) != keys(linter.diagnostics())) {
+                std::fprintf(stderr, "FAIL %s: relinting after edit %d differs from linting:\n%s\n",
+                             example.name.c_str(), i, document.text().c_str());
+                failures++;
+                break;
+            }
+        }
+    }
+
+    std::printf("%zu cases, %zu edits, %d failures\n", cases.size(), edits, failures);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+// Minifies every example in the corpus and checks that the output parses to
+// the same tree less its comments, keeps text, raw text, interpolations,
+// entities and attribute values byte for byte, is no longer than the input,
+// is written by writev exactly as gathered, and does not change when
+// minified again.
+//
+//   minifier-test test/corpus
+
+#include "corpus.hpp"
+#include "lib/minifier.hpp"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string written(const wxml::Minifier &minifier) {
+    FILE *file = std::tmpfile();
+    if (file == nullptr || !minifier.write(fileno(file))) {
+        return "<write failed>";
+    }
+    std::string out(minifier.size(), '\0');
+    std::rewind(file);
+    out.resize(std::fread(out.data(), 1, out.size(), file));
+    bool more = std::fgetc(file) != EOF;
+    std::fclose(file);
+    return more ? "<wrote too much>" : out;
+}
+
+// Returns an empty string if `source` survives minifying, or what went wrong.
+std::string check(wxml::Parser &parser, wxml::Minifier &minifier, const std::string &source) {
+    wxml::Tree tree = parser.parse(source);
+    if (!tree || ts_node_has_error(tree.root())) {
+        return "does not parse";
+    }
+    if (!minifier.minify(tree.root(), source)) {
+        return "minifying failed";
+    }
+    std::string once = minifier.str();
+    if (once.size() != minifier.size() || once.size() > source.size()) {
+        return "wrong output size:\n" + once;
+    }
+    if (written(minifier) != once) {
+        return "writev output differs from the gather list:\n" + once;
+    }
+    wxml::Tree reparsed = parser.parse(once);
+    if (!reparsed || ts_node_has_error(reparsed.root())) {
+        return "minified output does not parse:\n" + once;
+    }
+    if (corpus::sexp(reparsed, false) != corpus::sexp(tree, false)) {
+        return "minified output parses differently:\n" + once;
+    }
+    using namespace wxml::symbol;
+    auto kept = corpus::verbatim<text, raw_text, interpolation, entity, attribute_value, quoted_attribute_value>;
+    if (kept(reparsed, once) != kept(tree, source)) {
+        return "minifying changed bytes that must be kept:\n" + once;
+    }
+    minifier.minify(reparsed.root(), once);
+    if (minifier.str() != once) {
+        return "minifying is not idempotent:\n" + once + "\n---\n" + minifier.str();
+    }
+    return {};
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::vector<corpus::Example> examples;
+    if (!corpus::read_args(argc, argv, "minifier-test", &examples)) {
+        return 2;
+    }
+    // Attributes the source does not separate must not grow the output.
+    examples.push_back({"case", "<view id=\"a\"class=\"b\">x</view>"});
+    examples.push_back({"case", "<icon x=\"1\"y='2' z=\"{{ w }}\"/>"});
+
+    wxml::Parser parser;
+    wxml::Minifier minifier;
+    size_t bytes = 0;
+    size_t minified = 0;
+    int failures = corpus::check_all(examples, [&](const std::string &source) {
+        std::string error = check(parser, minifier, source);
+        if (error.empty()) {
+            wxml::Tree tree = parser.parse(source);
+            minifier.minify(tree.root(), source);
+            bytes += source.size();
+            minified += minifier.size();
+        }
+        return error;
+    });
+
+    std::printf("%zu examples, %d failures, %zu -> %zu bytes\n", examples.size(), failures, bytes, minified);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,71 @@
+// Checks that template lookups through imports follow the definitions as
+// the files defining them are edited.
+//
+//   templates-test
+
+#include "lib/graph.hpp"
+#include "lib/templates.hpp"
+
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool ok, const char *what) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL %s\n", what);
+        failures++;
+    }
+}
+
+wxml::FileSummary file(std::string path, std::vector<wxml::Reference> templates,
+                       std::vector<wxml::Reference> imports = {}) {
+    wxml::FileSummary summary;
+    summary.path = std::move(path);
+    summary.templates = std::move(templates);
+    summary.imports = std::move(imports);
+    return summary;
+}
+
+bool defined_at(const wxml::TemplateIndex &index, uint32_t file, const char *name, uint32_t owner,
+                uint32_t start_byte) {
+    std::optional<wxml::TemplateDefinition> definition = index.lookup(file, name);
+    return definition && definition->file == owner && definition->start_byte == start_byte;
+}
+
+} // namespace
+
+int main() {
+    wxml::DependencyGraph graph;
+    wxml::TemplateIndex index(graph);
+    auto update = [&](const wxml::FileSummary &summary) {
+        graph.update(summary);
+        index.update(summary);
+    };
+
+    update(file("lib.wxml", {{"card", 0, 40}, {"row", 40, 80}}));
+    update(file("page.wxml", {{"row", 20, 50}}, {{"lib.wxml", 0, 24}}));
+    uint32_t lib = graph.find("lib.wxml"), page = graph.find("page.wxml");
+    expect(defined_at(index, page, "card", lib, 0), "imported definition");
+    expect(defined_at(index, page, "row", page, 20), "local definition shadows the import");
+
+    // Text inserted above both definitions moves them without renaming any.
+    update(file("lib.wxml", {{"card", 10, 50}, {"row", 50, 90}}));
+    expect(defined_at(index, page, "card", lib, 10), "moved definition, seen from the importer");
+    expect(defined_at(index, lib, "row", lib, 50), "moved definition, seen from its file");
+
+    update(file("lib.wxml", {{"row", 10, 50}}));
+    expect(!index.lookup(page, "card"), "removed definition");
+    expect(defined_at(index, page, "row", page, 20), "local definition after the import changed");
+
+    graph.remove("lib.wxml");
+    index.remove("lib.wxml");
+    expect(!index.lookup(page, "card") && index.unresolved(page).empty(), "deleted file");
+
+    std::printf("%d failures\n", failures);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,128 @@
+// wxml-compile: compile the WXML files of a mini-program package into JS
+// render modules.
+//
+//   wxml-compile [-j threads] [-o out-dir] [-c cache-dir [-s max-MB]] [-q] DIR|FILE...
+//
+// With -o each file is written under out-dir at its path relative to the
+// argument it was found under, with ".js" appended, and the output of a
+// file with syntax errors is removed; without it files are only compiled.
+// Prints "path\tstatus\thoisted" for every file, unless -q,
+// warnings and a total on stderr. With -c, modules are kept in an on-disk
+// cache addressed by file contents, which is trimmed to -s megabytes
+// (default 256) after the run.
+
+#include "lib/compiler.hpp"
+#include "lib/indexer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+void usage(FILE *out) {
+    std::fputs("usage: wxml-compile [-j threads] [-o out-dir] [-c cache-dir [-s max-MB]] [-q] DIR|FILE...\n", out);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    namespace fs = std::filesystem;
+    unsigned threads = 0;
+    const char *out_dir = nullptr;
+    const char *cache_dir = nullptr;
+    uint64_t cache_megabytes = 256;
+    bool quiet = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:o:c:s:qh")) != -1) {
+        switch (opt) {
+            case 'j':
+                threads = static_cast<unsigned>(std::strtoul(optarg, nullptr, 10));
+                break;
+            case 'o':
+                out_dir = optarg;
+                break;
+            case 'c':
+                cache_dir = optarg;
+                break;
+            case 's':
+                cache_megabytes = std::strtoull(optarg, nullptr, 10);
+                break;
+            case 'q':
+                quiet = true;
+                break;
+            case 'h':
+                usage(stdout);
+                return 0;
+            default:
+                usage(stderr);
+                return 2;
+        }
+    }
+    if (optind >= argc) {
+        usage(stderr);
+        return 2;
+    }
+
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+    for (int i = optind; i < argc; i++) {
+        std::error_code ec;
+        bool single = fs::is_regular_file(argv[i], ec);
+        for (std::string &path : wxml::find_wxml_files(argv[i])) {
+            if (out_dir != nullptr) {
+                fs::path relative = single ? fs::path(path).filename() : fs::path(path).lexically_relative(argv[i]);
+                outputs.push_back((fs::path(out_dir) / relative).string() + ".js");
+            }
+            inputs.push_back(std::move(path));
+        }
+    }
+
+    std::unique_ptr<wxml::ParseCache> cache;
+    if (cache_dir != nullptr) {
+        cache = std::make_unique<wxml::ParseCache>(cache_dir, cache_megabytes << 20);
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<wxml::CompileResult> results = wxml::compile_files(inputs, outputs, threads, cache.get());
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t failed = 0;
+    size_t with_errors = 0;
+    size_t cached = 0;
+    size_t hoisted = 0;
+    size_t warnings = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const wxml::CompileResult &result = results[i];
+        if (result.failed) {
+            std::fprintf(stderr, "wxml-compile: %s: %s\n", inputs[i].c_str(), std::strerror(result.error));
+            failed++;
+            continue;
+        }
+        if (result.has_error) {
+            std::fprintf(stderr, "wxml-compile: %s: syntax errors, not compiled\n", inputs[i].c_str());
+            with_errors++;
+            continue;
+        }
+        for (const std::string &warning : result.warnings) {
+            std::fprintf(stderr, "%s:%s\n", inputs[i].c_str(), warning.c_str());
+        }
+        warnings += result.warnings.size();
+        cached += result.cached ? 1 : 0;
+        hoisted += result.hoisted;
+        if (!quiet) {
+            std::printf("%s\t%s\t%zu\n", inputs[i].c_str(), result.cached ? "cached" : "compiled", result.hoisted);
+        }
+    }
+    std::fprintf(stderr, "%zu files (%zu failed, %zu with errors, %zu cached)\t%zu hoisted\t%zu warnings\t%.3f s\n",
+                 inputs.size(), failed, with_errors, cached, hoisted, warnings, seconds);
+    if (cache != nullptr) {
+        cache->trim();
+        std::fprintf(stderr, "%s\n", wxml::to_string(cache->report()).c_str());
+    }
+    return failed > 0 || with_errors > 0 ? 2 : 0;
+}
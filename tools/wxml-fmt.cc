@@ -0,0 +1,251 @@
+// wxml-fmt: format WXML files.
+//
+//   wxml-fmt [-l | -w] [-i width | -t] [DIR|FILE...]
+//   wxml-fmt -b [-n rounds] DIR|FILE...
+//
+// Without files, stdin is formatted to stdout. Files are formatted to
+// stdout too, unless -w rewrites the ones that change in place or -l just
+// lists them. Files with syntax errors are reported and left alone. -b
+// formats the files in memory `rounds` times and prints the parse and
+// format throughput.
+
+#include "lib/formatter.hpp"
+#include "lib/indexer.hpp"
+#include "lib/mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class Mode {
+    print,
+    list,
+    write,
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool write_all(int fd, std::string_view bytes) {
+    while (!bytes.empty()) {
+        ssize_t n = ::write(fd, bytes.data(), bytes.size());
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes.remove_prefix(static_cast<size_t>(n));
+    }
+    return true;
+}
+
+// Replaces `path` with `text` through a temporary file in the same
+// directory, keeping its permissions.
+bool replace_file(const std::string &path, std::string_view text) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return false;
+    }
+    std::string temp = path + ".wxml-fmt~";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, st.st_mode & 07777);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = write_all(fd, text);
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool read_stdin(std::string &text) {
+    char chunk[65536];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), stdin)) > 0) {
+        text.append(chunk, n);
+    }
+    return !std::ferror(stdin);
+}
+
+int format_stdin(wxml::Formatter &formatter) {
+    std::string text;
+    if (!read_stdin(text)) {
+        std::perror("wxml-fmt: stdin");
+        return 1;
+    }
+    wxml::Parser parser;
+    wxml::Tree tree = parser.parse(text);
+    wxml::FormatSink out = [](std::string_view bytes) { return write_all(STDOUT_FILENO, bytes); };
+    if (!tree || ts_node_has_error(tree.root())) {
+        std::fputs("wxml-fmt: <stdin>: syntax errors\n", stderr);
+        write_all(STDOUT_FILENO, text);
+        return 1;
+    }
+    return formatter.format(tree.root(), text, out) ? 0 : 1;
+}
+
+int format_files(wxml::Formatter &formatter, const std::vector<std::string> &paths, Mode mode) {
+    wxml::Parser parser;
+    std::string formatted;
+    wxml::FormatSink out = [](std::string_view bytes) { return write_all(STDOUT_FILENO, bytes); };
+    int status = 0;
+    for (const std::string &path : paths) {
+        wxml::MappedFile file;
+        if (!file.open(path)) {
+            std::fprintf(stderr, "wxml-fmt: %s: %s\n", path.c_str(), std::strerror(errno));
+            status = 1;
+            continue;
+        }
+        std::string_view source = file.data();
+        wxml::Tree tree = parser.parse(source);
+        if (!tree || ts_node_has_error(tree.root())) {
+            std::fprintf(stderr, "wxml-fmt: %s: syntax errors, left unchanged\n", path.c_str());
+            status = 1;
+            continue;
+        }
+        if (mode == Mode::print) {
+            formatter.format(tree.root(), source, out);
+            continue;
+        }
+        if (mode == Mode::list) {
+            // Compare as the output streams, stopping at the first difference.
+            size_t offset = 0;
+            wxml::FormatSink compare = [&](std::string_view bytes) {
+                bool same = source.substr(offset, bytes.size()) == bytes;
+                offset += bytes.size();
+                return same;
+            };
+            if (!formatter.format(tree.root(), source, compare) || offset != source.size()) {
+                std::printf("%s\n", path.c_str());
+                status = 1;
+            }
+            continue;
+        }
+        formatter.format(tree.root(), source, formatted);
+        if (formatted != source && !replace_file(path, formatted)) {
+            std::fprintf(stderr, "wxml-fmt: %s: %s\n", path.c_str(), std::strerror(errno));
+            status = 1;
+        }
+    }
+    return status;
+}
+
+int bench(wxml::Formatter &formatter, const std::vector<std::string> &paths, int rounds) {
+    std::vector<wxml::MappedFile> files(paths.size());
+    uint64_t bytes = 0;
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (!files[i].open(paths[i])) {
+            std::fprintf(stderr, "wxml-fmt: %s: %s\n", paths[i].c_str(), std::strerror(errno));
+            return 1;
+        }
+        bytes += files[i].size();
+    }
+    wxml::Parser parser;
+    uint64_t written = 0;
+    wxml::FormatSink discard = [&written](std::string_view chunk) {
+        written += chunk.size();
+        return true;
+    };
+    double parse_seconds = 0;
+    double format_seconds = 0;
+    size_t skipped = 0;
+    for (int round = 0; round < rounds; round++) {
+        for (const wxml::MappedFile &file : files) {
+            auto start = std::chrono::steady_clock::now();
+            wxml::Tree tree = parser.parse(file.data());
+            parse_seconds += seconds_since(start);
+            start = std::chrono::steady_clock::now();
+            if (!tree || !formatter.format(tree.root(), file.data(), discard)) {
+                skipped++;
+            }
+            format_seconds += seconds_since(start);
+        }
+    }
+    double total = static_cast<double>(bytes) * rounds / 1e6;
+    std::printf("%zu files, %.1f MB x %d rounds (%zu skipped for syntax errors)\n", files.size(),
+                static_cast<double>(bytes) / 1e6, rounds, skipped / static_cast<size_t>(rounds > 0 ? rounds : 1));
+    std::printf("parse  %.3f s\t%.2f MB/s\n", parse_seconds, parse_seconds > 0 ? total / parse_seconds : 0.0);
+    std::printf("format %.3f s\t%.2f MB/s\t%.1f MB written\n", format_seconds,
+                format_seconds > 0 ? total / format_seconds : 0.0, static_cast<double>(written) / 1e6);
+    return 0;
+}
+
+void usage(FILE *out) {
+    std::fputs("usage: wxml-fmt [-l | -w] [-i width | -t] [DIR|FILE...]\n"
+               "       wxml-fmt -b [-n rounds] DIR|FILE...\n",
+               out);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Mode mode = Mode::print;
+    wxml::FormatOptions options;
+    bool benchmark = false;
+    int rounds = 10;
+    int opt;
+    while ((opt = getopt(argc, argv, "lwi:tbn:h")) != -1) {
+        switch (opt) {
+            case 'l':
+                mode = Mode::list;
+                break;
+            case 'w':
+                mode = Mode::write;
+                break;
+            case 'i':
+                options.indent_width = static_cast<uint32_t>(std::strtoul(optarg, nullptr, 10));
+                break;
+            case 't':
+                options.tabs = true;
+                break;
+            case 'b':
+                benchmark = true;
+                break;
+            case 'n':
+                rounds = std::atoi(optarg);
+                break;
+            case 'h':
+                usage(stdout);
+                return 0;
+            default:
+                usage(stderr);
+                return 2;
+        }
+    }
+
+    std::vector<std::string> paths;
+    for (int i = optind; i < argc; i++) {
+        std::vector<std::string> found = wxml::find_wxml_files(argv[i]);
+        paths.insert(paths.end(), found.begin(), found.end());
+    }
+    wxml::Formatter formatter(options);
+    if (benchmark) {
+        if (paths.empty()) {
+            usage(stderr);
+            return 2;
+        }
+        return bench(formatter, paths, rounds);
+    }
+    if (optind == argc) {
+        if (mode != Mode::print) {
+            usage(stderr);
+            return 2;
+        }
+        return format_stdin(formatter);
+    }
+    return format_files(formatter, paths, mode);
+}
@@ -0,0 +1,131 @@
+// wxml-index: summarize every .wxml file of a project in parallel.
+//
+//   wxml-index [-j threads] [-o json|none] [-c cache-dir [-s max-MB]] DIR|FILE...
+//
+// With -o json (the default) each file's summary is written to stdout as
+// one JSON object per line. A throughput report goes to stderr. With -c,
+// summaries are kept in an on-disk cache addressed by file contents, which
+// is trimmed to -s megabytes (default 256) after the run.
+
+#include "lib/indexer.hpp"
+#include "lib/json.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+void append_references(std::string &out, const char *key, const std::vector<wxml::Reference> &references) {
+    out += ",\"";
+    out += key;
+    out += "\":[";
+    for (size_t i = 0; i < references.size(); i++) {
+        out += i > 0 ? "," : "";
+        wxml::append_json_string(out, references[i].value);
+    }
+    out += ']';
+}
+
+std::string to_json(const wxml::FileSummary &summary) {
+    std::string out = "{\"path\":";
+    wxml::append_json_string(out, summary.path);
+    out += ",\"size\":" + std::to_string(summary.size);
+    out += summary.has_error ? ",\"hasError\":true" : ",\"hasError\":false";
+    append_references(out, "imports", summary.imports);
+    append_references(out, "includes", summary.includes);
+    append_references(out, "templates", summary.templates);
+    append_references(out, "templateUses", summary.template_uses);
+    out += ",\"wxsModules\":[";
+    for (size_t i = 0; i < summary.wxs_modules.size(); i++) {
+        out += i > 0 ? ",{\"module\":" : "{\"module\":";
+        wxml::append_json_string(out, summary.wxs_modules[i].module);
+        out += ",\"src\":";
+        wxml::append_json_string(out, summary.wxs_modules[i].src);
+        out += '}';
+    }
+    out += "],\"componentTags\":[";
+    for (size_t i = 0; i < summary.component_tags.size(); i++) {
+        out += i > 0 ? "," : "";
+        wxml::append_json_string(out, summary.component_tags[i]);
+    }
+    out += "]}\n";
+    return out;
+}
+
+void usage(FILE *out) {
+    std::fputs("usage: wxml-index [-j threads] [-o json|none] [-c cache-dir [-s max-MB]] DIR|FILE...\n", out);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    unsigned threads = 0;
+    bool json = true;
+    const char *cache_dir = nullptr;
+    uint64_t cache_megabytes = 256;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:o:c:s:h")) != -1) {
+        switch (opt) {
+            case 'j':
+                threads = static_cast<unsigned>(std::strtoul(optarg, nullptr, 10));
+                break;
+            case 'o':
+                if (std::strcmp(optarg, "json") == 0) {
+                    json = true;
+                } else if (std::strcmp(optarg, "none") == 0) {
+                    json = false;
+                } else {
+                    usage(stderr);
+                    return 2;
+                }
+                break;
+            case 'c':
+                cache_dir = optarg;
+                break;
+            case 's':
+                cache_megabytes = std::strtoull(optarg, nullptr, 10);
+                break;
+            case 'h':
+                usage(stdout);
+                return 0;
+            default:
+                usage(stderr);
+                return 2;
+        }
+    }
+    if (optind >= argc) {
+        usage(stderr);
+        return 2;
+    }
+
+    std::vector<std::string> paths;
+    for (int i = optind; i < argc; i++) {
+        std::vector<std::string> found = wxml::find_wxml_files(argv[i]);
+        paths.insert(paths.end(), found.begin(), found.end());
+    }
+
+    std::unique_ptr<wxml::ParseCache> cache;
+    if (cache_dir != nullptr) {
+        cache = std::make_unique<wxml::ParseCache>(cache_dir, cache_megabytes << 20);
+    }
+    wxml::IndexStats stats;
+    std::vector<wxml::FileSummary> summaries = wxml::index_files(paths, threads, &stats, cache.get());
+    if (json) {
+        for (const wxml::FileSummary &summary : summaries) {
+            std::string line = to_json(summary);
+            std::fwrite(line.data(), 1, line.size(), stdout);
+        }
+    }
+    std::fprintf(stderr, "%zu files (%zu unreadable, %zu with errors)\t%.1f MB\t%.3f s\t%.2f MB/s\t%u threads\n",
+                 stats.files, stats.failed, stats.with_errors, static_cast<double>(stats.bytes) / 1e6, stats.seconds,
+                 stats.seconds > 0 ? static_cast<double>(stats.bytes) / stats.seconds / 1e6 : 0.0, stats.threads);
+    if (cache != nullptr) {
+        cache->trim();
+        std::fprintf(stderr, "%s\n", wxml::to_string(cache->report()).c_str());
+    }
+    return stats.failed > 0 ? 2 : 0;
+}
@@ -0,0 +1,257 @@
+// wxml-lint: check WXML files against the built-in lint rules.
+//
+//   wxml-lint [-j threads] [-d rule[,rule...]] [-q] DIR|FILE...
+//   wxml-lint -l
+//   wxml-lint -b [-n rounds] DIR|FILE...
+//
+// Prints "path:line:column: severity: message [rule]" for every finding
+// and a total on stderr, and exits with 1 if any finding is an error. All
+// rules run in one traversal of each tree. -d disables rules and -l lists
+// them. With -b nothing is printed; instead the files are linted -n times
+// (default 10) in one pass and again with one traversal per rule, and the
+// throughput of both is printed.
+
+#include "lib/indexer.hpp"
+#include "lib/linter.hpp"
+#include "lib/mapped_file.hpp"
+#include "lib/work_stealing.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+struct FileReport {
+    bool failed = false;
+    int error = 0;
+    size_t errors = 0;
+    size_t findings = 0;
+    std::string text;
+};
+
+void usage(FILE *out) {
+    std::fputs("usage: wxml-lint [-j threads] [-d rule[,rule...]] [-q] DIR|FILE...\n"
+               "       wxml-lint -l\n"
+               "       wxml-lint -b [-n rounds] DIR|FILE...\n",
+               out);
+}
+
+std::vector<FileReport> lint(const std::vector<std::string> &paths, const wxml::RuleSet &rules, unsigned threads) {
+    std::vector<FileReport> reports(paths.size());
+    std::vector<wxml::Parser> parsers(threads);
+    std::vector<wxml::Linter> linters;
+    for (unsigned i = 0; i < threads; i++) {
+        linters.emplace_back(rules);
+    }
+    wxml::parallel_for(paths.size(), threads, [&](unsigned worker, size_t i) {
+        FileReport &report = reports[i];
+        wxml::MappedFile file;
+        if (!file.open(paths[i])) {
+            report.failed = true;
+            report.error = errno;
+            return;
+        }
+        std::string_view source = file.data();
+        wxml::Tree tree = parsers[worker].parse(source);
+        if (!tree) {
+            report.failed = true;
+            report.error = EINVAL;
+            return;
+        }
+        wxml::Linter &linter = linters[worker];
+        linter.lint(tree.root(), source);
+        std::vector<wxml::LintDiagnostic> found = linter.diagnostics();
+        std::stable_sort(found.begin(), found.end(), [](const wxml::LintDiagnostic &a, const wxml::LintDiagnostic &b) {
+            return a.start_byte < b.start_byte;
+        });
+        wxml::LineIndex lines;
+        lines.reset(source);
+        for (const wxml::LintDiagnostic &diagnostic : found) {
+            TSPoint point = lines.point(diagnostic.start_byte);
+            report.text += paths[i] + ":" + std::to_string(point.row + 1) + ":" + std::to_string(point.column + 1) +
+                           ": " + wxml::severity_name(diagnostic.severity) + ": " + std::string(diagnostic.message) +
+                           " [" + std::string(rules.rules()[diagnostic.rule]->name()) + "]\n";
+            report.errors += diagnostic.severity == wxml::Severity::error ? 1 : 0;
+        }
+        report.findings = found.size();
+    });
+    return reports;
+}
+
+// Lints every file `rounds` times with all rules in one pass, then with a
+// pass per rule, as the linter would without dispatch tables.
+int bench(const std::vector<std::string> &paths, int rounds) {
+    std::vector<std::unique_ptr<wxml::MappedFile>> files;
+    std::vector<wxml::Tree> trees;
+    wxml::Parser parser;
+    uint64_t bytes = 0;
+    for (const std::string &path : paths) {
+        auto file = std::make_unique<wxml::MappedFile>();
+        if (!file->open(path)) {
+            std::fprintf(stderr, "wxml-lint: %s: %s\n", path.c_str(), std::strerror(errno));
+            return 2;
+        }
+        trees.push_back(parser.parse(file->data()));
+        bytes += file->data().size();
+        files.push_back(std::move(file));
+    }
+
+    wxml::RuleSet all;
+    wxml::add_builtin_rules(all);
+    std::vector<std::unique_ptr<wxml::RuleSet>> singles;
+    for (size_t i = 0; i < all.rules().size(); i++) {
+        auto single = std::make_unique<wxml::RuleSet>();
+        wxml::add_builtin_rules(*single);
+        for (size_t j = 0; j < all.rules().size(); j++) {
+            if (j != i) {
+                single->disable(all.rules()[j]->name());
+            }
+        }
+        singles.push_back(std::move(single));
+    }
+
+    auto time = [&](const std::vector<const wxml::RuleSet *> &sets, size_t *findings, uint64_t *checks) {
+        std::vector<wxml::Linter> linters;
+        for (const wxml::RuleSet *set : sets) {
+            linters.emplace_back(*set);
+        }
+        *findings = 0;
+        *checks = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++) {
+            for (size_t i = 0; i < files.size(); i++) {
+                for (wxml::Linter &linter : linters) {
+                    linter.lint(trees[i].root(), files[i]->data());
+                    if (round == 0) {
+                        *findings += linter.diagnostics().size();
+                        *checks += linter.checks();
+                    }
+                }
+            }
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    auto report = [&](const char *label, double seconds, size_t findings, uint64_t checks) {
+        std::printf("%-14s %8.3f s  %8.2f MB/s  %zu findings  %llu checks per round\n", label, seconds,
+                    seconds > 0 ? static_cast<double>(bytes) * rounds / seconds / 1e6 : 0.0, findings,
+                    static_cast<unsigned long long>(checks));
+    };
+
+    std::vector<const wxml::RuleSet *> separate;
+    for (const auto &single : singles) {
+        separate.push_back(single.get());
+    }
+    size_t findings;
+    uint64_t checks;
+    std::printf("%zu files, %.1f MB, %zu rules, %d rounds\n", files.size(), static_cast<double>(bytes) / 1e6,
+                all.rules().size(), rounds);
+    double seconds = time({&all}, &findings, &checks);
+    report("single pass", seconds, findings, checks);
+    seconds = time(separate, &findings, &checks);
+    report("pass per rule", seconds, findings, checks);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    unsigned threads = 0;
+    bool quiet = false;
+    bool list = false;
+    bool benchmark = false;
+    int rounds = 10;
+    std::vector<std::string> disabled;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:d:qlbn:h")) != -1) {
+        switch (opt) {
+            case 'j':
+                threads = static_cast<unsigned>(std::strtoul(optarg, nullptr, 10));
+                break;
+            case 'd':
+                for (const char *name = optarg; *name != '\0';) {
+                    const char *end = std::strchr(name, ',');
+                    size_t length = end != nullptr ? static_cast<size_t>(end - name) : std::strlen(name);
+                    disabled.emplace_back(name, length);
+                    name += length + (end != nullptr ? 1 : 0);
+                }
+                break;
+            case 'q':
+                quiet = true;
+                break;
+            case 'l':
+                list = true;
+                break;
+            case 'b':
+                benchmark = true;
+                break;
+            case 'n':
+                rounds = std::max(1, std::atoi(optarg));
+                break;
+            case 'h':
+                usage(stdout);
+                return 0;
+            default:
+                usage(stderr);
+                return 2;
+        }
+    }
+
+    wxml::RuleSet rules;
+    wxml::add_builtin_rules(rules);
+    if (list) {
+        for (const auto &rule : rules.rules()) {
+            std::printf("%s\t%s\n", std::string(rule->name()).c_str(), wxml::severity_name(rule->severity()));
+        }
+        return 0;
+    }
+    for (const std::string &name : disabled) {
+        if (!rules.disable(name)) {
+            std::fprintf(stderr, "wxml-lint: no rule called %s\n", name.c_str());
+            return 2;
+        }
+    }
+    if (optind >= argc) {
+        usage(stderr);
+        return 2;
+    }
+
+    std::vector<std::string> paths;
+    for (int i = optind; i < argc; i++) {
+        std::vector<std::string> found = wxml::find_wxml_files(argv[i]);
+        paths.insert(paths.end(), found.begin(), found.end());
+    }
+    if (benchmark) {
+        return bench(paths, rounds);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<FileReport> reports = lint(paths, rules, threads == 0 ? wxml::default_concurrency() : threads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t failed = 0;
+    size_t errors = 0;
+    size_t findings = 0;
+    for (size_t i = 0; i < paths.size(); i++) {
+        const FileReport &report = reports[i];
+        if (report.failed) {
+            std::fprintf(stderr, "wxml-lint: %s: %s\n", paths[i].c_str(), std::strerror(report.error));
+            failed++;
+            continue;
+        }
+        if (!quiet) {
+            std::fwrite(report.text.data(), 1, report.text.size(), stdout);
+        }
+        errors += report.errors;
+        findings += report.findings;
+    }
+    std::fprintf(stderr, "%zu files (%zu failed)\t%zu findings, %zu errors\t%.3f s\n", paths.size(), failed, findings,
+                 errors, seconds);
+    return failed > 0 ? 2 : errors > 0 ? 1 : 0;
+}
@@ -0,0 +1,451 @@
+// wxml-lsp: a language server for WXML over stdio.
+//
+//   wxml-lsp [-v]
+//   wxml-lsp -b FILE [-n edits]
+//
+// Documents are synchronized incrementally. Each change is applied to the
+// document's tree with ts_tree_edit and reparsed incrementally, and
+// diagnostics, document symbols, semantic tokens and the findings of the
+// built-in lint rules are re-derived only where the tree changed. With -v
+// the time spent on each change is logged to stderr. With -b the server is
+// not started; instead single-character edits at random places in FILE are
+// timed from the edit to serialized diagnostics, and the latency
+// percentiles are printed.
+
+#include "lib/document.hpp"
+#include "lib/json.hpp"
+#include "lib/linter.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double milliseconds_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Largest message body read into memory; a document this size is far past
+// anything the editor would send.
+constexpr size_t max_message_size = 64 << 20;
+
+// Reads one message framed by a Content-Length header. Returns false at the
+// end of input. A body longer than max_message_size is skipped and leaves
+// `body` empty with `too_large` set.
+bool read_message(std::string *body, bool *too_large) {
+    size_t length = 0;
+    bool has_length = false;
+    std::string line;
+    for (;;) {
+        line.clear();
+        int c;
+        while ((c = std::getchar()) != EOF && c != '\n') {
+            line += static_cast<char>(c);
+        }
+        if (c == EOF) {
+            return false;
+        }
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            if (has_length) {
+                break;
+            }
+            continue;
+        }
+        if (line.compare(0, 15, "Content-Length:") == 0) {
+            length = std::strtoul(line.c_str() + 15, nullptr, 10);
+            has_length = true;
+        }
+    }
+    *too_large = length > max_message_size;
+    if (*too_large) {
+        body->clear();
+        char skipped[4096];
+        for (size_t left = length; left > 0;) {
+            size_t read = std::fread(skipped, 1, std::min(left, sizeof(skipped)), stdin);
+            if (read == 0) {
+                return false;
+            }
+            left -= read;
+        }
+        return true;
+    }
+    body->resize(length);
+    return std::fread(body->data(), 1, length, stdin) == length;
+}
+
+void write_message(const std::string &body) {
+    std::printf("Content-Length: %zu\r\n\r\n", body.size());
+    std::fwrite(body.data(), 1, body.size(), stdout);
+    std::fflush(stdout);
+}
+
+class Server {
+  public:
+    explicit Server(bool verbose) : verbose_(verbose) { wxml::add_builtin_rules(rules_); }
+
+    // Handles one message. Returns false once the client asked to exit.
+    bool handle(const wxml::Json &message);
+
+    int exit_code() const { return shut_down_ ? 0 : 1; }
+
+    // The publishDiagnostics notification for a document.
+    std::string diagnostics(const std::string &uri, const wxml::Document &document) const;
+
+    const wxml::RuleSet &rules() const { return rules_; }
+
+  private:
+    void respond(const wxml::Json &id, const std::string &result) const;
+    void respond_error(const wxml::Json &id, int code, const char *message) const;
+    void append_range(std::string &out, const wxml::Document &document, wxml::Span span) const;
+    std::string initialize(const wxml::Json &params);
+    std::string document_symbols(const wxml::Document &document) const;
+    std::string semantic_tokens(const wxml::Document &document) const;
+    static bool position(const wxml::Json &json, wxml::Position *position);
+
+    bool verbose_;
+    bool shut_down_ = false;
+    wxml::PositionEncoding encoding_ = wxml::PositionEncoding::utf16;
+    wxml::Parser parser_;
+    wxml::RuleSet rules_;
+    std::map<std::string, wxml::Document> documents_;
+};
+
+// Reads an LSP position, whose fields are unsigned integers. Returns false
+// for anything else, which would not survive the conversion to uint32_t.
+bool Server::position(const wxml::Json &json, wxml::Position *position) {
+    auto field = [&](const char *name, uint32_t *value) {
+        const wxml::Json &number = json[name];
+        double d = number.as_number(-1);
+        if (!number.is_number() || !(d >= 0 && d <= UINT32_MAX) || std::floor(d) != d) {
+            return false;
+        }
+        *value = static_cast<uint32_t>(d);
+        return true;
+    };
+    return field("line", &position->line) && field("character", &position->character);
+}
+
+void Server::respond(const wxml::Json &id, const std::string &result) const {
+    std::string body = "{\"jsonrpc\":\"2.0\",\"id\":";
+    id.write(body);
+    body += ",\"result\":" + result + "}";
+    write_message(body);
+}
+
+void Server::respond_error(const wxml::Json &id, int code, const char *message) const {
+    std::string body = "{\"jsonrpc\":\"2.0\",\"id\":";
+    id.write(body);
+    body += ",\"error\":{\"code\":" + std::to_string(code) + ",\"message\":";
+    wxml::append_json_string(body, message);
+    body += "}}";
+    write_message(body);
+}
+
+void Server::append_range(std::string &out, const wxml::Document &document, wxml::Span span) const {
+    wxml::Position start = document.lines().position(document.text(), span.start_byte, encoding_);
+    wxml::Position end = document.lines().position(document.text(), span.end_byte, encoding_);
+    out += "{\"start\":{\"line\":" + std::to_string(start.line) + ",\"character\":" + std::to_string(start.character) +
+           "},\"end\":{\"line\":" + std::to_string(end.line) + ",\"character\":" + std::to_string(end.character) +
+           "}}";
+}
+
+std::string Server::initialize(const wxml::Json &params) {
+    for (const wxml::Json &encoding : params["capabilities"]["general"]["positionEncodings"].items()) {
+        if (encoding.as_string() == "utf-8") {
+            encoding_ = wxml::PositionEncoding::utf8;
+        }
+    }
+    std::string result = "{\"capabilities\":{\"positionEncoding\":";
+    result += encoding_ == wxml::PositionEncoding::utf8 ? "\"utf-8\"" : "\"utf-16\"";
+    result += ",\"textDocumentSync\":{\"openClose\":true,\"change\":2},\"documentSymbolProvider\":true,"
+              "\"semanticTokensProvider\":{\"legend\":{\"tokenTypes\":[";
+    const auto &types = wxml::semantic_token_types();
+    for (size_t i = 0; i < types.size(); i++) {
+        result += i > 0 ? "," : "";
+        wxml::append_json_string(result, types[i]);
+    }
+    result += "],\"tokenModifiers\":[]},\"full\":true}},\"serverInfo\":{\"name\":\"wxml-lsp\"}}";
+    return result;
+}
+
+std::string Server::diagnostics(const std::string &uri, const wxml::Document &document) const {
+    std::string body = "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":";
+    wxml::append_json_string(body, uri);
+    body += ",\"diagnostics\":[";
+    bool first = true;
+    for (const wxml::Diagnostic &diagnostic : document.diagnostics()) {
+        body += first ? "{\"range\":" : ",{\"range\":";
+        first = false;
+        append_range(body, document, diagnostic);
+        body += ",\"severity\":1,\"source\":\"wxml\",\"message\":";
+        wxml::append_json_string(body, diagnostic.message);
+        body += '}';
+    }
+    for (const wxml::LintDiagnostic &diagnostic : document.lint()) {
+        body += first ? "{\"range\":" : ",{\"range\":";
+        first = false;
+        append_range(body, document, diagnostic);
+        body += ",\"severity\":" + std::to_string(static_cast<int>(diagnostic.severity)) +
+                ",\"source\":\"wxml-lint\",\"code\":";
+        wxml::append_json_string(body, rules_.rules()[diagnostic.rule]->name());
+        body += ",\"message\":";
+        wxml::append_json_string(body, diagnostic.message);
+        body += '}';
+    }
+    body += "]}}";
+    return body;
+}
+
+std::string Server::document_symbols(const wxml::Document &document) const {
+    std::string result = "[";
+    bool first = true;
+    for (const wxml::DocumentSymbol &symbol : document.symbols()) {
+        result += first ? "{\"name\":" : ",{\"name\":";
+        first = false;
+        wxml::append_json_string(result, symbol.name);
+        result += ",\"detail\":";
+        wxml::append_json_string(result, symbol.detail);
+        result += ",\"kind\":" + std::to_string(static_cast<int>(symbol.kind)) + ",\"range\":";
+        append_range(result, document, symbol);
+        result += ",\"selectionRange\":";
+        append_range(result, document, symbol.selection);
+        result += '}';
+    }
+    return result + "]";
+}
+
+// Tokens are relative to the previous one and may not span lines, so
+// multi-line tokens such as comments are split at line breaks.
+std::string Server::semantic_tokens(const wxml::Document &document) const {
+    const std::string &text = document.text();
+    const wxml::LineIndex &lines = document.lines();
+    std::string result = "{\"data\":[";
+    uint32_t previous_line = 0, previous_character = 0;
+    bool first = true;
+    auto emit = [&](uint32_t start_byte, uint32_t end_byte, wxml::TokenType type) {
+        wxml::Position start = lines.position(text, start_byte, encoding_);
+        wxml::Position end = lines.position(text, end_byte, encoding_);
+        uint32_t delta_line = start.line - previous_line;
+        uint32_t delta_character = delta_line == 0 ? start.character - previous_character : start.character;
+        result += first ? "" : ",";
+        first = false;
+        result += std::to_string(delta_line) + "," + std::to_string(delta_character) + "," +
+                  std::to_string(end.character - start.character) + "," + std::to_string(static_cast<int>(type)) +
+                  ",0";
+        previous_line = start.line;
+        previous_character = start.character;
+    };
+    for (const wxml::SemanticToken &token : document.tokens()) {
+        uint32_t start = token.start_byte;
+        while (start < token.end_byte) {
+            size_t newline = text.find('\n', start);
+            uint32_t end = newline == std::string::npos ? token.end_byte
+                                                        : std::min<uint32_t>(token.end_byte, static_cast<uint32_t>(newline));
+            if (end > start) {
+                emit(start, end, token.type);
+            }
+            start = end + 1;
+        }
+    }
+    return result + "]}";
+}
+
+bool Server::handle(const wxml::Json &message) {
+    const std::string &method = message["method"].as_string();
+    const wxml::Json &id = message["id"];
+    const wxml::Json &params = message["params"];
+    bool request = !id.is_null();
+
+    if (method == "initialize") {
+        respond(id, initialize(params));
+    } else if (method == "shutdown") {
+        shut_down_ = true;
+        respond(id, "null");
+    } else if (method == "exit") {
+        return false;
+    } else if (method == "textDocument/didOpen") {
+        const wxml::Json &item = params["textDocument"];
+        auto it = documents_.insert_or_assign(item["uri"].as_string(), wxml::Document(item["text"].as_string(), parser_, &rules_))
+                      .first;
+        write_message(diagnostics(it->first, it->second));
+    } else if (method == "textDocument/didChange") {
+        auto it = documents_.find(params["textDocument"]["uri"].as_string());
+        if (it == documents_.end()) {
+            return true;
+        }
+        // A change with a malformed range drops the whole notification, so
+        // that the document is not left with only some of its changes.
+        const std::vector<wxml::Json> &changes = params["contentChanges"].items();
+        std::vector<std::pair<wxml::Position, wxml::Position>> positions(changes.size());
+        for (size_t i = 0; i < changes.size(); i++) {
+            const wxml::Json &range = changes[i]["range"];
+            if (!range.is_null() && (!position(range["start"], &positions[i].first) ||
+                                     !position(range["end"], &positions[i].second))) {
+                std::fprintf(stderr, "%s: ignoring changes with an invalid range\n", it->first.c_str());
+                return true;
+            }
+        }
+        Clock::time_point start = Clock::now();
+        wxml::Document &document = it->second;
+        for (size_t i = 0; i < changes.size(); i++) {
+            if (changes[i]["range"].is_null()) {
+                document.replace(changes[i]["text"].as_string());
+            } else {
+                document.edit(positions[i].first, positions[i].second, changes[i]["text"].as_string(), encoding_);
+            }
+        }
+        std::vector<wxml::Span> ranges = document.reparse(parser_);
+        write_message(diagnostics(it->first, document));
+        if (verbose_) {
+            uint64_t bytes = 0;
+            for (const wxml::Span &range : ranges) {
+                bytes += std::min<uint64_t>(range.end_byte, document.text().size()) - range.start_byte;
+            }
+            std::fprintf(stderr, "%s: %zu changed ranges (%llu bytes) in %.3f ms\n", it->first.c_str(), ranges.size(),
+                         static_cast<unsigned long long>(bytes), milliseconds_since(start));
+        }
+    } else if (method == "textDocument/didClose") {
+        const std::string &uri = params["textDocument"]["uri"].as_string();
+        if (documents_.erase(uri) > 0) {
+            std::string body = "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":";
+            wxml::append_json_string(body, uri);
+            write_message(body + ",\"diagnostics\":[]}}");
+        }
+    } else if (method == "textDocument/documentSymbol" || method == "textDocument/semanticTokens/full") {
+        auto it = documents_.find(params["textDocument"]["uri"].as_string());
+        if (it == documents_.end()) {
+            respond_error(id, -32602, "unknown document");
+        } else {
+            respond(id, method == "textDocument/documentSymbol" ? document_symbols(it->second)
+                                                                 : semantic_tokens(it->second));
+        }
+    } else if (request) {
+        respond_error(id, -32601, "method not supported");
+    }
+    return true;
+}
+
+int serve(bool verbose) {
+    Server server(verbose);
+    std::string body;
+    bool too_large = false;
+    while (read_message(&body, &too_large)) {
+        if (too_large) {
+            write_message("{\"jsonrpc\":\"2.0\",\"id\":null,"
+                          "\"error\":{\"code\":-32700,\"message\":\"message too large\"}}");
+            continue;
+        }
+        wxml::Json message;
+        if (!wxml::Json::parse(body, &message)) {
+            write_message("{\"jsonrpc\":\"2.0\",\"id\":null,\"error\":{\"code\":-32700,\"message\":\"parse error\"}}");
+            continue;
+        }
+        if (!server.handle(message)) {
+            return server.exit_code();
+        }
+    }
+    return 1;
+}
+
+int bench(const char *path, int edits) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::perror(path);
+        return 2;
+    }
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    wxml::Parser parser;
+    Clock::time_point start = Clock::now();
+    Server server(false);
+    wxml::Document document(text, parser, &server.rules());
+    double open = milliseconds_since(start);
+
+    // Alternately type a character at a random place and delete it again,
+    // so the document keeps its shape over the run.
+    std::mt19937 random(1);
+    std::vector<double> latencies;
+    latencies.reserve(edits);
+    wxml::Position typed;
+    for (int i = 0; i < edits; i++) {
+        start = Clock::now();
+        if (i % 2 == 0) {
+            uint32_t byte = static_cast<uint32_t>(random() % (document.text().size() + 1));
+            typed = document.lines().position(document.text(), byte, wxml::PositionEncoding::utf8);
+            document.edit(typed, typed, "x", wxml::PositionEncoding::utf8);
+        } else {
+            document.edit(typed, wxml::Position{typed.line, typed.character + 1}, "", wxml::PositionEncoding::utf8);
+        }
+        document.reparse(parser);
+        std::string published = server.diagnostics("file://bench", document);
+        latencies.push_back(milliseconds_since(start));
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        return latencies.empty() ? 0.0 : latencies[std::min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))];
+    };
+    std::printf("%s: %zu bytes, %u lines, opened in %.2f ms\n", path, document.text().size(),
+                document.lines().line_count(), open);
+    std::printf("%d edits: p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms\n", edits, percentile(0.5),
+                percentile(0.9), percentile(0.99), latencies.empty() ? 0.0 : latencies.back());
+    std::printf("%zu diagnostics, %zu symbols, %zu tokens, %zu lint findings\n", document.diagnostics().size(),
+                document.symbols().size(), document.tokens().size(), document.lint().size());
+    return 0;
+}
+
+void usage(FILE *out) { std::fputs("usage: wxml-lsp [-v]\n       wxml-lsp -b FILE [-n edits]\n", out); }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool verbose = false;
+    const char *bench_path = nullptr;
+    int edits = 1000;
+    int opt;
+    while ((opt = getopt(argc, argv, "vb:n:h")) != -1) {
+        switch (opt) {
+            case 'v':
+                verbose = true;
+                break;
+            case 'b':
+                bench_path = optarg;
+                break;
+            case 'n': {
+                char *end;
+                errno = 0;
+                long n = std::strtol(optarg, &end, 10);
+                if (end == optarg || *end != '\0' || errno != 0 || n < 1 || n > INT_MAX) {
+                    usage(stderr);
+                    return 2;
+                }
+                edits = static_cast<int>(n);
+                break;
+            }
+            case 'h':
+                usage(stdout);
+                return 0;
+            default:
+                usage(stderr);
+                return 2;
+        }
+    }
+    return bench_path != nullptr ? bench(bench_path, edits) : serve(verbose);
+}
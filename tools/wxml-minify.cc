@@ -0,0 +1,106 @@
+// wxml-minify: minify the WXML files of a mini-program package.
+//
+//   wxml-minify [-j threads] [-o out-dir] [-q] DIR|FILE...
+//
+// Prints "path\tbytes\tminified\tsaved" for every file, unless -q, and a
+// total on stderr. With -o each file is written under out-dir at its path
+// relative to the argument it was found under; without it nothing is
+// written. Files with syntax errors are copied unchanged.
+
+#include "lib/indexer.hpp"
+#include "lib/minifier.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+void usage(FILE *out) { std::fputs("usage: wxml-minify [-j threads] [-o out-dir] [-q] DIR|FILE...\n", out); }
+
+} // namespace
+
+int main(int argc, char **argv) {
+    namespace fs = std::filesystem;
+    unsigned threads = 0;
+    const char *out_dir = nullptr;
+    bool quiet = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:o:qh")) != -1) {
+        switch (opt) {
+            case 'j':
+                threads = static_cast<unsigned>(std::strtoul(optarg, nullptr, 10));
+                break;
+            case 'o':
+                out_dir = optarg;
+                break;
+            case 'q':
+                quiet = true;
+                break;
+            case 'h':
+                usage(stdout);
+                return 0;
+            default:
+                usage(stderr);
+                return 2;
+        }
+    }
+    if (optind >= argc) {
+        usage(stderr);
+        return 2;
+    }
+
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+    for (int i = optind; i < argc; i++) {
+        std::error_code ec;
+        bool single = fs::is_regular_file(argv[i], ec);
+        for (std::string &path : wxml::find_wxml_files(argv[i])) {
+            if (out_dir != nullptr) {
+                fs::path relative = single ? fs::path(path).filename() : fs::path(path).lexically_relative(argv[i]);
+                outputs.push_back((fs::path(out_dir) / relative).string());
+            }
+            inputs.push_back(std::move(path));
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<wxml::MinifyResult> results = wxml::minify_files(inputs, outputs, threads);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t bytes = 0;
+    uint64_t minified = 0;
+    size_t failed = 0;
+    size_t with_errors = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const wxml::MinifyResult &result = results[i];
+        if (result.failed) {
+            std::fprintf(stderr, "wxml-minify: %s: %s\n", inputs[i].c_str(), std::strerror(result.error));
+            failed++;
+            continue;
+        }
+        if (result.has_error) {
+            std::fprintf(stderr, "wxml-minify: %s: syntax errors, copied unchanged\n", inputs[i].c_str());
+            with_errors++;
+        }
+        bytes += result.bytes;
+        minified += result.minified;
+        if (!quiet) {
+            std::printf("%s\t%llu\t%llu\t%lld\n", inputs[i].c_str(), static_cast<unsigned long long>(result.bytes),
+                        static_cast<unsigned long long>(result.minified),
+                        static_cast<long long>(result.bytes) - static_cast<long long>(result.minified));
+        }
+    }
+    std::fprintf(stderr, "%zu files (%zu failed, %zu with errors)\t%.1f MB -> %.1f MB (%.1f%% saved)\t%.3f s\t%.2f MB/s\n",
+                 inputs.size(), failed, with_errors, static_cast<double>(bytes) / 1e6,
+                 static_cast<double>(minified) / 1e6,
+                 bytes > 0 ? 100.0 * (static_cast<double>(bytes) - static_cast<double>(minified)) / static_cast<double>(bytes)
+                           : 0.0,
+                 seconds,
+                 seconds > 0 ? static_cast<double>(bytes) / seconds / 1e6 : 0.0);
+    return failed > 0 ? 2 : 0;
+}
@@ -0,0 +1,261 @@
+// wxml-parse: parse WXML files and report parser throughput.
+//
+//   wxml-parse [-o sexp|json|none] [-n iterations] FILE...
+//
+// Files are mapped into memory and handed to the parser through a TSInput
+// that points into the mapping, so nothing is copied before parsing. A line
+// per file and a total line go to stderr; trees go to stdout.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "tree_sitter/tree-sitter-wxml-preorder.h"
+#include "tree_sitter/tree-sitter-wxml.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <tree_sitter/api.h>
+#include <unistd.h>
+
+typedef enum {
+    OUTPUT_SEXP,
+    OUTPUT_JSON,
+    OUTPUT_NONE,
+} OutputMode;
+
+typedef struct {
+    const char *data;
+    uint32_t length;
+} MappedFile;
+
+static const char *read_mapped(void *payload, uint32_t byte_index, TSPoint position, uint32_t *bytes_read) {
+    (void)position;
+    const MappedFile *file = payload;
+    if (byte_index >= file->length) {
+        *bytes_read = 0;
+        return "";
+    }
+    *bytes_read = file->length - byte_index;
+    return file->data + byte_index;
+}
+
+static int map_file(const char *path, MappedFile *file) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        close(fd);
+        return -1;
+    }
+    if ((uint64_t)st.st_size > UINT32_MAX) {
+        close(fd);
+        errno = EFBIG;
+        return -1;
+    }
+    file->length = (uint32_t)st.st_size;
+    file->data = "";
+    if (file->length > 0) {
+        void *data = mmap(NULL, file->length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            return -1;
+        }
+        file->data = data;
+    }
+    close(fd);
+    return 0;
+}
+
+static void unmap_file(MappedFile *file) {
+    if (file->length > 0) {
+        munmap((void *)file->data, file->length);
+    }
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void write_json_string(FILE *out, const char *string) {
+    fputc('"', out);
+    for (const unsigned char *c = (const unsigned char *)string; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', out);
+            fputc(*c, out);
+        } else if (*c < 0x20) {
+            fprintf(out, "\\u%04x", *c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+// Writes the named nodes of the tree as nested JSON objects, iteratively so
+// that deep documents cannot overflow the stack.
+static void write_json(FILE *out, const char *path, TSNode root) {
+    fputs("{\"file\":", out);
+    write_json_string(out, path);
+    fputs(",\"tree\":", out);
+
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    bool first = true;
+    for (;;) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        bool visible = ts_node_is_named(node) || ts_node_is_missing(node);
+        if (visible) {
+            TSPoint start = ts_node_start_point(node), end = ts_node_end_point(node);
+            fputs(first ? "{\"type\":" : ",{\"type\":", out);
+            write_json_string(out, ts_node_type(node));
+            fprintf(out, ",\"startByte\":%u,\"endByte\":%u,\"start\":[%u,%u],\"end\":[%u,%u]",
+                    ts_node_start_byte(node), ts_node_end_byte(node), start.row, start.column, end.row,
+                    end.column);
+            if (ts_node_is_missing(node)) {
+                fputs(",\"missing\":true", out);
+            }
+            first = true;
+            if (ts_node_named_child_count(node) > 0 && ts_tree_cursor_goto_first_child(&cursor)) {
+                fputs(",\"children\":[", out);
+                continue;
+            }
+            fputc('}', out);
+            first = false;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                ts_tree_cursor_delete(&cursor);
+                fputs("}\n", out);
+                return;
+            }
+            fputs("]}", out);
+            first = false;
+        }
+    }
+}
+
+static void usage(FILE *out) {
+    fputs("usage: wxml-parse [-o sexp|json|none] [-n iterations] FILE...\n", out);
+}
+
+int main(int argc, char **argv) {
+    OutputMode mode = OUTPUT_SEXP;
+    long iterations = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:n:h")) != -1) {
+        switch (opt) {
+            case 'o':
+                if (strcmp(optarg, "sexp") == 0) {
+                    mode = OUTPUT_SEXP;
+                } else if (strcmp(optarg, "json") == 0) {
+                    mode = OUTPUT_JSON;
+                } else if (strcmp(optarg, "none") == 0) {
+                    mode = OUTPUT_NONE;
+                } else {
+                    usage(stderr);
+                    return 2;
+                }
+                break;
+            case 'n': {
+                char *end;
+                errno = 0;
+                iterations = strtol(optarg, &end, 10);
+                if (end == optarg || *end != '\0' || errno != 0 || iterations < 1) {
+                    usage(stderr);
+                    return 2;
+                }
+                break;
+            }
+            case 'h':
+                usage(stdout);
+                return 0;
+            default:
+                usage(stderr);
+                return 2;
+        }
+    }
+    if (optind >= argc) {
+        usage(stderr);
+        return 2;
+    }
+
+    TSParser *parser = ts_parser_new();
+    if (!ts_parser_set_language(parser, tree_sitter_wxml())) {
+        fprintf(stderr, "wxml-parse: the tree-sitter runtime supports language ABI %d to %d, not this parser's\n",
+                TREE_SITTER_MIN_COMPATIBLE_LANGUAGE_VERSION, TREE_SITTER_LANGUAGE_VERSION);
+        ts_parser_delete(parser);
+        return 2;
+    }
+
+    int status = 0;
+    uint64_t total_bytes = 0, total_nodes = 0, total_errors = 0;
+    double total_seconds = 0;
+    for (int i = optind; i < argc; i++) {
+        const char *path = argv[i];
+        MappedFile file;
+        if (map_file(path, &file) < 0) {
+            fprintf(stderr, "%s: %s\n", path, strerror(errno));
+            status = 2;
+            continue;
+        }
+
+        TSInput input = {.payload = &file, .read = read_mapped, .encoding = TSInputEncodingUTF8};
+        TSTree *tree = NULL;
+        double start = now_seconds();
+        for (long n = 0; n < iterations; n++) {
+            if (tree != NULL) {
+                ts_tree_delete(tree);
+            }
+            tree = ts_parser_parse(parser, NULL, input);
+            if (tree == NULL) {
+                break;
+            }
+        }
+        double seconds = (now_seconds() - start) / (double)iterations;
+        if (tree == NULL) {
+            fprintf(stderr, "%s: parsing failed\n", path);
+            ts_parser_reset(parser);
+            unmap_file(&file);
+            status = 2;
+            continue;
+        }
+
+        TSNode root = ts_tree_root_node(tree);
+        uint32_t nodes = ts_node_descendant_count(root);
+        uint32_t errors = wxml_count_errors(root);
+        if (mode == OUTPUT_SEXP) {
+            char *sexp = ts_node_string(root);
+            printf("%s\n", sexp);
+            free(sexp);
+        } else if (mode == OUTPUT_JSON) {
+            write_json(stdout, path, root);
+        }
+        fprintf(stderr, "%s\t%u bytes\t%.3f ms\t%.2f MB/s\t%u nodes\t%u errors\n", path, file.length,
+                seconds * 1e3, seconds > 0 ? file.length / seconds / 1e6 : 0.0, nodes, errors);
+
+        total_bytes += file.length;
+        total_seconds += seconds;
+        total_nodes += nodes;
+        total_errors += errors;
+        if (errors > 0 && status == 0) {
+            status = 1;
+        }
+        ts_tree_delete(tree);
+        unmap_file(&file);
+    }
+
+    fprintf(stderr, "total\t%llu bytes\t%.3f ms\t%.2f MB/s\t%llu nodes\t%llu errors\n",
+            (unsigned long long)total_bytes, total_seconds * 1e3,
+            total_seconds > 0 ? (double)total_bytes / total_seconds / 1e6 : 0.0,
+            (unsigned long long)total_nodes, (unsigned long long)total_errors);
+    ts_parser_delete(parser);
+    return status;
+}